@@ -20,6 +20,10 @@ public:
 	void UpdateAttackState( float inDeltaTime );
 	// returns true if the move is done
 	bool MoveToLocation( float inDeltaTime, const Vector3& inLocation );
+	//cats in RC_MOVING don't move themselves- the world steps them all at once at the start of the tick, see World::UpdateMovingCats
+	bool IsMoving() const							{ return mState == RC_MOVING; }
+	const Vector3& GetMoveLocation() const			{ return mMoveLocation; }
+	void HandleMoveDone()							{ mState = RC_IDLE; }
 	void UpdateRotation( const Vector3& inTarget );
 	void EnterMovingState( const Vector3& inTarget );
 	void EnterAttackState( uint32_t inTargetNetId );
@@ -28,6 +32,10 @@ public:
 
 	RoboCat();
 
+	static const float kMoveSpeed;
+	//closer than this counts as there
+	static const float kMoveStopDistance;
+
 	virtual void WriteForCRC( OutputMemoryBitStream& inStream ) override;
 private:
 	Vector3				mMoveLocation;
@@ -47,6 +47,7 @@ class GameObject;
 #include "RandGen.h"
 
 #include "StringUtils.h"
+#include "FrameArena.h"
 
 #include "MemoryBitStream.h"
 
@@ -1,3 +1,19 @@
+//x64 always has sse2, and 32 bit x86 builds get it with /arch:SSE2 or -msse2. 64 bit arm always has neon
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define ROBOMATH_USE_SSE 1
+	#define ROBOMATH_USE_NEON 0
+	#include <emmintrin.h>
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+	#define ROBOMATH_USE_SSE 0
+	#define ROBOMATH_USE_NEON 1
+	#include <arm_neon.h>
+#else
+	#define ROBOMATH_USE_SSE 0
+	#define ROBOMATH_USE_NEON 0
+#endif
+
+#define ROBOMATH_USE_SIMD ( ROBOMATH_USE_SSE || ROBOMATH_USE_NEON )
+
 class Vector3
 {
 public:
@@ -184,6 +200,60 @@ namespace RoboMath
 	{
 		return inRadians * 180.0f / PI;
 	}
+
+	//RoboCat::MoveToLocation for a whole batch of points on separate x, y and z arrays, four at a time where there's simd.
+	//points further than inStopDistance from their target step inSpeed * inDeltaTime toward it in 2d, or land on it if that's closer.
+	//outIsDone[ i ] is set for the ones that landed or were already close enough, just like the return value.
+	//every peer has to get the same bits, so it's the same operations in the same order as the one at a time math- sqrt and divide
+	//are correctly rounded in every path, so the results match as long as the compiler doesn't fuse a multiply add
+	void MoveToLocationBatch( float* ioXs, float* ioYs, float* ioZs, const float* inTargetXs, const float* inTargetYs, const float* inTargetZs,
+		uint32_t inCount, float inDeltaTime, float inSpeed, float inStopDistance, uint8_t* outIsDone );
+
+#if ROBOMATH_USE_SIMD
+	//just enough four wide math for the batch functions, on whichever instruction set we have
+	namespace Simd
+	{
+	#if ROBOMATH_USE_SSE
+		typedef __m128		Float4;
+		typedef __m128		Mask4;
+
+		inline Float4	Load( const float* inData )					{ return _mm_loadu_ps( inData ); }
+		inline void		Store( float* outData, Float4 inValue )		{ _mm_storeu_ps( outData, inValue ); }
+		inline Float4	Splat( float inValue )						{ return _mm_set1_ps( inValue ); }
+		inline Float4	Add( Float4 inA, Float4 inB )				{ return _mm_add_ps( inA, inB ); }
+		inline Float4	Subtract( Float4 inA, Float4 inB )			{ return _mm_sub_ps( inA, inB ); }
+		inline Float4	Multiply( Float4 inA, Float4 inB )			{ return _mm_mul_ps( inA, inB ); }
+		inline Float4	Divide( Float4 inA, Float4 inB )			{ return _mm_div_ps( inA, inB ); }
+		inline Float4	Sqrt( Float4 inA )							{ return _mm_sqrt_ps( inA ); }
+		inline Mask4	GreaterThan( Float4 inA, Float4 inB )		{ return _mm_cmpgt_ps( inA, inB ); }
+		inline Mask4	And( Mask4 inA, Mask4 inB )					{ return _mm_and_ps( inA, inB ); }
+		//lanes where inMask is set come from inIfSet, the rest from inIfClear
+		inline Float4	Select( Mask4 inMask, Float4 inIfSet, Float4 inIfClear )	{ return _mm_or_ps( _mm_and_ps( inMask, inIfSet ), _mm_andnot_ps( inMask, inIfClear ) ); }
+		//bit i set if lane i is
+		inline uint32_t	GetMaskBits( Mask4 inMask )					{ return static_cast< uint32_t >( _mm_movemask_ps( inMask ) ); }
+	#else
+		typedef float32x4_t	Float4;
+		typedef uint32x4_t	Mask4;
+
+		inline Float4	Load( const float* inData )					{ return vld1q_f32( inData ); }
+		inline void		Store( float* outData, Float4 inValue )		{ vst1q_f32( outData, inValue ); }
+		inline Float4	Splat( float inValue )						{ return vdupq_n_f32( inValue ); }
+		inline Float4	Add( Float4 inA, Float4 inB )				{ return vaddq_f32( inA, inB ); }
+		inline Float4	Subtract( Float4 inA, Float4 inB )			{ return vsubq_f32( inA, inB ); }
+		inline Float4	Multiply( Float4 inA, Float4 inB )			{ return vmulq_f32( inA, inB ); }
+		inline Float4	Divide( Float4 inA, Float4 inB )			{ return vdivq_f32( inA, inB ); }
+		inline Float4	Sqrt( Float4 inA )							{ return vsqrtq_f32( inA ); }
+		inline Mask4	GreaterThan( Float4 inA, Float4 inB )		{ return vcgtq_f32( inA, inB ); }
+		inline Mask4	And( Mask4 inA, Mask4 inB )					{ return vandq_u32( inA, inB ); }
+		inline Float4	Select( Mask4 inMask, Float4 inIfSet, Float4 inIfClear )	{ return vbslq_f32( inMask, inIfSet, inIfClear ); }
+		inline uint32_t	GetMaskBits( Mask4 inMask )
+		{
+			const uint32_t laneBits[ 4 ] = { 1, 2, 4, 8 };
+			return vaddvq_u32( vandq_u32( inMask, vld1q_u32( laneBits ) ) );
+		}
+	#endif
+	}
+#endif
 }
 
 namespace Colors
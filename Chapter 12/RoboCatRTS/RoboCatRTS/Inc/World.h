@@ -31,5 +31,8 @@ private:
 
 	World();
 
+	//steps every cat in RC_MOVING toward its move location in one batch, before anything else updates
+	void UpdateMovingCats( float inDeltaTime );
+
 	std::vector< GameObjectPtr >	mGameObjects;
 };
\ No newline at end of file
@@ -15,6 +15,8 @@ bool Engine::StaticInit()
 {
 	RandGen::StaticInit();
 
+	FrameArena::StaticInit();
+
 	GameObjectRegistry::StaticInit();
 
 
@@ -137,4 +139,6 @@ void Engine::DoFrame()
 	}
 
 	RenderManager::sInstance->Render();
+
+	FrameArena::sInstance->Reset();
 }	
@@ -97,7 +97,7 @@ void NetworkManager::UpdateDelay()
 		}
 
 		//find out who's missing and send them a heartbeat
-		unordered_set< uint64_t > playerSet;
+		unordered_set< uint64_t, std::hash< uint64_t >, std::equal_to< uint64_t >, FrameAllocator< uint64_t > > playerSet;
 		for( auto& iter : mPlayerNameMap )
 		{
 			playerSet.emplace( iter.first );
@@ -1,7 +1,8 @@
 #include "RoboCatPCH.h"
 #include <zlib.h>
 
-const float kMoveSpeed = 2.5f;
+const float RoboCat::kMoveSpeed = 2.5f;
+const float RoboCat::kMoveStopDistance = 0.1f;
 const float kAttackRangeSq = 1.5f * 1.5f;
 const float kYarnCooldown = 1.0f;
 
@@ -35,7 +36,7 @@ bool RoboCat::MoveToLocation( float inDeltaTime, const Vector3& inLocation )
 	Vector3 toMoveVec = inLocation - GetLocation();
 	float distToTarget = toMoveVec.Length();
 	toMoveVec.Normalize2D();
-	if( distToTarget > 0.1f )
+	if( distToTarget > kMoveStopDistance )
 	{
 		if ( distToTarget > ( kMoveSpeed * inDeltaTime ) )
 		{
@@ -152,12 +153,8 @@ void RoboCat::UpdateIdleState( float inDeltaTime )
 
 void RoboCat::UpdateMovingState( float inDeltaTime )
 {
+	//the world's already moved us this tick, and sent us idle if we got there
 	mTimeSinceLastAttack += inDeltaTime;
-	if ( MoveToLocation( inDeltaTime, mMoveLocation ) )
-	{
-		//done with the move, so go idle
-		mState = RC_IDLE;
-	}
 }
 
 void RoboCat::UpdateAttackState( float inDeltaTime )
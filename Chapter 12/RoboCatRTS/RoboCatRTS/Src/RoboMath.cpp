@@ -25,3 +25,91 @@ float RoboMath::GetRandomFloatNonGame()
 	static std::uniform_real_distribution< float > dis( 0.f, 1.f );
 	return dis( gen );
 }
+
+namespace
+{
+	//one point's worth of RoboCat::MoveToLocation, spelled out so the batch can do exactly the same thing four wide
+	void MoveToLocation( float& ioX, float& ioY, float& ioZ, float inTargetX, float inTargetY, float inTargetZ,
+		float inMaxStep, float inDeltaTime, float inSpeed, float inStopDistance, uint8_t& outIsDone )
+	{
+		float toX = inTargetX - ioX;
+		float toY = inTargetY - ioY;
+		float toZ = inTargetZ - ioZ;
+		float distance = sqrtf( toX * toX + toY * toY + toZ * toZ );
+		float length2D = sqrtf( toX * toX + toY * toY );
+		float directionX = toX / length2D;
+		float directionY = toY / length2D;
+
+		outIsDone = 1;
+		if( distance > inStopDistance )
+		{
+			if( distance > inMaxStep )
+			{
+				//normalizing in 2d leaves z as it was, so that's what gets scaled
+				ioX = ioX + directionX * inDeltaTime * inSpeed;
+				ioY = ioY + directionY * inDeltaTime * inSpeed;
+				ioZ = ioZ + toZ * inDeltaTime * inSpeed;
+				outIsDone = 0;
+			}
+			else
+			{
+				ioX = inTargetX;
+				ioY = inTargetY;
+				ioZ = inTargetZ;
+			}
+		}
+	}
+}
+
+void RoboMath::MoveToLocationBatch( float* ioXs, float* ioYs, float* ioZs, const float* inTargetXs, const float* inTargetYs, const float* inTargetZs,
+	uint32_t inCount, float inDeltaTime, float inSpeed, float inStopDistance, uint8_t* outIsDone )
+{
+	float maxStep = inSpeed * inDeltaTime;
+	uint32_t i = 0;
+
+#if ROBOMATH_USE_SIMD
+	Simd::Float4 maxSteps = Simd::Splat( maxStep );
+	Simd::Float4 deltaTimes = Simd::Splat( inDeltaTime );
+	Simd::Float4 speeds = Simd::Splat( inSpeed );
+	Simd::Float4 stopDistances = Simd::Splat( inStopDistance );
+
+	for( ; i + 4 <= inCount; i += 4 )
+	{
+		Simd::Float4 xs = Simd::Load( ioXs + i );
+		Simd::Float4 ys = Simd::Load( ioYs + i );
+		Simd::Float4 zs = Simd::Load( ioZs + i );
+		Simd::Float4 targetXs = Simd::Load( inTargetXs + i );
+		Simd::Float4 targetYs = Simd::Load( inTargetYs + i );
+		Simd::Float4 targetZs = Simd::Load( inTargetZs + i );
+
+		Simd::Float4 toXs = Simd::Subtract( targetXs, xs );
+		Simd::Float4 toYs = Simd::Subtract( targetYs, ys );
+		Simd::Float4 toZs = Simd::Subtract( targetZs, zs );
+		Simd::Float4 lengthsSq2D = Simd::Add( Simd::Multiply( toXs, toXs ), Simd::Multiply( toYs, toYs ) );
+		Simd::Float4 distances = Simd::Sqrt( Simd::Add( lengthsSq2D, Simd::Multiply( toZs, toZs ) ) );
+		Simd::Float4 lengths2D = Simd::Sqrt( lengthsSq2D );
+
+		Simd::Mask4 isOutsideStop = Simd::GreaterThan( distances, stopDistances );
+		Simd::Mask4 isStepping = Simd::And( isOutsideStop, Simd::GreaterThan( distances, maxSteps ) );
+
+		//the ones close enough to stop stay put, the ones within a step land on the target
+		Simd::Float4 steppedXs = Simd::Add( xs, Simd::Multiply( Simd::Multiply( Simd::Divide( toXs, lengths2D ), deltaTimes ), speeds ) );
+		Simd::Float4 steppedYs = Simd::Add( ys, Simd::Multiply( Simd::Multiply( Simd::Divide( toYs, lengths2D ), deltaTimes ), speeds ) );
+		Simd::Float4 steppedZs = Simd::Add( zs, Simd::Multiply( Simd::Multiply( toZs, deltaTimes ), speeds ) );
+		Simd::Store( ioXs + i, Simd::Select( isStepping, steppedXs, Simd::Select( isOutsideStop, targetXs, xs ) ) );
+		Simd::Store( ioYs + i, Simd::Select( isStepping, steppedYs, Simd::Select( isOutsideStop, targetYs, ys ) ) );
+		Simd::Store( ioZs + i, Simd::Select( isStepping, steppedZs, Simd::Select( isOutsideStop, targetZs, zs ) ) );
+
+		uint32_t steppingBits = Simd::GetMaskBits( isStepping );
+		for( uint32_t lane = 0; lane < 4; ++lane )
+		{
+			outIsDone[ i + lane ] = ( steppingBits & ( 1 << lane ) ) ? 0 : 1;
+		}
+	}
+#endif
+
+	for( ; i < inCount; ++i )
+	{
+		MoveToLocation( ioXs[ i ], ioYs[ i ], ioZs[ i ], inTargetXs[ i ], inTargetYs[ i ], inTargetZs[ i ], maxStep, inDeltaTime, inSpeed, inStopDistance, outIsDone[ i ] );
+	}
+}
@@ -40,6 +40,8 @@ void World::RemoveGameObject( GameObjectPtr inGameObject )
 
 void World::Update( float inDeltaTime )
 {
+	UpdateMovingCats( inDeltaTime );
+
 	//update all game objects- sometimes they want to die, so we need to tread carefully...
 
 	for( int i = 0, c = mGameObjects.size(); i < c; ++i )
@@ -62,6 +64,48 @@ void World::Update( float inDeltaTime )
 	}
 }
 
+void World::UpdateMovingCats( float inDeltaTime )
+{
+	//gather the moving cats' locations and targets into arrays for the batch. they only live for the tick, so they come from the frame arena
+	FrameVector< RoboCat* > cats;
+	FrameVector< float > xs, ys, zs, targetXs, targetYs, targetZs;
+	for( const GameObjectPtr& go : mGameObjects )
+	{
+		RoboCat* cat = go->GetAsCat();
+		if( cat && cat->IsMoving() && !cat->DoesWantToDie() )
+		{
+			const Vector3& location = cat->GetLocation();
+			const Vector3& target = cat->GetMoveLocation();
+			cats.push_back( cat );
+			xs.push_back( location.mX );
+			ys.push_back( location.mY );
+			zs.push_back( location.mZ );
+			targetXs.push_back( target.mX );
+			targetYs.push_back( target.mY );
+			targetZs.push_back( target.mZ );
+		}
+	}
+
+	uint32_t catCount = static_cast< uint32_t >( cats.size() );
+	if( catCount == 0 )
+	{
+		return;
+	}
+
+	FrameVector< uint8_t > isDone( catCount );
+	RoboMath::MoveToLocationBatch( xs.data(), ys.data(), zs.data(), targetXs.data(), targetYs.data(), targetZs.data(),
+		catCount, inDeltaTime, RoboCat::kMoveSpeed, RoboCat::kMoveStopDistance, isDone.data() );
+
+	for( uint32_t i = 0; i < catCount; ++i )
+	{
+		cats[ i ]->SetLocation( Vector3( xs[ i ], ys[ i ], zs[ i ] ) );
+		if( isDone[ i ] )
+		{
+			cats[ i ]->HandleMoveDone();
+		}
+	}
+}
+
 uint32_t World::TrySelectGameObject( const Vector3& inSelectLoc )
 {
 	for ( auto& g : mGameObjects )
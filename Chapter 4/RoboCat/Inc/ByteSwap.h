@@ -2,6 +2,13 @@
 #ifndef RoboCat_ByteSwap_h
 #define RoboCat_ByteSwap_h
 
+#include <cstring>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define BYTESWAP_USE_SSE2 1
+	#include <emmintrin.h>
+#endif
+
 inline uint16_t ByteSwap2( uint16_t inData )
 {
 	return ( inData >> 8 ) | ( inData << 8 );
@@ -104,6 +111,120 @@ T ByteSwap( T inData )
 	return ByteSwapper< T, sizeof( T ) >().Swap( inData );
 }
 
+//swaps a whole array in place, 16 bytes at a time where we can. ioData doesn't have to be aligned
+#ifdef BYTESWAP_USE_SSE2
+inline __m128i ByteSwapLanes2( __m128i inData )
+{
+	return _mm_or_si128( _mm_slli_epi16( inData, 8 ), _mm_srli_epi16( inData, 8 ) );
+}
+
+inline __m128i ByteSwapLanes4( __m128i inData )
+{
+	//reverse the 16 bit words in each lane, then the bytes in each word
+	inData = _mm_shufflelo_epi16( inData, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+	inData = _mm_shufflehi_epi16( inData, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+	return ByteSwapLanes2( inData );
+}
+
+inline __m128i ByteSwapLanes8( __m128i inData )
+{
+	inData = _mm_shufflelo_epi16( inData, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+	inData = _mm_shufflehi_epi16( inData, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+	return ByteSwapLanes2( inData );
+}
+#endif
+
+template < size_t tSize > class ArrayByteSwapper;
+
+template <>
+class ArrayByteSwapper< 1 >
+{
+public:
+	void Swap( char* ioData, size_t inCount ) const
+	{
+		( void ) ioData;
+		( void ) inCount;
+	}
+};
+
+template <>
+class ArrayByteSwapper< 2 >
+{
+public:
+	void Swap( char* ioData, size_t inCount ) const
+	{
+		size_t i = 0;
+#ifdef BYTESWAP_USE_SSE2
+		for( ; i + 8 <= inCount; i += 8 )
+		{
+			__m128i* block = reinterpret_cast< __m128i* >( ioData + i * 2 );
+			_mm_storeu_si128( block, ByteSwapLanes2( _mm_loadu_si128( block ) ) );
+		}
+#endif
+		for( ; i < inCount; ++i )
+		{
+			uint16_t element;
+			std::memcpy( &element, ioData + i * 2, 2 );
+			element = ByteSwap2( element );
+			std::memcpy( ioData + i * 2, &element, 2 );
+		}
+	}
+};
+
+template <>
+class ArrayByteSwapper< 4 >
+{
+public:
+	void Swap( char* ioData, size_t inCount ) const
+	{
+		size_t i = 0;
+#ifdef BYTESWAP_USE_SSE2
+		for( ; i + 4 <= inCount; i += 4 )
+		{
+			__m128i* block = reinterpret_cast< __m128i* >( ioData + i * 4 );
+			_mm_storeu_si128( block, ByteSwapLanes4( _mm_loadu_si128( block ) ) );
+		}
+#endif
+		for( ; i < inCount; ++i )
+		{
+			uint32_t element;
+			std::memcpy( &element, ioData + i * 4, 4 );
+			element = ByteSwap4( element );
+			std::memcpy( ioData + i * 4, &element, 4 );
+		}
+	}
+};
+
+template <>
+class ArrayByteSwapper< 8 >
+{
+public:
+	void Swap( char* ioData, size_t inCount ) const
+	{
+		size_t i = 0;
+#ifdef BYTESWAP_USE_SSE2
+		for( ; i + 2 <= inCount; i += 2 )
+		{
+			__m128i* block = reinterpret_cast< __m128i* >( ioData + i * 8 );
+			_mm_storeu_si128( block, ByteSwapLanes8( _mm_loadu_si128( block ) ) );
+		}
+#endif
+		for( ; i < inCount; ++i )
+		{
+			uint64_t element;
+			std::memcpy( &element, ioData + i * 8, 8 );
+			element = ByteSwap8( element );
+			std::memcpy( ioData + i * 8, &element, 8 );
+		}
+	}
+};
+
+template < typename T >
+void ByteSwapArray( void* ioData, size_t inCount )
+{
+	ArrayByteSwapper< sizeof( T ) >().Swap( static_cast< char* >( ioData ), inCount );
+}
+
 inline void TestByteSwap()
 {
 	int32_t test = 0x12345678;
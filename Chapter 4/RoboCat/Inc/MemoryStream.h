@@ -8,10 +8,16 @@
 class GameObject;
 class LinkingContext;
 
+//primitives can go in and out of a vector with a single copy. vector< bool > is packed, so it can't
+template< typename T >
+struct IsBulkSerializable : std::integral_constant< bool,
+	( std::is_arithmetic< T >::value || std::is_enum< T >::value ) && !std::is_same< T, bool >::value > {};
+
 class OutputMemoryStream
 {
 public:
 	OutputMemoryStream() :
+	mBuffer( nullptr ), mHead( 0 ), mCapacity( 0 ),
 	mLinkingContext( nullptr )
 	{ ReallocBuffer( 32 ); }
 	
@@ -42,22 +48,12 @@ public:
 		
 	}
 	
-	void Write( const std::vector< int >& inIntVector )
-	{
-		size_t elementCount = inIntVector.size();
-		Write( elementCount );
-		Write( inIntVector.data(), elementCount * sizeof( int ) );
-	}
-	
 	template< typename T >
 	void Write( const std::vector< T >& inVector )
 	{
-		uint32_t elementCount = inVector.size();
+		uint32_t elementCount = static_cast< uint32_t >( inVector.size() );
 		Write( elementCount );
-		for( const T& element : inVector )
-		{
-			Write( element );
-		}
+		WriteElements( inVector, IsBulkSerializable< T >() );
 	}
 	
 	void Write( const std::string& inString )
@@ -76,6 +72,30 @@ public:
 	
 private:
 			void		ReallocBuffer( uint32_t inNewLength );
+
+	template< typename T >
+	void WriteElements( const std::vector< T >& inVector, std::true_type )
+	{
+		//one copy for the lot, then fix up endianness in place in our buffer
+		if( !inVector.empty() )
+		{
+			uint32_t startHead = mHead;
+			Write( inVector.data(), inVector.size() * sizeof( T ) );
+			if( STREAM_ENDIANNESS != PLATFORM_ENDIANNESS )
+			{
+				ByteSwapArray< T >( mBuffer + startHead, inVector.size() );
+			}
+		}
+	}
+
+	template< typename T >
+	void WriteElements( const std::vector< T >& inVector, std::false_type )
+	{
+		for( const T& element : inVector )
+		{
+			Write( element );
+		}
+	}
 	
 	char*		mBuffer;
 	uint32_t	mHead;
@@ -105,18 +125,19 @@ public:
 					   std::is_enum< T >::value,
 					   "Generic Read only supports primitive data types" );
 		Read( &outData, sizeof( outData ) );
+		if( STREAM_ENDIANNESS != PLATFORM_ENDIANNESS )
+		{
+			outData = ByteSwap( outData );
+		}
 	}
 	
 	template< typename T >
 	void Read( std::vector< T >& outVector )
 	{
-		size_t elementCount;
+		uint32_t elementCount;
 		Read( elementCount );
 		outVector.resize( elementCount );
-		for( const T& element : outVector )
-		{
-			Read( element );
-		}
+		ReadElements( outVector, IsBulkSerializable< T >() );
 	}
 	
 	void Read( GameObject*& outGameObject )
@@ -127,6 +148,28 @@ public:
 	}
 	
 private:
+	template< typename T >
+	void ReadElements( std::vector< T >& outVector, std::true_type )
+	{
+		if( !outVector.empty() )
+		{
+			Read( outVector.data(), static_cast< uint32_t >( outVector.size() * sizeof( T ) ) );
+			if( STREAM_ENDIANNESS != PLATFORM_ENDIANNESS )
+			{
+				ByteSwapArray< T >( outVector.data(), outVector.size() );
+			}
+		}
+	}
+
+	template< typename T >
+	void ReadElements( std::vector< T >& outVector, std::false_type )
+	{
+		for( T& element : outVector )
+		{
+			Read( element );
+		}
+	}
+
 	char*		mBuffer;
 	uint32_t	mHead;
 	uint32_t	mCapacity;
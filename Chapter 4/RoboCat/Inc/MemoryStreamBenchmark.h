@@ -0,0 +1,3 @@
+
+//times element by element vs bulk vector serialization and byte swapping, and prints MB/s for each
+void RunMemoryStreamBenchmark();
@@ -54,3 +54,4 @@ class GameObject;
 #include "ByteSwap.h"
 #include "MemoryStream.h"
 #include "MemoryBitStream.h"
+#include "MemoryStreamBenchmark.h"
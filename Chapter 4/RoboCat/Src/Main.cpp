@@ -7,6 +7,7 @@ int WINAPI WinMain( _In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 	UNREFERENCED_PARAMETER( hPrevInstance );
 	UNREFERENCED_PARAMETER( lpCmdLine );
 	
+	RunMemoryStreamBenchmark();
 }
 #else
 const char** __argv;
@@ -16,6 +17,7 @@ int main(int argc, const char** argv)
 	__argc = argc;
 	__argv = argv;
 	
+	RunMemoryStreamBenchmark();
 }
 #endif
 
@@ -0,0 +1,117 @@
+#include "RoboCatPCH.h"
+#include <chrono>
+
+namespace
+{
+	const size_t kElementCount = 1 << 20;
+	const int kIterationCount = 20;
+
+	typedef std::chrono::high_resolution_clock Clock;
+
+	double GetSecondsSince( Clock::time_point inStart )
+	{
+		return std::chrono::duration< double >( Clock::now() - inStart ).count();
+	}
+
+	void PrintResult( const char* inTypeName, const char* inCaseName, size_t inByteCount, double inBestSeconds )
+	{
+		printf( "%-10s %-28s %10.1f MB/s\n", inTypeName, inCaseName, inByteCount / inBestSeconds / ( 1024.0 * 1024.0 ) );
+	}
+
+	template< typename T >
+	void BenchmarkType( const char* inTypeName )
+	{
+		vector< T > source( kElementCount );
+		for( size_t i = 0; i < kElementCount; ++i )
+		{
+			source[ i ] = static_cast< T >( i * 7 + 3 );
+		}
+
+		size_t byteCount = kElementCount * sizeof( T );
+		double bestPerElementWrite = 1e9, bestBulkWrite = 1e9, bestPerElementRead = 1e9, bestBulkRead = 1e9;
+		double bestPerElementSwap = 1e9, bestBulkSwap = 1e9;
+
+		vector< T > swapped( source );
+		vector< T > readBack;
+
+		for( int iteration = 0; iteration < kIterationCount; ++iteration )
+		{
+			//the old path- every element goes through the generic Write on its own
+			{
+				OutputMemoryStream stream;
+				Clock::time_point start = Clock::now();
+				for( const T& element : source )
+				{
+					stream.Write( element );
+				}
+				bestPerElementWrite = std::min( bestPerElementWrite, GetSecondsSince( start ) );
+			}
+
+			OutputMemoryStream stream;
+			Clock::time_point start = Clock::now();
+			stream.Write( source );
+			bestBulkWrite = std::min( bestBulkWrite, GetSecondsSince( start ) );
+
+			//input streams own their buffer, so hand each one a copy
+			{
+				char* buffer = static_cast< char* >( std::malloc( stream.GetLength() ) );
+				std::memcpy( buffer, stream.GetBufferPtr(), stream.GetLength() );
+				InputMemoryStream inStream( buffer, stream.GetLength() );
+
+				start = Clock::now();
+				uint32_t elementCount;
+				inStream.Read( elementCount );
+				readBack.resize( elementCount );
+				for( T& element : readBack )
+				{
+					inStream.Read( element );
+				}
+				bestPerElementRead = std::min( bestPerElementRead, GetSecondsSince( start ) );
+			}
+			{
+				char* buffer = static_cast< char* >( std::malloc( stream.GetLength() ) );
+				std::memcpy( buffer, stream.GetBufferPtr(), stream.GetLength() );
+				InputMemoryStream inStream( buffer, stream.GetLength() );
+
+				start = Clock::now();
+				inStream.Read( readBack );
+				bestBulkRead = std::min( bestBulkRead, GetSecondsSince( start ) );
+			}
+
+			//what a mismatched endianness costs on top of the copy
+			start = Clock::now();
+			for( T& element : swapped )
+			{
+				element = ByteSwap( element );
+			}
+			bestPerElementSwap = std::min( bestPerElementSwap, GetSecondsSince( start ) );
+
+			start = Clock::now();
+			ByteSwapArray< T >( swapped.data(), swapped.size() );
+			bestBulkSwap = std::min( bestBulkSwap, GetSecondsSince( start ) );
+		}
+
+		//an even number of swaps each, so we should be back where we started
+		if( readBack != source || swapped != source )
+		{
+			printf( "%-10s round trip FAILED\n", inTypeName );
+		}
+
+		PrintResult( inTypeName, "write per element", byteCount, bestPerElementWrite );
+		PrintResult( inTypeName, "write bulk", byteCount, bestBulkWrite );
+		PrintResult( inTypeName, "read per element", byteCount, bestPerElementRead );
+		PrintResult( inTypeName, "read bulk", byteCount, bestBulkRead );
+		PrintResult( inTypeName, "byte swap per element", byteCount, bestPerElementSwap );
+		PrintResult( inTypeName, "byte swap bulk", byteCount, bestBulkSwap );
+	}
+}
+
+void RunMemoryStreamBenchmark()
+{
+	printf( "%d elements, best of %d\n", static_cast< int >( kElementCount ), kIterationCount );
+
+	BenchmarkType< uint16_t >( "uint16_t" );
+	BenchmarkType< uint32_t >( "uint32_t" );
+	BenchmarkType< float >( "float" );
+	BenchmarkType< double >( "double" );
+}
@@ -7,6 +7,8 @@ public:
 	
 	//if this is the next in sequence, just extend the range
 	inline bool ExtendIfShould( PacketSequenceNumber inSequenceNumber );
+	//if this is the last in the range, take it back off the end
+	inline bool RetractIfLast( PacketSequenceNumber inSequenceNumber );
 	
 	PacketSequenceNumber	GetStart() const { return mStart; }
 	uint32_t		GetCount() const { return mCount; }
@@ -30,4 +32,17 @@ inline bool AckRange::ExtendIfShould( PacketSequenceNumber inSequenceNumber )
 	{
 		return false;
 	}
+}
+
+inline bool AckRange::RetractIfLast( PacketSequenceNumber inSequenceNumber )
+{
+	if( mCount > 0 && inSequenceNumber == static_cast< PacketSequenceNumber >( mStart + mCount - 1 ) )
+	{
+		--mCount;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
 }
\ No newline at end of file
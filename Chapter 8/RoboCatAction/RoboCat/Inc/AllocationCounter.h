@@ -0,0 +1,65 @@
+//counting heap allocations means replacing global operator new, so it's only on in debug builds unless asked for
+#ifndef ROBOCAT_COUNT_ALLOCATIONS
+	#if defined( _DEBUG ) || defined( DEBUG )
+		#define ROBOCAT_COUNT_ALLOCATIONS 1
+	#else
+		#define ROBOCAT_COUNT_ALLOCATIONS 0
+	#endif
+#endif
+
+//what the frame was up to when something hit the heap. every thread has its own current phase, and jobs run in the phase of
+//whoever started them
+enum EAllocationPhase
+{
+	EAP_Other,
+	EAP_Receive,
+	EAP_Simulate,
+	EAP_Replicate,
+	EAP_Send,
+	//still counted, but never held against a frame- for test harnesses doing their own thing mid frame
+	EAP_Untracked,
+
+	EAP_Count
+};
+
+namespace AllocationCounter
+{
+	struct Totals
+	{
+		Totals() : mAllocationCount( 0 ), mByteCount( 0 ), mFreeCount( 0 ) {}
+
+		uint64_t	mAllocationCount;
+		uint64_t	mByteCount;
+		uint64_t	mFreeCount;
+	};
+
+	//every trip through global operator new since startup, from any thread, outside EAP_Untracked. always 0 when counting's off
+	uint64_t			GetAllocationCount();
+	Totals				GetTotals( EAllocationPhase inPhase );
+	const char*			GetPhaseName( EAllocationPhase inPhase );
+
+	//the calling thread's
+	EAllocationPhase	GetPhase();
+	void				SetPhase( EAllocationPhase inPhase );
+}
+
+//charges allocations to inPhase until it goes out of scope, then puts back whatever phase was current before
+class AllocationPhaseScope
+{
+public:
+
+	AllocationPhaseScope( EAllocationPhase inPhase ) :
+		mPreviousPhase( AllocationCounter::GetPhase() )
+	{
+		AllocationCounter::SetPhase( inPhase );
+	}
+
+	~AllocationPhaseScope()
+	{
+		AllocationCounter::SetPhase( mPreviousPhase );
+	}
+
+private:
+
+	EAllocationPhase	mPreviousPhase;
+};
@@ -1,4 +1,7 @@
 
+//one packet in flight per send, so the blocks the deque grows and sheds come from the pools rather than the heap
+typedef deque< InFlightPacket, PoolAllocator< InFlightPacket > >	InFlightPacketQueue;
+
 class DeliveryNotificationManager
 {
 public:
@@ -11,12 +14,27 @@ public:
 	inline	bool				ReadAndProcessState( InputMemoryBitStream& inInputStream );
 	
 	void				ProcessTimedOutPackets();
+	//when the oldest packet still in flight gives up waiting for its ack- only means anything with packets in flight
+	float				GetNextTimeoutTime() const;
 	
 	uint32_t			GetDroppedPacketCount()		const	{ return mDroppedPacketCount; }
 	uint32_t			GetDeliveredPacketCount()	const	{ return mDeliveredPacketCount; }
 	uint32_t			GetDispatchedPacketCount()	const	{ return mDispatchedPacketCount; }
+
+	//incoming packets, and the ones we can tell went missing from gaps in the sequence numbers
+	uint32_t			GetReceivedPacketCount()	const	{ return mReceivedPacketCount; }
+	uint32_t			GetMissedPacketCount()		const	{ return mMissedPacketCount; }
+
+	//from sending a packet to hearing it was delivered, smoothed- only known on the side that processes acks.
+	//acks ride on the other side's own packets, so this includes however long they wait for one
+	float				GetRoundTripTime()			const	{ return mRoundTripTime; }
+
+	//sequence number of the packet most recently accepted by ReadAndProcessState
+	PacketSequenceNumber	GetLastReceivedSequenceNumber()	const	{ return static_cast< PacketSequenceNumber >( mNextExpectedSequenceNumber - 1 ); }
+	//for a packet that was accepted but couldn't be used- the sender sees it as dropped, and resends whatever was in it
+	void				RetractLastAck();
 	
-	const deque< InFlightPacket >&	GetInFlightPackets()	const	{ return mInFlightPackets; }
+	const InFlightPacketQueue&	GetInFlightPackets()	const	{ return mInFlightPackets; }
 	
 private:
 	
@@ -37,7 +55,7 @@ private:
 	PacketSequenceNumber	mNextOutgoingSequenceNumber;
 	PacketSequenceNumber	mNextExpectedSequenceNumber;
 	
-	deque< InFlightPacket >	mInFlightPackets;
+	InFlightPacketQueue		mInFlightPackets;
 	deque< AckRange >		mPendingAcks;
 	
 	bool					mShouldSendAcks;
@@ -46,6 +64,11 @@ private:
 	uint32_t		mDeliveredPacketCount;
 	uint32_t		mDroppedPacketCount;
 	uint32_t		mDispatchedPacketCount;
+
+	uint32_t		mReceivedPacketCount;
+	uint32_t		mMissedPacketCount;
+
+	float			mRoundTripTime;
 	
 };
 
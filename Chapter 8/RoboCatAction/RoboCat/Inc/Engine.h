@@ -1,30 +1,74 @@
 #include <SDL_events.h>
 
-class Engine
+//a context too- entering it points the thread at the program's world, scoreboard and timers, so the workers and the client's
+//simulation thread see the same ones as the main thread
+class Engine : public JobContext
 {
 public:
 
 	virtual ~Engine();
 	static std::unique_ptr< Engine >	sInstance;
 
+	virtual void	Enter() override;
+	virtual void	Leave() override;
+
+	//the loop runs entered
 	virtual int		Run();
 	void			SetShouldKeepRunning( bool inShouldKeepRunning ) { mShouldKeepRunning = inShouldKeepRunning; }
 	virtual void	HandleEvent( SDL_Event* inEvent );
 
+	//always 0 unless ROBOCAT_COUNT_ALLOCATIONS is on. untracked allocations aren't included- and that's everything from the
+	//render thread when the client simulates on its own thread, so these only ever cover the thread running frames and its jobs
+	uint32_t		GetHeapAllocationCountLastFrame()	const	{ return mHeapAllocationCountLastFrame; }
+	const AllocationCounter::Totals&	GetHeapAllocationsLastFrame( EAllocationPhase inPhase )	const	{ return mPhaseAllocationsLastFrame[ inPhase ]; }
+
+	//test mode- every frame that allocates from here on is logged with its phases and counted as a failure.
+	//turn it on once things have settled, since the first few frames of anything are allowed to allocate
+	void			SetIsZeroAllocationEnforced( bool inIsEnforced )	{ mIsZeroAllocationEnforced = inIsEnforced; }
+	uint32_t		GetZeroAllocationFailureCount()		const	{ return mZeroAllocationFailureCount; }
+
 protected:
 
 	Engine();
 
 	virtual void	DoFrame();
+	//events and frames on this thread until it's time to quit
+	virtual int		DoRunLoop();
+
+			//the pieces of the loop, for an engine that runs its own
+			bool	ShouldKeepRunning()		const	{ return mShouldKeepRunning; }
+			//startup doesn't count against the first frame
+			void	BeginFrames();
+			//ticks the clock, does the frame and ends it- only ever from the one thread
+			void	RunFrame();
 
 private:
 
 
 			
-			int		DoRunLoop();
+			//the frame's done, so throw away its scratch memory and count up what it cost
+			void	EndFrame();
 
 			bool	mShouldKeepRunning;
 
+			uint64_t	mHeapAllocationCountAtFrameEnd;
+			uint32_t	mHeapAllocationCountLastFrame;
+			uint32_t	mMaxHeapAllocationCountSinceReport;
+			uint32_t	mFrameCountSinceReport;
+			uint64_t	mHeapAllocationCountAtReport;
+			float		mTimeOfLastHeapAllocationReport;
+
+			AllocationCounter::Totals	mPhaseAllocationsAtFrameEnd[ EAP_Count ];
+			AllocationCounter::Totals	mPhaseAllocationsLastFrame[ EAP_Count ];
+			AllocationCounter::Totals	mPhaseAllocationsAtReport[ EAP_Count ];
+
+			bool		mIsZeroAllocationEnforced;
+			uint32_t	mZeroAllocationFailureCount;
+
+			World*				mWorld;
+			ScoreBoardManager*	mScoreBoardManager;
+			TimerWheel*			mTimerWheel;
+
 
 
 };
\ No newline at end of file
@@ -0,0 +1,161 @@
+//which fields of which classes get an adaptive model- everything else is range coded at a flat 50%
+//both ends of a connection must register exactly the same fields, in the same order.
+//a class's Write goes through its states in a fixed order, writing a flag for each and then, if it's set, that state's fields.
+//registering how many fields each state has lets the context follow along from the flags it codes, so a field keeps its model
+//however many of the states before it are dirty, without Write and Read having to say where they are
+class EntropyFieldRegistry
+{
+public:
+
+	//a field is which state it's in plus which Write call it is inside that state's block, counting the flag as the first
+	static const uint32_t	kMaxStatesPerClass = 6;
+	static const uint32_t	kMaxFieldsPerState = 8;
+	static const uint32_t	kMaxFieldsPerClass = kMaxStatesPerClass * kMaxFieldsPerState;
+	//pseudo class used for the per entry header the replication manager writes
+	static const uint32_t	kReplicationHeaderClassId = 'RPLH';
+
+	static void StaticInit();
+	static std::unique_ptr< EntropyFieldRegistry >	sInstance;
+
+	struct ClassFields
+	{
+		ClassFields() : mStateCount( 0 ), mRegisteredStateBits( 0 )	{ std::fill( mModelIndices, mModelIndices + kMaxFieldsPerClass, -1 ); }
+
+		//-1 for fields that aren't opted in
+		int			mModelIndices[ kMaxFieldsPerClass ];
+		//in the order Write goes through them. a class with none, like the replication header, is coded as one run of fields
+		uint32_t	mStateCount;
+		uint32_t	mStateFieldCounts[ kMaxStatesPerClass ];
+		uint32_t	mRegisteredStateBits;
+	};
+
+	static uint32_t	GetFieldIndex( uint32_t inStateIndex, uint32_t inSubFieldIndex );
+
+	//call once per state, in the order Write writes them, with how many fields follow the flag when it's set.
+	//a state bit of 0 is something written every time under a flag of its own, like the cat's thrust
+	void		RegisterState( uint32_t inClassId, uint32_t inStateBit, uint32_t inFieldCount );
+
+	void		OptInField( uint32_t inClassId, uint32_t inFieldIndex );
+	void		OptInAllFields( uint32_t inClassId );
+
+	//nullptr if the class has no coded fields
+	const ClassFields*	GetClassFields( uint32_t inClassId ) const;
+	uint32_t			GetModelCount()		const	{ return mModelCount; }
+
+private:
+
+	EntropyFieldRegistry();
+
+	unordered_map< uint32_t, ClassFields >	mClassIdToFields;
+	uint32_t								mModelCount;
+};
+
+
+//adaptive models for one direction of one connection.
+//models only ever adapt past a packet once the sender hears that packet was delivered, so lost packets can't desync the two ends:
+//each packet names the delivered packet whose models it was coded with, and the receiver replays the symbols it logged to catch up
+class EntropyCodingContext
+{
+public:
+
+	EntropyCodingContext();
+
+	//sender side- wrap the coded part of a packet with these
+	void	BeginEncoding( OutputMemoryBitStream& inOutputStream, InFlightPacket* inFlightPacket );
+	void	EndEncoding( OutputMemoryBitStream& inOutputStream );
+	void	HandlePacketDelivered( PacketSequenceNumber inSequenceNumber );
+
+	//receiver side- returns false if we can't rebuild the models the packet was coded with
+	bool	BeginDecoding( InputMemoryBitStream& inInputStream, PacketSequenceNumber inSequenceNumber );
+	void	EndDecoding( InputMemoryBitStream& inInputStream );
+
+	//the streams route their writes and reads through these while a context is attached
+	void	BeginObject( uint32_t inClassId );
+	void	EncodeBits( const void* inData, uint32_t inBitCount );
+	void	DecodeBits( void* outData, uint32_t inBitCount );
+
+private:
+
+	static const uint32_t	kRecordCount = 128;
+	static const uint32_t	kBaselineDeltaBits = 7;
+	static const uint32_t	kModelSize = 256;
+	//baseline id meaning the initial, untrained models
+	static const int		kInitialBaseline = -1;
+
+	struct CodedSymbol
+	{
+		CodedSymbol( uint32_t inModelIndex, uint8_t inSymbol, uint8_t inBitCount ) :
+			mModelIndex( inModelIndex ), mSymbol( inSymbol ), mBitCount( inBitCount ) {}
+
+		uint32_t	mModelIndex;
+		uint8_t		mSymbol;
+		uint8_t		mBitCount;
+	};
+
+	struct PacketRecord
+	{
+		PacketRecord() : mSequenceNumber( 0 ), mBaseline( kInitialBaseline ), mIsValid( false ) {}
+
+		PacketSequenceNumber	mSequenceNumber;
+		int						mBaseline;
+		bool					mIsValid;
+		vector< CodedSymbol >	mSymbols;
+	};
+
+	void	ResetModels();
+	bool	SyncToBaseline( int inBaseline );
+	void	StartRecord( PacketSequenceNumber inSequenceNumber );
+	void	ApplyRecord( const PacketRecord& inRecord );
+	void	UndoPacketAdaptation();
+
+	RangeCoderProbability*	GetModel( uint32_t inModelIndex )	{ return &mProbabilities[ inModelIndex * kModelSize ]; }
+	int						GetCurrentFieldModelIndex()	const;
+	void					BeginState( uint32_t inStateIndex );
+	//steps past the field just coded- inSymbol is what it coded to, which for a state's flag says whether its fields follow
+	void					AdvanceField( uint32_t inSymbol );
+	void					SaveTreePath( RangeCoderProbability* inModel, uint32_t inModelIndex, uint32_t inSymbol, uint32_t inBitCount );
+
+	vector< RangeCoderProbability >	mProbabilities;
+	//probabilities touched by the packet being coded, so we can go back to the baseline afterwards
+	vector< std::pair< uint32_t, RangeCoderProbability > >	mUndoLog;
+
+	int					mBaseline;
+	PacketRecord		mRecords[ kRecordCount ];
+	PacketRecord*		mCurrentRecord;
+
+	//null once we're past the last state, so anything after is coded flat
+	const EntropyFieldRegistry::ClassFields*	mClassFields;
+	uint32_t			mStateIndex;
+	uint32_t			mFieldIndex;
+	//one past the current state's last field- just the flag until we know it's set
+	uint32_t			mStateFieldEnd;
+	bool				mIsAtStateFlag;
+
+	OutputRangeCoder	mEncoder;
+	InputRangeCoder		mDecoder;
+};
+
+
+//rides along on the in flight packet so the sender can advance its baseline when the packet is ack'd
+class EntropyTransmissionData : public TransmissionData
+{
+public:
+
+	EntropyTransmissionData( EntropyCodingContext* inEntropyCodingContext, PacketSequenceNumber inSequenceNumber ) :
+	mEntropyCodingContext( inEntropyCodingContext ),
+	mSequenceNumber( inSequenceNumber )
+	{}
+
+	//a lost packet just never becomes a baseline- nothing to resend
+	virtual void HandleDeliveryFailure( DeliveryNotificationManager* inDeliveryNotificationManager ) const override	{ ( void ) inDeliveryNotificationManager; }
+	virtual void HandleDeliverySuccess( DeliveryNotificationManager* inDeliveryNotificationManager ) const override
+	{
+		( void ) inDeliveryNotificationManager;
+		mEntropyCodingContext->HandlePacketDelivered( mSequenceNumber );
+	}
+
+private:
+
+	EntropyCodingContext*	mEntropyCodingContext;
+	PacketSequenceNumber	mSequenceNumber;
+};
@@ -0,0 +1,58 @@
+/*
+* scratch memory for things that only live for one frame. allocating just bumps an offset and freeing does nothing-
+* the engine resets the whole thing after every DoFrame, so nothing allocated here may be held onto past the end of the frame.
+* only from the thread running frames- the main one, unless the client's simulating on its own
+*/
+class FrameArena
+{
+public:
+
+	static void StaticInit();
+
+	static std::unique_ptr< FrameArena >	sInstance;
+
+	~FrameArena();
+
+	void*	Allocate( size_t inSize, size_t inAlignment );
+
+	//frees everything at once. if the frame didn't fit, the buffer grows so the next one will
+	void	Reset();
+
+	size_t	GetCapacity()	const	{ return mCapacity; }
+	//this frame so far, overflow included
+	size_t	GetBytesUsed()	const	{ return mOffset + mOverflowByteCount; }
+
+private:
+
+	FrameArena( size_t inCapacity );
+
+	char*				mBuffer;
+	size_t				mCapacity;
+	size_t				mOffset;
+
+	//what didn't fit in the buffer came from the heap, and goes back at the reset
+	vector< void* >		mOverflowBlocks;
+	size_t				mOverflowByteCount;
+};
+
+
+//lets a standard container keep its memory in the frame arena- only for containers that die before the frame ends
+template< typename T >
+class FrameAllocator
+{
+public:
+
+	typedef T value_type;
+
+	FrameAllocator() {}
+	template< typename U > FrameAllocator( const FrameAllocator< U >& ) {}
+
+	T*		allocate( size_t inCount )					{ return static_cast< T* >( FrameArena::sInstance->Allocate( inCount * sizeof( T ), std::alignment_of< T >::value ) ); }
+	void	deallocate( T*, size_t )					{}
+
+	template< typename U > bool operator==( const FrameAllocator< U >& ) const	{ return true; }
+	template< typename U > bool operator!=( const FrameAllocator< U >& ) const	{ return false; }
+};
+
+template< typename T >
+using FrameVector = vector< T, FrameAllocator< T > >;
@@ -11,15 +11,24 @@ public:
 	CLASS_IDENTIFICATION( 'GOBJ', GameObject )
 
 	GameObject();
-	virtual ~GameObject() {}
+	virtual ~GameObject();
+
+	//every game object comes out of a pool sized for its class
+	static	void*	operator new( size_t inSize )					{ return ObjectPools::Allocate( inSize ); }
+	static	void	operator delete( void* inBlock, size_t inSize )	{ ObjectPools::Free( inBlock, inSize ); }
 
 	virtual	RoboCat*	GetAsCat()	{ return nullptr; }
 
 	virtual uint32_t GetAllStateMask()	const { return 0; }
 
-	//return whether to keep processing collision
-	virtual bool	HandleCollisionWithCat( RoboCat* inCat ) { ( void ) inCat; return true; }
+	//a cat ran into us. cats only bounce off each other, so this is for whatever else should happen-
+	//it comes in the serial half of the update, once the cat's done moving
+	virtual void	HandleCollisionWithCat( RoboCat* inCat ) { ( void ) inCat; }
 
+	//the first half of the world update, run on the job system alongside every other object.
+	//nothing in here may touch anything but this object's own state- anything else belongs in Update
+	virtual void	ParallelUpdate() {}
+	//the second half, run one object at a time in world order once everyone's done ParallelUpdate
 	virtual void	Update();
 
 	virtual void	HandleDying() {}
@@ -28,17 +37,17 @@ public:
 			int		GetIndexInWorld()				const				{ return mIndexInWorld; }
 
 			void	SetRotation( float inRotation );
-			float	GetRotation()					const				{ return mRotation; }
+			float	GetRotation()					const				{ return mTransformStore->GetRotation( mTransformIndex ); }
 
-			void	SetScale( float inScale )							{ mScale = inScale; }
-			float	GetScale()						const				{ return mScale; }
+			void	SetScale( float inScale )							{ mTransformStore->SetScale( mTransformIndex, inScale ); }
+			float	GetScale()						const				{ return mTransformStore->GetScale( mTransformIndex ); }
 
 
-	const Vector3&		GetLocation()				const				{ return mLocation; }
-			void		SetLocation( const Vector3& inLocation )		{ mLocation = inLocation; }
+			Vector3		GetLocation()				const				{ return mTransformStore->GetLocation( mTransformIndex ); }
+			void		SetLocation( const Vector3& inLocation )		{ mTransformStore->SetLocation( mTransformIndex, inLocation ); }
 
-			float		GetCollisionRadius()		const				{ return mCollisionRadius; }
-			void		SetCollisionRadius( float inRadius )			{ mCollisionRadius = inRadius; }
+			float		GetCollisionRadius()		const				{ return mTransformStore->GetCollisionRadius( mTransformIndex ); }
+			void		SetCollisionRadius( float inRadius )			{ mTransformStore->SetCollisionRadius( mTransformIndex, inRadius ); }
 
 			Vector3		GetForwardVector()			const;
 
@@ -49,29 +58,50 @@ public:
 			bool		DoesWantToDie()				const				{ return mDoesWantToDie; }
 			void		SetDoesWantToDie( bool inWants )				{ mDoesWantToDie = inWants; }
 
+			GameObjectHandle	GetHandle()				const				{ return mHandle; }
+
 			int			GetNetworkId()				const				{ return mNetworkId; }
 			void		SetNetworkId( int inNetworkId );
 
 	virtual uint32_t	Write( OutputMemoryBitStream& inOutputStream, uint32_t inDirtyState ) const	{ (void)inOutputStream; (void)inDirtyState; return 0; }
 	virtual void		Read( InputMemoryBitStream& inInputStream )									{ (void)inInputStream; }
 
+	//flat copies for world snapshots. reading leaves the network id alone- whoever registers the object owns that
+	virtual void		WriteSnapshot( GameObjectSnapshotRecord& outRecord ) const;
+	virtual void		ReadSnapshot( const GameObjectSnapshotRecord& inRecord );
+
+protected:
+
+	//anything with a velocity here gets moved by the world's batch integration every frame
+			Vector3		GetIntegratedVelocity()		const				{ return mTransformStore->GetVelocity( mTransformIndex ); }
+			void		SetIntegratedVelocity( const Vector3& inVelocity )	{ mTransformStore->SetVelocity( mTransformIndex, inVelocity ); }
+
 private:
 
+	friend class TransformStore;
+			void		SetTransformIndex( uint32_t inIndex )			{ mTransformIndex = inIndex; }
+
+	//location, rotation, scale and collision radius live in the world's transform store
+	TransformStore*									mTransformStore;
+	uint32_t										mTransformIndex;
 
-	Vector3											mLocation;
 	Vector3											mColor;
-	
-	float											mCollisionRadius;
 
 
-	float											mRotation;
-	float											mScale;
 	int												mIndexInWorld;
 
 	bool											mDoesWantToDie;
 
 	int												mNetworkId;
 
+	GameObjectHandle								mHandle;
+
 };
 
-typedef shared_ptr< GameObject >	GameObjectPtr;
\ No newline at end of file
+typedef shared_ptr< GameObject >	GameObjectPtr;
+
+//takes ownership of a freshly created object, with the control block coming from the pools too
+inline GameObjectPtr MakeGameObjectPtr( GameObject* inGameObject )
+{
+	return GameObjectPtr( inGameObject, std::default_delete< GameObject >(), PoolAllocator< GameObject >() );
+}
\ No newline at end of file
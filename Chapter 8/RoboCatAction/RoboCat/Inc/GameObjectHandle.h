@@ -0,0 +1,74 @@
+//a reference to a game object that's safe to hold onto without keeping the object alive.
+//it resolves to nullptr once the object's destroyed, even if its slot has since been handed to a new object
+class GameObjectHandle
+{
+public:
+
+	GameObjectHandle() : mIndex( 0 ), mGeneration( 0 ) {}
+
+	inline GameObject*	Get()		const;
+	bool				IsNull()	const	{ return mGeneration == 0; }
+
+	bool operator==( const GameObjectHandle& inOther ) const	{ return mIndex == inOther.mIndex && mGeneration == inOther.mGeneration; }
+	bool operator!=( const GameObjectHandle& inOther ) const	{ return !( *this == inOther ); }
+
+private:
+
+	friend class GameObjectHandleTable;
+
+	GameObjectHandle( uint32_t inIndex, uint32_t inGeneration ) : mIndex( inIndex ), mGeneration( inGeneration ) {}
+
+	uint32_t	mIndex;
+	uint32_t	mGeneration;
+};
+
+
+//every live game object has a slot here- objects take one when they're constructed and give it back when they're destroyed.
+//the server's matches share it from different threads, so acquiring and releasing take a lock. resolving doesn't- slots live in
+//pages that never move, and the only writes a handle can race with are to a slot its object has already given up
+class GameObjectHandleTable
+{
+public:
+
+	//created on first use and never freed, since game objects can outlive the other singletons at shutdown
+	static GameObjectHandleTable&	Get();
+
+	GameObjectHandle	Acquire( GameObject* inGameObject );
+	void				Release( GameObjectHandle inHandle );
+
+	GameObject*			Resolve( GameObjectHandle inHandle ) const
+	{
+		const Slot& slot = mPages[ inHandle.mIndex >> kSlotsPerPageShift ][ inHandle.mIndex & ( kSlotsPerPage - 1 ) ];
+		return slot.mGeneration.load( std::memory_order_relaxed ) == inHandle.mGeneration ? slot.mGameObject : nullptr;
+	}
+
+private:
+
+	static const uint32_t	kSlotsPerPageShift = 10;
+	static const uint32_t	kSlotsPerPage = 1 << kSlotsPerPageShift;
+	//a million live objects between every match
+	static const uint32_t	kMaxPageCount = 1024;
+
+	GameObjectHandleTable();
+
+	struct Slot
+	{
+		Slot() : mGameObject( nullptr ), mGeneration( 0 ) {}
+
+		GameObject*					mGameObject;
+		//bumped every time the slot is released, so old handles stop matching. 0 is never live
+		std::atomic< uint32_t >		mGeneration;
+	};
+
+	Slot&				GetSlot( uint32_t inIndex )	{ return mPages[ inIndex >> kSlotsPerPageShift ][ inIndex & ( kSlotsPerPage - 1 ) ]; }
+
+	std::mutex			mMutex;
+	Slot*				mPages[ kMaxPageCount ];
+	uint32_t			mSlotCount;
+	vector< uint32_t >	mFreeIndices;
+};
+
+inline GameObject* GameObjectHandle::Get() const
+{
+	return GameObjectHandleTable::Get().Resolve( *this );
+}
@@ -12,15 +12,8 @@ public:
 	PacketSequenceNumber GetSequenceNumber() const	{ return mSequenceNumber; }
 	float				 GetTimeDispatched() const	{ return mTimeDispatched; }
 	
-	void 				 SetTransmissionData( int inKey, TransmissionDataPtr	inTransmissionData )
-	{
-		mTransmissionDataMap[ inKey ] = inTransmissionData;
-	}
-	const TransmissionDataPtr GetTransmissionData( int inKey ) const
-	{
-		auto it = mTransmissionDataMap.find( inKey );
-		return ( it != mTransmissionDataMap.end() ) ? it->second : nullptr;
-	}
+	void 				 SetTransmissionData( int inKey, TransmissionDataPtr	inTransmissionData );
+	const TransmissionDataPtr GetTransmissionData( int inKey ) const;
 	
 	void			HandleDeliveryFailure( DeliveryNotificationManager* inDeliveryNotificationManager ) const;
 	void			HandleDeliverySuccess( DeliveryNotificationManager* inDeliveryNotificationManager ) const;
@@ -29,5 +22,10 @@ private:
 	PacketSequenceNumber	mSequenceNumber;
 	float			mTimeDispatched;
 	
-	unordered_map< int, TransmissionDataPtr >	mTransmissionDataMap;
+	//only replication and entropy coding ever attach data, so a couple of slots beat a map- no node to allocate per packet
+	static const int	kMaxTransmissionDataCount = 2;
+
+	int					mTransmissionDataKeys[ kMaxTransmissionDataCount ];
+	TransmissionDataPtr	mTransmissionData[ kMaxTransmissionDataCount ];
+	int					mTransmissionDataCount;
 };
\ No newline at end of file
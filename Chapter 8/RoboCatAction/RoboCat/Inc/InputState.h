@@ -11,10 +11,28 @@ public:
 	mIsShooting( false )
 	{}
 
+	//for input that doesn't come from keys- each delta is -1, 0 or 1
+	InputState( float inHorizontalDelta, float inVerticalDelta, bool inIsShooting ) :
+	mDesiredRightAmount( std::max( inHorizontalDelta, 0.f ) ),
+	mDesiredLeftAmount( std::max( -inHorizontalDelta, 0.f ) ),
+	mDesiredForwardAmount( std::max( inVerticalDelta, 0.f ) ),
+	mDesiredBackAmount( std::max( -inVerticalDelta, 0.f ) ),
+	mIsShooting( inIsShooting )
+	{}
+
 	float GetDesiredHorizontalDelta()	const { return mDesiredRightAmount - mDesiredLeftAmount; }
 	float GetDesiredVerticalDelta()		const { return mDesiredForwardAmount - mDesiredBackAmount; }
 	bool  IsShooting()					const { return mIsShooting; }
 
+	//the same as far as the wire's concerned
+	bool operator==( const InputState& inOther ) const
+	{
+		return GetDesiredHorizontalDelta() == inOther.GetDesiredHorizontalDelta() &&
+			GetDesiredVerticalDelta() == inOther.GetDesiredVerticalDelta() &&
+			mIsShooting == inOther.mIsShooting;
+	}
+	bool operator!=( const InputState& inOther ) const { return !( *this == inOther ); }
+
 	bool Write( OutputMemoryBitStream& inOutputStream ) const;
 	bool Read( InputMemoryBitStream& inInputStream );
 
@@ -0,0 +1,112 @@
+/*
+* whatever has to be set up on a thread before it can run someone's work- the engine and the server's matches point the thread's
+* world, scoreboard and friends at their own. a job runs inside the context of the thread that made it, wherever it ends up
+*/
+class JobContext
+{
+public:
+
+	virtual ~JobContext() {}
+
+	virtual void	Enter() = 0;
+	virtual void	Leave() = 0;
+
+	//null on a thread that's never entered one
+	static JobContext*	GetCurrent();
+
+private:
+
+	friend class JobContextScope;
+
+	static ROBOCAT_THREAD_LOCAL JobContext*	sCurrent;
+};
+
+//leaves whatever context the thread's in and enters inContext, then swaps them back when it goes out of scope. free if it's already in it
+class JobContextScope
+{
+public:
+
+	JobContextScope( JobContext* inContext );
+	~JobContextScope();
+
+private:
+
+	JobContext*	mContext;
+	JobContext*	mPreviousContext;
+};
+
+
+/*
+* a pool of worker threads that share out ranges of work.
+* every worker has its own queue and eats from the back of it, and once that's empty it steals from the front of everyone else's,
+* so an uneven split still finishes at about the same time. the thread calling ParallelFor pitches in too- from its own queue
+* if it's a worker, and from queue 0 otherwise
+*/
+class JobSystem
+{
+public:
+
+	typedef std::function< void( uint32_t inBegin, uint32_t inEnd ) > RangeFunction;
+
+	//inWorkerCount threads on top of the calling one- 0 runs everything inline
+	static void StaticInit( uint32_t inWorkerCount );
+	//one fewer than the hardware has, since the main thread works too
+	static uint32_t GetDefaultWorkerCount();
+
+	static std::unique_ptr< JobSystem >	sInstance;
+
+	~JobSystem();
+
+	//runs inFunction over [ 0, inCount ) in chunks of at most inGrainSize, and returns once every chunk is done.
+	//chunks can run in any order on any thread, so they mustn't touch each other's data. each runs in the caller's JobContext
+	//and allocation phase. jobs can start jobs of their own- the caller keeps running other chunks while it waits on them
+	void		ParallelFor( uint32_t inCount, uint32_t inGrainSize, const RangeFunction& inFunction );
+
+	uint32_t	GetWorkerCount()	const	{ return static_cast< uint32_t >( mWorkers.size() ); }
+
+private:
+
+	JobSystem( uint32_t inWorkerCount );
+
+	struct Job
+	{
+		const RangeFunction*		mFunction;
+		uint32_t					mBegin;
+		uint32_t					mEnd;
+		std::atomic< uint32_t >*	mRemainingJobCount;
+		JobContext*					mContext;
+		EAllocationPhase			mAllocationPhase;
+	};
+
+	//a ring that only ever grows, so once it's seen the busiest frame queueing jobs never touches the heap- a deque would keep
+	//freeing and reallocating its blocks as the jobs come and go
+	struct WorkQueue
+	{
+		WorkQueue() : mHead( 0 ), mCount( 0 ) {}
+
+		std::mutex		mMutex;
+		vector< Job >	mJobs;
+		uint32_t		mHead;
+		uint32_t		mCount;
+	};
+
+	void	Push( uint32_t inQueueIndex, const Job& inJob );
+	bool	PopOwn( uint32_t inQueueIndex, Job& outJob );
+	bool	Steal( uint32_t inThiefIndex, Job& outJob );
+	bool	FindJob( uint32_t inQueueIndex, Job& outJob );
+	void	RunJob( const Job& inJob );
+
+	void	WorkerLoop( uint32_t inQueueIndex );
+
+	//queue 0 belongs to every thread that isn't a worker, worker i owns queue i + 1
+	static ROBOCAT_THREAD_LOCAL uint32_t	sQueueIndex;
+
+	vector< unique_ptr< WorkQueue > >	mQueues;
+	vector< std::thread >				mWorkers;
+
+	//jobs sitting in queues that nobody's picked up yet- idle workers sleep until this goes above 0
+	std::atomic< uint32_t >				mQueuedJobCount;
+	std::mutex							mWakeMutex;
+	std::condition_variable				mWakeCondition;
+	bool								mIsShuttingDown;
+};
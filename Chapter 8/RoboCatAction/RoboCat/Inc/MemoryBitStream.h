@@ -5,6 +5,7 @@
 
 class GameObject;
 class LinkingContext;
+class EntropyCodingContext;
 
 inline uint32_t ConvertToFixed( float inNumber, float inMin, float inPrecision )
 {
@@ -23,7 +24,8 @@ public:
 
 	OutputMemoryBitStream() :
 		mBitHead(0),
-		mBuffer(nullptr)
+		mBuffer(nullptr),
+		mEntropyCodingContext(nullptr)
 	{
 		ReallocBuffer( 1500 * 8 );
 	}
@@ -39,6 +41,12 @@ public:
 
 	void WriteBytes( const void* inData, uint32_t inByteCount )	{ WriteBits( inData, inByteCount << 3 ); }
 
+	//while a context is attached, everything but the raw byte WriteBits goes through its range coder
+	void					SetEntropyCodingContext( EntropyCodingContext* inContext )	{ mEntropyCodingContext = inContext; }
+	EntropyCodingContext*	GetEntropyCodingContext()							const	{ return mEntropyCodingContext; }
+	//call before writing each object so its fields pick up that class's models. does nothing when not entropy coding
+	void					BeginEntropyCodedObject( uint32_t inClassId );
+
 	/*
 	void Write( uint32_t inData, uint32_t inBitCount = 32 )	{ WriteBits( &inData, inBitCount ); }
 	void Write( int inData, uint32_t inBitCount = 32 )		{ WriteBits( &inData, inBitCount ); }
@@ -80,6 +88,8 @@ private:
 	char*		mBuffer;
 	uint32_t	mBitHead;
 	uint32_t	mBitCapacity;
+
+	EntropyCodingContext*	mEntropyCodingContext;
 };
 
 class InputMemoryBitStream
@@ -90,12 +100,14 @@ public:
 	mBuffer( inBuffer ),
 	mBitCapacity( inBitCount ),
 	mBitHead( 0 ),
-	mIsBufferOwner( false ) {}
+	mIsBufferOwner( false ),
+	mEntropyCodingContext( nullptr ) {}
 	
 	InputMemoryBitStream( const InputMemoryBitStream& inOther ) :
 	mBitCapacity( inOther.mBitCapacity ),
 	mBitHead( inOther.mBitHead ),
-	mIsBufferOwner( true )
+	mIsBufferOwner( true ),
+	mEntropyCodingContext( nullptr )
 	{
 		//allocate buffer of right size
 		int byteCount = mBitCapacity / 8;
@@ -114,6 +126,10 @@ public:
 
 	void		ReadBytes( void* outData, uint32_t inByteCount )		{ ReadBits( outData, inByteCount << 3 ); }
 
+	void					SetEntropyCodingContext( EntropyCodingContext* inContext )	{ mEntropyCodingContext = inContext; }
+	EntropyCodingContext*	GetEntropyCodingContext()							const	{ return mEntropyCodingContext; }
+	void					BeginEntropyCodedObject( uint32_t inClassId );
+
 	template< typename T >
 	void Read( T& inData, uint32_t inBitCount = sizeof( T ) * 8 )
 	{
@@ -157,5 +173,7 @@ private:
 	uint32_t	mBitCapacity;
 	bool		mIsBufferOwner;
 
+	EntropyCodingContext*	mEntropyCodingContext;
+
 };
 
@@ -18,7 +18,7 @@ public:
 	virtual uint32_t	Write( OutputMemoryBitStream& inOutputStream, uint32_t inDirtyState ) const override;
 	virtual void		Read( InputMemoryBitStream& inInputStream ) override;
 
-	virtual bool HandleCollisionWithCat( RoboCat* inCat ) override;
+	virtual void HandleCollisionWithCat( RoboCat* inCat ) override;
 
 protected:
 	Mouse();
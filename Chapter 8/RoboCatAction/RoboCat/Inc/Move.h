@@ -2,27 +2,31 @@ class Move
 {
 public:
 
+	//moves are stamped in whole ticks, so they can go over the wire as small steps from one to the next instead of floats
+	static const uint32_t	kTicksPerSecond = 1000;
+
+	static uint32_t	TimeToTick( float inTime )		{ return static_cast< uint32_t >( inTime * kTicksPerSecond + 0.5f ); }
+	static float	TickToTime( uint32_t inTick )	{ return static_cast< float >( inTick ) / kTicksPerSecond; }
+
 	Move() {}
 
-	Move( const InputState& inInputState, float inTimestamp, float inDeltaTime ) :
+	Move( const InputState& inInputState, uint32_t inTick, float inDeltaTime ) :
 		mInputState( inInputState ),
-		mTimestamp( inTimestamp ),
+		mTick( inTick ),
+		mTimestamp( TickToTime( inTick ) ),
 		mDeltaTime( inDeltaTime )
 	{}
 
 
 	const InputState&	GetInputState()	const		{ return mInputState; }
+	uint32_t			GetTick()		const		{ return mTick; }
 	float				GetTimestamp()	const		{ return mTimestamp; }
 	float				GetDeltaTime()	const		{ return mDeltaTime; }
 
-	bool Write( OutputMemoryBitStream& inOutputStream ) const;
-	bool Read( InputMemoryBitStream& inInputStream );
-
 private:
 	InputState	mInputState;
+	uint32_t	mTick;
 	float		mTimestamp;
 	float		mDeltaTime;
 
 };
-
-
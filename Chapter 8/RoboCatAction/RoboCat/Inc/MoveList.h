@@ -1,37 +1,60 @@
+/*
+* moves in a fixed ring, oldest first, so adding and letting go of them never touches the heap.
+* a client that stops hearing back from the server keeps adding moves it can't let go of- once the ring's full,
+* the oldest move goes to make room. by then the server's about to drop the client anyway, and a cat that misses
+* a few seconds old move is better than one that stops taking input
+*/
 class MoveList
 {
 public:
 
-	typedef deque< Move >::const_iterator			const_iterator;
-	typedef deque< Move >::const_reverse_iterator	const_reverse_iterator;
-	
+	//a little over four seconds of moves on the client. a power of two, so wrapping round is a mask
+	static const uint32_t	kCapacity = 128;
+
 	MoveList():
-		mLastMoveTimestamp( -1.f )
+		mLastMoveTimestamp( -1.f ),
+		mLastMoveTick( 0 ),
+		mFirstMoveIndex( 0 ),
+		mMoveCount( 0 ),
+		mOverflowCount( 0 )
 	{}
 	
 	const	Move&	AddMove( const InputState& inInputState, float inTimestamp );
-			bool	AddMoveIfNew( const Move& inMove );
+			bool	AddMoveIfNew( const InputState& inInputState, uint32_t inTick );
 
 			void	RemovedProcessedMoves( float inLastMoveProcessedOnServerTimestamp );
 
+	//writes the moves from inFirstTick on- the newest kMaxMovesPerPacket of them, if there are more
+			void	Write( OutputMemoryBitStream& inOutputStream, uint32_t inFirstTick ) const;
+	//reads what Write wrote and adds whichever moves are new. returns whether there were any
+			bool	ReadAndAddNewMoves( InputMemoryBitStream& inInputStream );
+
 	float			GetLastMoveTimestamp()	const	{ return mLastMoveTimestamp; } 
 
-	const Move&		GetLatestMove()			const	{ return mMoves.back(); }
+	const Move&		GetLatestMove()			const	{ return GetMove( mMoveCount - 1 ); }
 
-	void			Clear()							{ mMoves.clear(); }
-	bool			HasMoves()				const	{ return !mMoves.empty(); }
-	int				GetMoveCount()			const	{ return mMoves.size(); }
+	void			Clear()							{ mFirstMoveIndex = 0; mMoveCount = 0; }
+	bool			HasMoves()				const	{ return mMoveCount != 0; }
+	int				GetMoveCount()			const	{ return mMoveCount; }
 
-	//for for each, we have to match stl calling convention
-	const_iterator	begin()					const	{ return mMoves.begin(); }
-	const_iterator	end()					const	{ return mMoves.end(); }
+	//0 is the oldest
+	const Move&		GetMove( uint32_t inIndex )	const	{ return mMoves[ ( mFirstMoveIndex + inIndex ) & ( kCapacity - 1 ) ]; }
 
-private:
+	//how many moves have gone to make room
+	uint32_t		GetOverflowCount()		const	{ return mOverflowCount; }
 
-	float			mLastMoveTimestamp;
-	deque< Move >	mMoves;
+	static const uint32_t	kMoveCountBitCount = 6;
+	static const uint32_t	kMaxMovesPerPacket = ( 1 << kMoveCountBitCount ) - 1;
 
+private:
 
+	Move&			PushMove();
 
+	float			mLastMoveTimestamp;
+	uint32_t		mLastMoveTick;
 
-};
\ No newline at end of file
+	Move			mMoves[ kCapacity ];
+	uint32_t		mFirstMoveIndex;
+	uint32_t		mMoveCount;
+	uint32_t		mOverflowCount;
+};
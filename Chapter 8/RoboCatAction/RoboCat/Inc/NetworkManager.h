@@ -1,20 +1,36 @@
-typedef unordered_map< int, GameObjectPtr > IntToGameObjectMap;
+//the world owns the objects, so the map just keeps handles to them. nodes come and go with every yarn, so they're pooled
+typedef unordered_map< int, GameObjectHandle, std::hash< int >, std::equal_to< int >, PoolAllocator< std::pair< const int, GameObjectHandle > > > IntToGameObjectMap;
+//a copy that's only needed for the frame
+typedef unordered_map< int, GameObjectHandle, std::hash< int >, std::equal_to< int >, FrameAllocator< std::pair< const int, GameObjectHandle > > > FrameIntToGameObjectMap;
 
 class NetworkManager
 {
 public:
-	static const uint32_t	kHelloCC = 'HELO';
-	static const uint32_t	kWelcomeCC = 'WLCM';
-	static const uint32_t	kStateCC = 'STAT';
-	static const uint32_t	kInputCC = 'INPT';
+	//every packet starts with its type in a few bits. after a hello, everything a client sends follows that with the
+	//connection id it was welcomed with, so the server can find the client by index, and then the delivery state with the sequence number
+	static const uint32_t	kHelloPacket = 0;
+	static const uint32_t	kWelcomePacket = 1;
+	static const uint32_t	kStatePacket = 2;
+	static const uint32_t	kInputPacket = 3;
+	static const uint32_t	kPacketTypeBitCount = 4;
+	static const uint32_t	kConnectionIdBitCount = 16;
 	static const int		kMaxPacketsPerFrameCount = 10;
 
+	//clients draw other players this far behind the newest state they have, and the server rewinds that far and more when it checks hits.
+	//three state packets' worth, so one can go missing and there's still a pair to blend between
+	static const float		kInterpolationDelay;
+
 	NetworkManager();
 	virtual ~NetworkManager();
 
 	bool	Init( uint16_t inPort );
+	//for when something else owns the socket- it reads for us and hands over our packets with QueuePacket
+	void	Init( UDPSocketPtr inSharedSocket );
 	void	ProcessIncomingPackets();
 
+	//as though it had just come off the socket, drop chance and simulated latency included
+	void	QueuePacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress );
+
 	virtual void	ProcessPacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress ) = 0;
 	virtual void	HandleConnectionReset( const SocketAddress& inFromAddress ) { ( void ) inFromAddress; }
 
@@ -26,9 +42,9 @@ public:
 			void	SetDropPacketChance( float inChance )	{ mDropPacketChance = inChance; }
 			void	SetSimulatedLatency( float inLatency )	{ mSimulatedLatency = inLatency; }
 
-			inline	GameObjectPtr	GetGameObject( int inNetworkId ) const;
-			void	AddToNetworkIdToGameObjectMap( GameObjectPtr inGameObject );
-			void	RemoveFromNetworkIdToGameObjectMap( GameObjectPtr inGameObject );
+			inline	GameObject*		GetGameObject( int inNetworkId ) const;
+			void	AddToNetworkIdToGameObjectMap( GameObject* inGameObject );
+			void	RemoveFromNetworkIdToGameObjectMap( GameObject* inGameObject );
 
 protected:
 
@@ -46,25 +62,34 @@ private:
 					InputMemoryBitStream&	GetPacketBuffer()			{ return mPacketBuffer; }
 
 		private:
+
+			//the stream reads out of mPacketMem, so a packet is only ever built in place in the queue
+			ReceivedPacket( const ReceivedPacket& );
+			ReceivedPacket& operator=( const ReceivedPacket& );
 			
 			float					mReceivedTime;
+			//pooled, so queueing a packet doesn't touch the heap
+			vector< char, PoolAllocator< char > >	mPacketMem;
 			InputMemoryBitStream	mPacketBuffer;
 			SocketAddress			mFromAddress;
 
 		};
 
 			void	UpdateBytesSentLastFrame();
+			void	UpdateBytesReceivedLastFrame();
 			void	ReadIncomingPacketsIntoQueue();
 			void	ProcessQueuedPackets();
 
-	queue< ReceivedPacket, list< ReceivedPacket > >	mPacketQueue;
+	queue< ReceivedPacket, list< ReceivedPacket, PoolAllocator< ReceivedPacket > > >	mPacketQueue;
 
 	UDPSocketPtr	mSocket;
+	bool			mIsSocketShared;
 
 	WeightedTimedMovingAverage	mBytesReceivedPerSecond;
 	WeightedTimedMovingAverage	mBytesSentPerSecond;
 
 	int							mBytesSentThisFrame;
+	int							mBytesReceivedThisFrame;
 
 	float						mDropPacketChance;
 	float						mSimulatedLatency;
@@ -73,15 +98,15 @@ private:
 
 	
 	
-inline	GameObjectPtr NetworkManager::GetGameObject( int inNetworkId ) const
+inline	GameObject* NetworkManager::GetGameObject( int inNetworkId ) const
 { 
 	auto gameObjectIt = mNetworkIdToGameObjectMap.find( inNetworkId );
 	if( gameObjectIt != mNetworkIdToGameObjectMap.end() )
 	{
-		return gameObjectIt->second;
+		return gameObjectIt->second.Get();
 	}
 	else
 	{
-		return GameObjectPtr();
+		return nullptr;
 	}
 }
@@ -0,0 +1,68 @@
+//hands out fixed size blocks carved from big chunks. freed blocks go on a list for reuse, so steady state churn never touches the heap.
+//locked, since the server's matches spawn and destroy objects from different threads
+class FixedBlockPool
+{
+public:
+
+	FixedBlockPool( size_t inBlockSize, size_t inBlocksPerChunk );
+
+	void*	Allocate();
+	void	Free( void* inBlock );
+
+	size_t	GetBlockSize()		const	{ return mBlockSize; }
+	size_t	GetChunkCount()		const	{ std::lock_guard< std::mutex > lock( mMutex ); return mChunks.size(); }
+
+private:
+
+	struct FreeBlock
+	{
+		FreeBlock*	mNext;
+	};
+
+	//with the lock held
+	void	AddChunk();
+
+	mutable std::mutex				mMutex;
+	size_t							mBlockSize;
+	size_t							mBlocksPerChunk;
+	FreeBlock*						mFreeList;
+	vector< unique_ptr< char[] > >	mChunks;
+};
+
+
+//one pool per allocation size, which works out to one per game object class plus one per shared_ptr control block type.
+//anything too big for a pool goes straight to the heap
+class ObjectPools
+{
+public:
+
+	static const size_t	kAlignment = 16;
+	static const size_t	kMaxPooledSize = 1024;
+	static const size_t	kBlocksPerChunk = 256;
+
+	static void*	Allocate( size_t inSize );
+	static void		Free( void* inBlock, size_t inSize );
+
+private:
+
+	static FixedBlockPool*	GetPool( size_t inSize );
+};
+
+
+//routes a standard container's or shared_ptr's allocations through the pools
+template< typename T >
+class PoolAllocator
+{
+public:
+
+	typedef T value_type;
+
+	PoolAllocator() {}
+	template< typename U > PoolAllocator( const PoolAllocator< U >& ) {}
+
+	T*		allocate( size_t inCount )					{ return static_cast< T* >( ObjectPools::Allocate( inCount * sizeof( T ) ) ); }
+	void	deallocate( T* inBlock, size_t inCount )	{ ObjectPools::Free( inBlock, inCount * sizeof( T ) ); }
+
+	template< typename U > bool operator==( const PoolAllocator< U >& ) const	{ return true; }
+	template< typename U > bool operator!=( const PoolAllocator< U >& ) const	{ return false; }
+};
@@ -0,0 +1,79 @@
+//binary adaptive range coder, in the style of LZMA's rc
+//probabilities are 11 bit estimates of a bit being 0, and adapt by 1/32 of the error each time they're used
+
+typedef uint16_t	RangeCoderProbability;
+
+namespace RangeCoder
+{
+	const uint32_t				kProbabilityBits = 11;
+	const RangeCoderProbability	kProbabilityInitial = ( 1 << kProbabilityBits ) / 2;
+	const uint32_t				kAdaptShift = 5;
+	const uint32_t				kTopValue = 1 << 24;
+
+	inline void AdaptProbability( RangeCoderProbability& ioProbability, uint32_t inBit )
+	{
+		if( inBit == 0 )
+		{
+			ioProbability += ( ( 1 << kProbabilityBits ) - ioProbability ) >> kAdaptShift;
+		}
+		else
+		{
+			ioProbability -= ioProbability >> kAdaptShift;
+		}
+	}
+}
+
+class OutputRangeCoder
+{
+public:
+
+	OutputRangeCoder() :
+		mOutputStream( nullptr )
+	{}
+
+	void		Begin( OutputMemoryBitStream& inOutputStream );
+	void		End();
+
+	void		EncodeBit( RangeCoderProbability& ioProbability, uint32_t inBit );
+	void		EncodeDirectBits( uint32_t inValue, uint32_t inBitCount );
+	//bit tree with inBitCount levels, msb first. ioProbabilities must have 1 << inBitCount entries
+	void		EncodeBitTree( RangeCoderProbability* ioProbabilities, uint32_t inSymbol, uint32_t inBitCount );
+
+private:
+
+	void		ShiftLow();
+
+	OutputMemoryBitStream*	mOutputStream;
+
+	uint64_t	mLow;
+	uint32_t	mRange;
+	uint32_t	mCacheSize;
+	uint8_t		mCache;
+	//the first byte an lzma style coder outputs is always 0, so we never send it
+	bool		mHasSkippedFirstByte;
+};
+
+class InputRangeCoder
+{
+public:
+
+	InputRangeCoder() :
+		mInputStream( nullptr )
+	{}
+
+	void		Begin( InputMemoryBitStream& inInputStream );
+	void		End()	{ mInputStream = nullptr; }
+
+	uint32_t	DecodeBit( RangeCoderProbability& ioProbability );
+	uint32_t	DecodeDirectBits( uint32_t inBitCount );
+	uint32_t	DecodeBitTree( RangeCoderProbability* ioProbabilities, uint32_t inBitCount );
+
+private:
+
+	inline void	Normalize();
+
+	InputMemoryBitStream*	mInputStream;
+
+	uint32_t	mRange;
+	uint32_t	mCode;
+};
@@ -23,11 +23,18 @@ public:
 	virtual void Update()	override;
 
 	void ProcessInput( float inDeltaTime, const InputState& inInputState );
+	//true if the move with this tick fires a shot. it goes by move ticks rather than frame time, so the client and server agree on which moves shoot
+	bool TryShoot( uint32_t inMoveTick );
+	//only changes the cat itself, so it's safe in ParallelUpdate- other cats are collided with where they were at the start of the frame
 	void SimulateMovement( float inDeltaTime );
 
 	void ProcessCollisions();
+	void ProcessCollisionsWithObjects();
 	void ProcessCollisionsWithScreenWalls();
 
+	//tells whatever non-cats we ran into since last time- call it from Update, or somewhere else nobody's moving side by side
+	void HandleTouchedObjects();
+
 	void		SetPlayerId( uint32_t inPlayerId )			{ mPlayerId = inPlayerId; }
 	uint32_t	GetPlayerId()						const 	{ return mPlayerId; }
 
@@ -36,6 +43,9 @@ public:
 
 	virtual uint32_t	Write( OutputMemoryBitStream& inOutputStream, uint32_t inDirtyState ) const override;
 
+	virtual void		WriteSnapshot( GameObjectSnapshotRecord& outRecord ) const override;
+	virtual void		ReadSnapshot( const GameObjectSnapshotRecord& inRecord ) override;
+
 protected:
 	RoboCat();
 
@@ -43,6 +53,9 @@ private:
 
 
 	void	AdjustVelocityByThrust( float inDeltaTime );
+	//thrust, move and bounce off the walls
+	void	IntegrateMovement( float inDeltaTime );
+	void	TouchObject( GameObjectHandle inHandle );
 
 	Vector3				mVelocity;
 
@@ -57,6 +70,10 @@ private:
 
 	uint32_t			mPlayerId;
 
+	static const uint32_t	kMaxTouchedObjects = 8;
+	GameObjectHandle	mTouchedObjects[ kMaxTouchedObjects ];
+	uint32_t			mTouchedObjectCount;
+
 protected:
 
 	///move down here for padding reasons...
@@ -67,6 +84,7 @@ protected:
 	int					mHealth;
 
 	bool				mIsShooting;
+	uint32_t			mTickOfNextShot;
 
 	
 
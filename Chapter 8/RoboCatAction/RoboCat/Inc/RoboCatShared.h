@@ -24,6 +24,15 @@
 	const int SOCKET_ERROR = -1;
 #endif
 
+//statics with a copy per thread. vs2013 doesn't have the keyword, and its __declspec( thread ) only takes plain old data- so stick to pointers and numbers
+#if defined( _MSC_VER ) && _MSC_VER < 1900
+	#define ROBOCAT_THREAD_LOCAL __declspec( thread )
+#elif defined( __GNUC__ )
+	#define ROBOCAT_THREAD_LOCAL __thread
+#else
+	#define ROBOCAT_THREAD_LOCAL thread_local
+#endif
+
 #include "memory"
 
 #include "vector"
@@ -34,6 +43,11 @@
 #include "deque"
 #include "unordered_set"
 #include "cassert"
+#include "functional"
+#include "thread"
+#include "mutex"
+#include "condition_variable"
+#include "atomic"
 
 using std::shared_ptr;
 using std::unique_ptr;
@@ -47,8 +61,10 @@ using std::unordered_set;
 
 class RoboCat;
 class GameObject;
+struct GameObjectSnapshotRecord;
 
 #include "RoboMath.h"
+#include "ObjectPool.h"
 
 #include "StringUtils.h"
 #include "SocketAddress.h"
@@ -60,17 +76,25 @@ class GameObject;
 #include "ByteSwap.h"
 #include "LinkingContext.h"
 #include "MemoryBitStream.h"
+#include "RangeCoder.h"
 
 #include "TransmissionData.h"
 #include "InFlightPacket.h"
 #include "AckRange.h"
 #include "DeliveryNotificationManager.h"
+#include "EntropyCodingContext.h"
 
 #include "InputAction.h"
 #include "InputState.h"
 #include "Move.h"
 #include "MoveList.h"
 
+#include "AllocationCounter.h"
+#include "FrameArena.h"
+#include "JobSystem.h"
+#include "TimerWheel.h"
+#include "GameObjectHandle.h"
+#include "TransformStore.h"
 #include "GameObject.h"
 #include "GameObjectRegistry.h"
 #include "RoboCat.h"
@@ -80,6 +104,7 @@ class GameObject;
 #include "Yarn.h"
 #include "StringUtils.h"
 #include "ScoreBoardManager.h"
+#include "WorldSnapshot.h"
 
 #include "WeightedTimedMovingAverage.h"
 #include "ReplicationCommand.h"
@@ -1,3 +1,22 @@
+//x64 always has sse2, and 32 bit x86 builds get it with /arch:SSE2 or -msse2. 64 bit arm always has neon
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define ROBOMATH_USE_SSE 1
+	#define ROBOMATH_USE_NEON 0
+	#include <emmintrin.h>
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+	#define ROBOMATH_USE_SSE 0
+	#define ROBOMATH_USE_NEON 1
+	#include <arm_neon.h>
+#else
+	#define ROBOMATH_USE_SSE 0
+	#define ROBOMATH_USE_NEON 0
+#endif
+
+#define ROBOMATH_USE_SIMD ( ROBOMATH_USE_SSE || ROBOMATH_USE_NEON )
+
+//deliberately scalar. snapshots and the transform store copy it around as three packed floats, and a four wide version that keeps
+//that layout spends longer packing and unpacking lanes than doing the math- about 3x slower than this on a lerp and dot loop.
+//anything that wants the wide math goes through the batch functions below on separate x, y and z arrays instead
 class Vector3
 {
 public:
@@ -74,39 +93,40 @@ public:
 		return *this;
 	}
 	
-	float Length()
+	float Length() const
 	{
 		return sqrtf( mX * mX + mY * mY + mZ * mZ );
 	}
 	
-	float LengthSq()
+	float LengthSq() const
 	{
 		return mX * mX + mY * mY + mZ * mZ;
 	}
 	
-	float Length2D()
+	float Length2D() const
 	{
 		return sqrtf( mX * mX + mY * mY );
 	}
 	
-	float LengthSq2D()
+	float LengthSq2D() const
 	{
 		return mX * mX + mY * mY;
 	}
 	
 	void Normalize()
 	{
-		float length = Length();
-		mX /= length;
-		mY /= length;
-		mZ /= length;
+		//one divide instead of three
+		float inverseLength = 1.f / Length();
+		mX *= inverseLength;
+		mY *= inverseLength;
+		mZ *= inverseLength;
 	}
 	
 	void Normalize2D()
 	{
-		float length = Length2D();
-		mX /= length;
-		mY /= length;
+		float inverseLength = 1.f / Length2D();
+		mX *= inverseLength;
+		mY *= inverseLength;
 	}
 	
 	friend float Dot( const Vector3& inLeft, const Vector3& inRight )
@@ -183,6 +203,53 @@ namespace RoboMath
 	{
 		return inRadians * 180.0f / PI;
 	}
+
+	//batch versions work on separate x, y ( and z ) arrays, four at a time where there's simd, so they line up with the transform store.
+	//sqrt and divide are correctly rounded in every path, so results match the one at a time math unless the compiler fuses a multiply add
+
+	//outDistancesSq[ i ] = 2d distance squared from inPoint to ( inXs[ i ], inYs[ i ] )
+	void DistanceSq2DBatch( const Vector3& inPoint, const float* inXs, const float* inYs, uint32_t inCount, float* outDistancesSq );
+
+	//zero length vectors stay zero instead of turning into nans
+	void Normalize2DBatch( float* ioXs, float* ioYs, uint32_t inCount );
+	void NormalizeBatch( float* ioXs, float* ioYs, float* ioZs, uint32_t inCount );
+
+#if ROBOMATH_USE_SIMD
+	//just enough four wide math for the batch functions, on whichever instruction set we have
+	namespace Simd
+	{
+	#if ROBOMATH_USE_SSE
+		typedef __m128		Float4;
+		typedef __m128		Mask4;
+
+		inline Float4	Load( const float* inData )					{ return _mm_loadu_ps( inData ); }
+		inline void		Store( float* outData, Float4 inValue )		{ _mm_storeu_ps( outData, inValue ); }
+		inline Float4	Splat( float inValue )						{ return _mm_set1_ps( inValue ); }
+		inline Float4	Add( Float4 inA, Float4 inB )				{ return _mm_add_ps( inA, inB ); }
+		inline Float4	Subtract( Float4 inA, Float4 inB )			{ return _mm_sub_ps( inA, inB ); }
+		inline Float4	Multiply( Float4 inA, Float4 inB )			{ return _mm_mul_ps( inA, inB ); }
+		inline Float4	Divide( Float4 inA, Float4 inB )			{ return _mm_div_ps( inA, inB ); }
+		inline Float4	Sqrt( Float4 inA )							{ return _mm_sqrt_ps( inA ); }
+		inline Mask4	GreaterThan( Float4 inA, Float4 inB )		{ return _mm_cmpgt_ps( inA, inB ); }
+		//lanes where inMask is set come from inIfSet, the rest from inIfClear
+		inline Float4	Select( Mask4 inMask, Float4 inIfSet, Float4 inIfClear )	{ return _mm_or_ps( _mm_and_ps( inMask, inIfSet ), _mm_andnot_ps( inMask, inIfClear ) ); }
+	#else
+		typedef float32x4_t	Float4;
+		typedef uint32x4_t	Mask4;
+
+		inline Float4	Load( const float* inData )					{ return vld1q_f32( inData ); }
+		inline void		Store( float* outData, Float4 inValue )		{ vst1q_f32( outData, inValue ); }
+		inline Float4	Splat( float inValue )						{ return vdupq_n_f32( inValue ); }
+		inline Float4	Add( Float4 inA, Float4 inB )				{ return vaddq_f32( inA, inB ); }
+		inline Float4	Subtract( Float4 inA, Float4 inB )			{ return vsubq_f32( inA, inB ); }
+		inline Float4	Multiply( Float4 inA, Float4 inB )			{ return vmulq_f32( inA, inB ); }
+		inline Float4	Divide( Float4 inA, Float4 inB )			{ return vdivq_f32( inA, inB ); }
+		inline Float4	Sqrt( Float4 inA )							{ return vsqrtq_f32( inA ); }
+		inline Mask4	GreaterThan( Float4 inA, Float4 inB )		{ return vcgtq_f32( inA, inB ); }
+		inline Float4	Select( Mask4 inMask, Float4 inIfSet, Float4 inIfClear )	{ return vbslq_f32( inMask, inIfSet, inIfClear ); }
+	#endif
+	}
+#endif
 }
 
 namespace Colors
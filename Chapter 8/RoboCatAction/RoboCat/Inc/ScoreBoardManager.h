@@ -2,8 +2,11 @@ class ScoreBoardManager
 {
 public:
 
+	//like the world- one for the program, or one per match on the server, with this pointing at the thread's
 	static void StaticInit();
-	static std::unique_ptr< ScoreBoardManager >	sInstance;
+	static ROBOCAT_THREAD_LOCAL ScoreBoardManager*	sInstance;
+
+	ScoreBoardManager();
 
 	class Entry
 	{
@@ -37,6 +40,7 @@ public:
 	Entry*	GetEntry( uint32_t inPlayerId );
 	bool	RemoveEntry( uint32_t inPlayerId );
 	void	AddEntry( uint32_t inPlayerId, const string& inPlayerName );
+	void	AddEntry( uint32_t inPlayerId, const string& inPlayerName, const Vector3& inColor );
 	void	IncScore( uint32_t inPlayerId, int inAmount );
 
 	bool	Write( OutputMemoryBitStream& inOutputStream ) const;
@@ -46,8 +50,6 @@ public:
 
 private:
 
-	ScoreBoardManager();
-
 	vector< Entry >	mEntries;
 
 	vector< Vector3 >	mDefaultColors;
@@ -0,0 +1,90 @@
+//a scheduled timer, safe to hold onto after it's fired or been cancelled- it just stops being scheduled
+class TimerHandle
+{
+public:
+
+	TimerHandle() : mIndex( 0 ), mGeneration( 0 ) {}
+
+	bool	IsNull()	const	{ return mGeneration == 0; }
+
+private:
+
+	friend class TimerWheel;
+
+	TimerHandle( uint32_t inIndex, uint32_t inGeneration ) : mIndex( inIndex ), mGeneration( inGeneration ) {}
+
+	uint32_t	mIndex;
+	uint32_t	mGeneration;
+};
+
+/*
+* hierarchical timer wheel. time is cut into ticks, and a timer sits in the slot for the tick it's due in.
+* the first wheel has a slot per tick for the next second or so, and each wheel after that has slots 64 times as wide,
+* which get poured down into the finer wheels as their time comes up. advancing only visits the slots being passed and what's in them,
+* so a frame costs the same with ten timers waiting or ten thousand- it's the ones going off that cost.
+* timers never fire early, and fire up to a tick late
+*/
+class TimerWheel
+{
+public:
+
+	typedef std::function< void() > Callback;
+
+	//like the world- one for the program, or one per match on the server, with this pointing at the thread's
+	static void StaticInit();
+
+	static ROBOCAT_THREAD_LOCAL TimerWheel*	sInstance;
+
+	TimerWheel();
+
+	//callbacks can schedule and cancel timers themselves. capture small things- handles, ids, raw pointers- and it won't touch the heap
+	TimerHandle	ScheduleAt( float inTime, const Callback& inCallback );
+	//relative to the start of the current frame
+	TimerHandle	Schedule( float inDelay, const Callback& inCallback );
+
+	//returns false if it had already fired or been cancelled
+	bool		Cancel( TimerHandle inHandle );
+	bool		IsScheduled( TimerHandle inHandle )	const;
+
+	//fires everything due by inTime, a tick at a time
+	void		Advance( float inTime );
+
+	uint32_t	GetScheduledCount()					const	{ return mScheduledCount; }
+
+private:
+
+	struct Timer
+	{
+		Timer() : mDueTick( 0 ), mGeneration( 1 ), mSlot( 0 ), mNext( 0 ), mPrevious( 0 ), mIsScheduled( false ) {}
+
+		Callback	mCallback;
+		uint64_t	mDueTick;
+		//bumped whenever the timer fires or is cancelled, so old handles stop matching
+		uint32_t	mGeneration;
+		uint32_t	mSlot;
+		uint32_t	mNext;
+		uint32_t	mPrevious;
+		bool		mIsScheduled;
+	};
+
+	static const uint32_t	kSlotBits = 6;
+	static const uint32_t	kSlotCount = 1 << kSlotBits;
+	static const uint32_t	kLevelCount = 4;
+
+	//puts the timer in the slot for its due tick, on the finest wheel that reaches that far
+	void		Insert( uint32_t inIndex );
+	void		Unlink( uint32_t inIndex );
+	void		Release( uint32_t inIndex );
+
+	void		Cascade( uint32_t inLevel );
+	void		FireDueTimers();
+
+	vector< Timer >		mTimers;
+	vector< uint32_t >	mFreeIndices;
+
+	//first timer in each slot, wheel by wheel
+	uint32_t			mSlotHeads[ kLevelCount * kSlotCount ];
+
+	uint64_t			mCurrentTick;
+	uint32_t			mScheduledCount;
+};
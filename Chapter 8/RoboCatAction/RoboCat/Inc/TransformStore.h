@@ -0,0 +1,92 @@
+/*
+* locations, rotations, scales, collision radii and velocities for every game object, each in its own tightly packed array.
+* objects only hold an index in here. anything given a velocity gets moved in one vectorized pass per frame,
+* so simple movers like yarn don't need an update of their own. things that move themselves- cats, say- leave their velocity here at zero
+*/
+class TransformStore
+{
+public:
+
+	//room for this many objects before any array has to grow
+	void		Reserve( uint32_t inCapacity );
+
+	uint32_t	Add( GameObject* inOwner );
+	//the last entry moves into the hole, and its owner is told its new index
+	void		Remove( uint32_t inIndex );
+
+	Vector3		GetLocation( uint32_t inIndex )		const	{ return Vector3( mLocationX[ inIndex ], mLocationY[ inIndex ], mLocationZ[ inIndex ] ); }
+	void		SetLocation( uint32_t inIndex, const Vector3& inLocation )
+	{
+		mLocationX[ inIndex ] = inLocation.mX;
+		mLocationY[ inIndex ] = inLocation.mY;
+		mLocationZ[ inIndex ] = inLocation.mZ;
+	}
+
+	Vector3		GetVelocity( uint32_t inIndex )		const	{ return Vector3( mVelocityX[ inIndex ], mVelocityY[ inIndex ], mVelocityZ[ inIndex ] ); }
+	void		SetVelocity( uint32_t inIndex, const Vector3& inVelocity )
+	{
+		mVelocityX[ inIndex ] = inVelocity.mX;
+		mVelocityY[ inIndex ] = inVelocity.mY;
+		mVelocityZ[ inIndex ] = inVelocity.mZ;
+	}
+
+	float		GetRotation( uint32_t inIndex )		const	{ return mRotation[ inIndex ]; }
+	void		SetRotation( uint32_t inIndex, float inRotation )	{ mRotation[ inIndex ] = inRotation; }
+
+	float		GetScale( uint32_t inIndex )		const	{ return mScale[ inIndex ]; }
+	void		SetScale( uint32_t inIndex, float inScale )			{ mScale[ inIndex ] = inScale; }
+
+	float		GetCollisionRadius( uint32_t inIndex )	const	{ return mCollisionRadius[ inIndex ]; }
+	void		SetCollisionRadius( uint32_t inIndex, float inRadius )	{ mCollisionRadius[ inIndex ] = inRadius; }
+
+	GameObject*	GetOwner( uint32_t inIndex )		const	{ return mOwners[ inIndex ]; }
+	uint32_t	GetCount()							const	{ return static_cast< uint32_t >( mOwners.size() ); }
+
+	//raw arrays for batch math. adding an object can move them, so don't hold onto these across one
+	const float*	GetLocationXs()					const	{ return mLocationX.data(); }
+	const float*	GetLocationYs()					const	{ return mLocationY.data(); }
+
+	//location += velocity * inDeltaTime, for everything at once
+	void		Integrate( float inDeltaTime );
+
+	//a copy of where everything was and how it was moving as the frame started. things updating side by side look at this
+	//instead of each other's live transforms, so it can't matter who got there first. it holds handles rather than indices into
+	//the live arrays, so it stays safe to read after objects come and go- it just doesn't know about them till the next capture
+	void		CaptureFrameStart();
+
+	uint32_t		GetFrameStartCount()						const	{ return static_cast< uint32_t >( mFrameStartEntries.size() ); }
+	const float*	GetFrameStartLocationXs()					const	{ return mFrameStartLocationX.data(); }
+	const float*	GetFrameStartLocationYs()					const	{ return mFrameStartLocationY.data(); }
+	Vector3			GetFrameStartLocation( uint32_t inIndex )	const	{ return Vector3( mFrameStartLocationX[ inIndex ], mFrameStartLocationY[ inIndex ], 0.f ); }
+
+	struct FrameStartEntry
+	{
+		//cats move themselves, so this is the cat's own velocity rather than the integrated one
+		Vector3				mVelocity;
+		float				mCollisionRadius;
+		GameObjectHandle	mHandle;
+		bool				mIsCat;
+		bool				mDoesWantToDie;
+	};
+
+	const FrameStartEntry&	GetFrameStartEntry( uint32_t inIndex )	const	{ return mFrameStartEntries[ inIndex ]; }
+
+private:
+
+	vector< float >			mLocationX;
+	vector< float >			mLocationY;
+	vector< float >			mLocationZ;
+	vector< float >			mVelocityX;
+	vector< float >			mVelocityY;
+	vector< float >			mVelocityZ;
+	vector< float >			mRotation;
+	vector< float >			mScale;
+	vector< float >			mCollisionRadius;
+
+	vector< GameObject* >	mOwners;
+
+	//the batch distance pass only wants the locations, so they're kept apart from the rest
+	vector< float >				mFrameStartLocationX;
+	vector< float >				mFrameStartLocationY;
+	vector< FrameStartEntry >	mFrameStartEntries;
+};
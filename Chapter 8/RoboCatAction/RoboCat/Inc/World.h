@@ -8,24 +8,29 @@ class World
 
 public:
 
+	//the program's one world, owned till exit. the server's matches make their own instead
 	static void StaticInit();
 
-	static std::unique_ptr< World >		sInstance;
+	//the world this thread's working in- set by StaticInit and by entering a JobContext, and null on a thread that's done neither
+	static ROBOCAT_THREAD_LOCAL World*	sInstance;
+
+	World();
 
 	void AddGameObject( GameObjectPtr inGameObject );
-	void RemoveGameObject( GameObjectPtr inGameObject );
+	void RemoveGameObject( GameObject* inGameObject );
 
 	void Update();
 
 	const std::vector< GameObjectPtr >&	GetGameObjects()	const	{ return mGameObjects; }
 
-private:
-
+	TransformStore&						GetTransformStore()			{ return mTransformStore; }
 
-	World();
+private:
 
 	int	GetIndexOfGameObject( GameObjectPtr inGameObject );
 
+	//declared first so it outlives the objects, which give their transforms back as they're destroyed
+	TransformStore					mTransformStore;
 	std::vector< GameObjectPtr >	mGameObjects;
 
 
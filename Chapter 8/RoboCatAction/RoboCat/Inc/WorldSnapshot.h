@@ -0,0 +1,86 @@
+//one game object, flattened. every class writes the same fixed size record and ignores what it doesn't use
+struct GameObjectSnapshotRecord
+{
+	uint32_t	mClassId;
+	int32_t		mNetworkId;
+	Vector3		mLocation;
+	Vector3		mColor;
+	Vector3		mVelocity;
+	float		mRotation;
+	float		mScale;
+	float		mCollisionRadius;
+	uint32_t	mPlayerId;
+	int32_t		mHealth;
+};
+
+struct ScoreBoardSnapshotRecord
+{
+	//longer names get truncated- there's always room for the terminator
+	static const uint32_t kMaxNameLength = 43;
+
+	uint32_t	mPlayerId;
+	int32_t		mScore;
+	Vector3		mColor;
+	char		mName[ kMaxNameLength + 1 ];
+};
+
+
+/*
+* flat, versioned image of the world and scoreboard. records are plain data at fixed offsets,
+* so loading is a single map of the file and the records are used in place- nothing gets parsed.
+* files are in native byte order, and one from a machine of the other endianness is rejected rather than swapped
+*/
+class WorldSnapshot
+{
+public:
+
+	static const uint32_t	kMagic = 'RCWS';
+	static const uint32_t	kVersion = 1;
+
+	struct Header
+	{
+		uint32_t	mMagic;
+		uint32_t	mVersion;
+		//sizes are stored so a mismatched build fails the header check instead of reading garbage
+		uint32_t	mHeaderSize;
+		uint32_t	mObjectRecordSize;
+		uint32_t	mScoreBoardRecordSize;
+		uint32_t	mObjectCount;
+		uint32_t	mScoreBoardEntryCount;
+		//where id allocation was up to, so nothing handed out after a restore collides with a saved id
+		int32_t		mNewNetworkId;
+		int32_t		mNewPlayerId;
+	};
+
+	WorldSnapshot();
+	~WorldSnapshot();
+
+	//writes every live game object and the scoreboard. goes through a temp file so a crash mid save leaves the last snapshot intact
+	static bool	Save( const string& inPath, int inNewNetworkId, int inNewPlayerId );
+
+	//maps the file read only- the header and records stay valid until Close
+	bool	Open( const string& inPath );
+	void	Close();
+
+	const Header&						GetHeader()				const	{ return *reinterpret_cast< const Header* >( mData ); }
+	const GameObjectSnapshotRecord*		GetObjectRecords()		const	{ return reinterpret_cast< const GameObjectSnapshotRecord* >( mData + GetHeader().mHeaderSize ); }
+	const ScoreBoardSnapshotRecord*		GetScoreBoardRecords()	const	{ return reinterpret_cast< const ScoreBoardSnapshotRecord* >( GetObjectRecords() + GetHeader().mObjectCount ); }
+
+	void	RestoreScoreBoard() const;
+
+private:
+
+	//no copying- we own the mapping
+	WorldSnapshot( const WorldSnapshot& );
+	WorldSnapshot& operator=( const WorldSnapshot& );
+
+	bool	IsValid( const string& inPath ) const;
+
+	const char*		mData;
+	size_t			mSize;
+
+#if _WIN32
+	HANDLE			mFile;
+	HANDLE			mMapping;
+#endif
+};
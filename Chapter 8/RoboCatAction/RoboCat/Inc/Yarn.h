@@ -19,26 +19,33 @@ public:
 
 	virtual uint32_t	Write( OutputMemoryBitStream& inOutputStream, uint32_t inDirtyState ) const override;
 
-	void			SetVelocity( const Vector3& inVelocity )	{ mVelocity = inVelocity; }
-	const Vector3&	GetVelocity() const					{ return mVelocity; }
+	virtual void		WriteSnapshot( GameObjectSnapshotRecord& outRecord ) const override;
+	virtual void		ReadSnapshot( const GameObjectSnapshotRecord& inRecord ) override;
+
+	//yarn just flies straight, so the world moves it along with every other simple mover
+	void			SetVelocity( const Vector3& inVelocity )	{ SetIntegratedVelocity( inVelocity ); }
+	Vector3			GetVelocity() const					{ return GetIntegratedVelocity(); }
 
 	void		SetPlayerId( int inPlayerId )	{ mPlayerId = inPlayerId; }
 	int			GetPlayerId() const				{ return mPlayerId; }
 
-	void		InitFromShooter( RoboCat* inShooter );
+	//the tick of the move that fired it- with the player id, that's enough for the shooter to match it up with the one they predicted
+	void		SetShotTick( uint32_t inShotTick )	{ mShotTick = inShotTick; }
+	uint32_t	GetShotTick() const					{ return mShotTick; }
 
-	virtual void Update() override;
+	void		InitFromShooter( RoboCat* inShooter );
+	//for when the shooter's moved on since- fires from the pose they had then
+	void		InitFromShooter( RoboCat* inShooter, const Vector3& inLocation, const Vector3& inVelocity, float inRotation );
 
-	virtual bool HandleCollisionWithCat( RoboCat* inCat ) override;
+	virtual void HandleCollisionWithCat( RoboCat* inCat ) override;
 
 protected:
 	Yarn();
 
 
-	Vector3		mVelocity;
-
 	float		mMuzzleSpeed;
 	int			mPlayerId;
+	uint32_t	mShotTick;
 
 };
 
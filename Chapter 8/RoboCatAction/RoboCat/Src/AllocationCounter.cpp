@@ -0,0 +1,123 @@
+#include "RoboCatPCH.h"
+#include <new>
+
+namespace
+{
+	const char* kPhaseNames[ EAP_Count ] = { "other", "receive", "simulate", "replicate", "send", "untracked" };
+}
+
+const char* AllocationCounter::GetPhaseName( EAllocationPhase inPhase )
+{
+	return kPhaseNames[ inPhase ];
+}
+
+#if ROBOCAT_COUNT_ALLOCATIONS
+
+namespace
+{
+	struct PhaseCounters
+	{
+		std::atomic< uint64_t >	mAllocationCount;
+		std::atomic< uint64_t >	mByteCount;
+		std::atomic< uint64_t >	mFreeCount;
+	};
+
+	//zero initialized before any constructor runs, so allocations from other statics' constructors are safe to count
+	PhaseCounters				sPhaseCounters[ EAP_Count ];
+	//each thread's own, so a match on one worker can be receiving while another's simulating
+	ROBOCAT_THREAD_LOCAL int	sCurrentPhase = EAP_Other;
+
+	PhaseCounters& GetCurrentCounters()
+	{
+		return sPhaseCounters[ sCurrentPhase ];
+	}
+
+	void* CountedAllocate( size_t inSize )
+	{
+		PhaseCounters& counters = GetCurrentCounters();
+		counters.mAllocationCount.fetch_add( 1, std::memory_order_relaxed );
+		counters.mByteCount.fetch_add( inSize, std::memory_order_relaxed );
+
+		//new has to hand back something unique even for 0 bytes
+		void* block = malloc( inSize > 0 ? inSize : 1 );
+		if( !block )
+		{
+			throw std::bad_alloc();
+		}
+		return block;
+	}
+
+	void CountedFree( void* inBlock )
+	{
+		if( inBlock )
+		{
+			GetCurrentCounters().mFreeCount.fetch_add( 1, std::memory_order_relaxed );
+			free( inBlock );
+		}
+	}
+}
+
+void* operator new( size_t inSize )						{ return CountedAllocate( inSize ); }
+void* operator new[]( size_t inSize )					{ return CountedAllocate( inSize ); }
+void operator delete( void* inBlock ) throw()			{ CountedFree( inBlock ); }
+void operator delete[]( void* inBlock ) throw()			{ CountedFree( inBlock ); }
+//the sized forms c++14 compilers call- they'd otherwise go to the runtime's delete, which doesn't know our blocks
+void operator delete( void* inBlock, size_t ) throw()		{ CountedFree( inBlock ); }
+void operator delete[]( void* inBlock, size_t ) throw()	{ CountedFree( inBlock ); }
+
+uint64_t AllocationCounter::GetAllocationCount()
+{
+	uint64_t allocationCount = 0;
+	for( int i = 0; i < EAP_Count; ++i )
+	{
+		if( i != EAP_Untracked )
+		{
+			allocationCount += sPhaseCounters[ i ].mAllocationCount.load( std::memory_order_relaxed );
+		}
+	}
+	return allocationCount;
+}
+
+AllocationCounter::Totals AllocationCounter::GetTotals( EAllocationPhase inPhase )
+{
+	const PhaseCounters& counters = sPhaseCounters[ inPhase ];
+
+	Totals totals;
+	totals.mAllocationCount = counters.mAllocationCount.load( std::memory_order_relaxed );
+	totals.mByteCount = counters.mByteCount.load( std::memory_order_relaxed );
+	totals.mFreeCount = counters.mFreeCount.load( std::memory_order_relaxed );
+	return totals;
+}
+
+EAllocationPhase AllocationCounter::GetPhase()
+{
+	return static_cast< EAllocationPhase >( sCurrentPhase );
+}
+
+void AllocationCounter::SetPhase( EAllocationPhase inPhase )
+{
+	sCurrentPhase = inPhase;
+}
+
+#else
+
+uint64_t AllocationCounter::GetAllocationCount()
+{
+	return 0;
+}
+
+AllocationCounter::Totals AllocationCounter::GetTotals( EAllocationPhase )
+{
+	return Totals();
+}
+
+EAllocationPhase AllocationCounter::GetPhase()
+{
+	return EAP_Other;
+}
+
+void AllocationCounter::SetPhase( EAllocationPhase )
+{
+}
+
+#endif
@@ -3,6 +3,9 @@
 namespace
 {
 	const float kDelayBeforeAckTimeout = 0.5f;
+
+	//how much of the way each new round trip moves the average
+	const float kRoundTripTimeSmoothing = 0.1f;
 }
 
 DeliveryNotificationManager::DeliveryNotificationManager( bool inShouldSendAcks, bool inShouldProcessAcks ) :
@@ -13,7 +16,10 @@ mShouldSendAcks( inShouldSendAcks ),
 mShouldProcessAcks( inShouldProcessAcks ),
 mDeliveredPacketCount( 0 ),
 mDroppedPacketCount( 0 ),
-mDispatchedPacketCount( 0 )
+mDispatchedPacketCount( 0 ),
+mReceivedPacketCount( 0 ),
+mMissedPacketCount( 0 ),
+mRoundTripTime( 0.f )
 {
 }
 
@@ -21,9 +27,13 @@ mDispatchedPacketCount( 0 )
 //we're going away- log how well we did...
 DeliveryNotificationManager::~DeliveryNotificationManager()
 {
-	LOG( "DNM destructor. Delivery rate %d%%, Drop rate %d%%",
-		( 100 * mDeliveredPacketCount ) / mDispatchedPacketCount,
-		( 100 * mDroppedPacketCount ) / mDispatchedPacketCount );
+	//a client that left before we sent it anything has no rate to speak of
+	if( mDispatchedPacketCount > 0 )
+	{
+		LOG( "DNM destructor. Delivery rate %d%%, Drop rate %d%%",
+			( 100 * mDeliveredPacketCount ) / mDispatchedPacketCount,
+			( 100 * mDroppedPacketCount ) / mDispatchedPacketCount );
+	}
 }
 
 
@@ -79,6 +89,7 @@ bool DeliveryNotificationManager::ProcessSequenceNumber( InputMemoryBitStream& i
 	inInputStream.Read( sequenceNumber );
 	if( sequenceNumber == mNextExpectedSequenceNumber )
 	{
+		++mReceivedPacketCount;
 		mNextExpectedSequenceNumber = sequenceNumber + 1;
 		//is this what we expect? great, let's add an ack to our pending list
 		if( mShouldSendAcks )
@@ -98,6 +109,8 @@ bool DeliveryNotificationManager::ProcessSequenceNumber( InputMemoryBitStream& i
 	else if( sequenceNumber > mNextExpectedSequenceNumber )
 	{
 		//we missed a lot of packets!
+		++mReceivedPacketCount;
+		mMissedPacketCount += static_cast< PacketSequenceNumber >( sequenceNumber - mNextExpectedSequenceNumber );
 		//so our next expected packet comes after this one...
 		mNextExpectedSequenceNumber = sequenceNumber + 1;
 		//we should nack the missing packets..this will happen automatically inside AddPendingAck because
@@ -160,6 +173,11 @@ void DeliveryNotificationManager::ProcessAcks( InputMemoryBitStream& inInputStre
 	}
 }
 
+float DeliveryNotificationManager::GetNextTimeoutTime() const
+{
+	return mInFlightPackets.empty() ? 0.f : mInFlightPackets.front().GetTimeDispatched() + kDelayBeforeAckTimeout;
+}
+
 void DeliveryNotificationManager::ProcessTimedOutPackets()
 {
 	float timeoutTime = Timing::sInstance.GetTimef() - kDelayBeforeAckTimeout;
@@ -194,6 +212,15 @@ void DeliveryNotificationManager::AddPendingAck( PacketSequenceNumber inSequence
 }
 
 
+void DeliveryNotificationManager::RetractLastAck()
+{
+	//it's only ever the packet we just read, so it's always on the end of the last range, if it's not gone out already
+	if( !mPendingAcks.empty() && mPendingAcks.back().RetractIfLast( GetLastReceivedSequenceNumber() ) && mPendingAcks.back().GetCount() == 0 )
+	{
+		mPendingAcks.pop_back();
+	}
+}
+
 void DeliveryNotificationManager::HandlePacketDeliveryFailure( const InFlightPacket& inFlightPacket )
 {
 	++mDroppedPacketCount;
@@ -205,5 +232,10 @@ void DeliveryNotificationManager::HandlePacketDeliveryFailure( const InFlightPac
 void DeliveryNotificationManager::HandlePacketDeliverySuccess( const InFlightPacket& inFlightPacket )
 {
 	++mDeliveredPacketCount;
+
+	//the first one's all we've got, after that each only nudges it
+	float roundTripTime = Timing::sInstance.GetTimef() - inFlightPacket.GetTimeDispatched();
+	mRoundTripTime = mDeliveredPacketCount == 1 ? roundTripTime : mRoundTripTime + ( roundTripTime - mRoundTripTime ) * kRoundTripTimeSmoothing;
+
 	inFlightPacket.HandleDeliverySuccess( this );
 }
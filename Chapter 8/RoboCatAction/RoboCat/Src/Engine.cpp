@@ -4,9 +4,55 @@
 
 std::unique_ptr< Engine >	Engine::sInstance;
 
+#if ROBOCAT_COUNT_ALLOCATIONS
+namespace
+{
+	const float kTimeBetweenHeapAllocationReports = 5.f;
+
+	//enough to see what's going wrong without burying everything else
+	const uint32_t kMaxZeroAllocationFailuresLogged = 10;
+
+	AllocationCounter::Totals Subtract( const AllocationCounter::Totals& inTotals, const AllocationCounter::Totals& inBaseline )
+	{
+		AllocationCounter::Totals difference;
+		difference.mAllocationCount = inTotals.mAllocationCount - inBaseline.mAllocationCount;
+		difference.mByteCount = inTotals.mByteCount - inBaseline.mByteCount;
+		difference.mFreeCount = inTotals.mFreeCount - inBaseline.mFreeCount;
+		return difference;
+	}
+
+	//"receive 2 (96 bytes), send 1 (1500 bytes)"- every phase that allocated
+	string DescribePhases( const AllocationCounter::Totals* inPhaseTotals )
+	{
+		string description;
+		for( int i = 0; i < EAP_Untracked; ++i )
+		{
+			const AllocationCounter::Totals& totals = inPhaseTotals[ i ];
+			if( totals.mAllocationCount > 0 )
+			{
+				description += StringUtils::Sprintf( "%s%s %d (%d bytes)", description.empty() ? "" : ", ",
+					AllocationCounter::GetPhaseName( static_cast< EAllocationPhase >( i ) ),
+					static_cast< int >( totals.mAllocationCount ), static_cast< int >( totals.mByteCount ) );
+			}
+		}
+		return description.empty() ? string( "none" ) : description;
+	}
+}
+#endif
 
 Engine::Engine() :
-mShouldKeepRunning( true )
+mShouldKeepRunning( true ),
+mHeapAllocationCountAtFrameEnd( 0 ),
+mHeapAllocationCountLastFrame( 0 ),
+mMaxHeapAllocationCountSinceReport( 0 ),
+mFrameCountSinceReport( 0 ),
+mHeapAllocationCountAtReport( 0 ),
+mTimeOfLastHeapAllocationReport( 0.f ),
+mIsZeroAllocationEnforced( false ),
+mZeroAllocationFailureCount( 0 ),
+mWorld( nullptr ),
+mScoreBoardManager( nullptr ),
+mTimerWheel( nullptr )
 {
 	SocketUtil::StaticInit();
 
@@ -14,11 +60,23 @@ mShouldKeepRunning( true )
 	
 	GameObjectRegistry::StaticInit();
 
+	EntropyFieldRegistry::StaticInit();
+
+
+	JobSystem::StaticInit( JobSystem::GetDefaultWorkerCount() );
+
+	FrameArena::StaticInit();
 
 	World::StaticInit();
 
 	ScoreBoardManager::StaticInit();
 
+	TimerWheel::StaticInit();
+
+	mWorld = World::sInstance;
+	mScoreBoardManager = ScoreBoardManager::sInstance;
+	mTimerWheel = TimerWheel::sInstance;
+
 	SDL_Init( SDL_INIT_VIDEO | SDL_INIT_AUDIO );
 }
 
@@ -32,9 +90,32 @@ Engine::~Engine()
 
 
 
+void Engine::Enter()
+{
+	World::sInstance = mWorld;
+	ScoreBoardManager::sInstance = mScoreBoardManager;
+	TimerWheel::sInstance = mTimerWheel;
+}
+
+void Engine::Leave()
+{
+	World::sInstance = nullptr;
+	ScoreBoardManager::sInstance = nullptr;
+	TimerWheel::sInstance = nullptr;
+}
+
 int Engine::Run()
 {
-	return DoRunLoop();
+	int result;
+	{
+		JobContextScope contextScope( this );
+		result = DoRunLoop();
+	}
+
+	//join the workers now- by the time the engine itself is destroyed at exit, the job system's static may already be gone
+	JobSystem::sInstance.reset();
+
+	return result;
 }
 
 void Engine::HandleEvent( SDL_Event* inEvent )
@@ -43,6 +124,24 @@ void Engine::HandleEvent( SDL_Event* inEvent )
 	( void )inEvent;
 }
 
+void Engine::BeginFrames()
+{
+	mHeapAllocationCountAtFrameEnd = mHeapAllocationCountAtReport = AllocationCounter::GetAllocationCount();
+	for( int i = 0; i < EAP_Count; ++i )
+	{
+		mPhaseAllocationsAtFrameEnd[ i ] = mPhaseAllocationsAtReport[ i ] = AllocationCounter::GetTotals( static_cast< EAllocationPhase >( i ) );
+	}
+}
+
+void Engine::RunFrame()
+{
+	Timing::sInstance.Update();
+
+	DoFrame();
+
+	EndFrame();
+}
+
 int Engine::DoRunLoop()
 {
 	// Main message loop
@@ -50,6 +149,8 @@ int Engine::DoRunLoop()
 	SDL_Event event;
 	memset( &event, 0, sizeof( SDL_Event ) );
 
+	BeginFrames();
+
 	while( !quit && mShouldKeepRunning )
 	{
 		if( SDL_PollEvent( &event ) )
@@ -65,17 +166,71 @@ int Engine::DoRunLoop()
 		}
 		else
 		{
-			Timing::sInstance.Update();
-
-			DoFrame();
+			RunFrame();
 		}
 	}
 
 	return event.type;
 }
 
+void Engine::EndFrame()
+{
+	FrameArena::sInstance->Reset();
+
+#if ROBOCAT_COUNT_ALLOCATIONS
+	//the bookkeeping and logging below would otherwise land in the next frame's numbers
+	AllocationPhaseScope phaseScope( EAP_Untracked );
+
+	uint64_t heapAllocationCount = AllocationCounter::GetAllocationCount();
+	mHeapAllocationCountLastFrame = static_cast< uint32_t >( heapAllocationCount - mHeapAllocationCountAtFrameEnd );
+	mHeapAllocationCountAtFrameEnd = heapAllocationCount;
+
+	AllocationCounter::Totals phaseTotals[ EAP_Count ];
+	for( int i = 0; i < EAP_Count; ++i )
+	{
+		phaseTotals[ i ] = AllocationCounter::GetTotals( static_cast< EAllocationPhase >( i ) );
+		mPhaseAllocationsLastFrame[ i ] = Subtract( phaseTotals[ i ], mPhaseAllocationsAtFrameEnd[ i ] );
+		mPhaseAllocationsAtFrameEnd[ i ] = phaseTotals[ i ];
+	}
+
+	if( mIsZeroAllocationEnforced && mHeapAllocationCountLastFrame > 0 )
+	{
+		if( ++mZeroAllocationFailureCount <= kMaxZeroAllocationFailuresLogged )
+		{
+			LOG( "Frame made %d heap allocations with zero enforced: %s", mHeapAllocationCountLastFrame, DescribePhases( mPhaseAllocationsLastFrame ).c_str() );
+		}
+	}
+
+	mMaxHeapAllocationCountSinceReport = std::max( mMaxHeapAllocationCountSinceReport, mHeapAllocationCountLastFrame );
+	++mFrameCountSinceReport;
+
+	float time = Timing::sInstance.GetTimef();
+	if( time > mTimeOfLastHeapAllocationReport + kTimeBetweenHeapAllocationReports )
+	{
+		AllocationCounter::Totals phaseAllocationsSinceReport[ EAP_Count ];
+		for( int i = 0; i < EAP_Count; ++i )
+		{
+			phaseAllocationsSinceReport[ i ] = Subtract( phaseTotals[ i ], mPhaseAllocationsAtReport[ i ] );
+			mPhaseAllocationsAtReport[ i ] = phaseTotals[ i ];
+		}
+
+		LOG( "Heap allocations per frame: %.1f average, %d worst, over %d frames. In total by phase: %s",
+			static_cast< float >( heapAllocationCount - mHeapAllocationCountAtReport ) / mFrameCountSinceReport,
+			mMaxHeapAllocationCountSinceReport, mFrameCountSinceReport,
+			DescribePhases( phaseAllocationsSinceReport ).c_str() );
+
+		mHeapAllocationCountAtReport = heapAllocationCount;
+		mMaxHeapAllocationCountSinceReport = 0;
+		mFrameCountSinceReport = 0;
+		mTimeOfLastHeapAllocationReport = time;
+	}
+#endif
+}
+
 void Engine::DoFrame()
 {
+	TimerWheel::sInstance->Advance( Timing::sInstance.GetFrameStartTime() );
+
 	World::sInstance->Update();
 }
 
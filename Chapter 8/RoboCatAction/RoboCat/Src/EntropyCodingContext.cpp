@@ -0,0 +1,390 @@
+#include "RoboCatPCH.h"
+
+std::unique_ptr< EntropyFieldRegistry >	EntropyFieldRegistry::sInstance;
+
+void EntropyFieldRegistry::StaticInit()
+{
+	sInstance.reset( new EntropyFieldRegistry() );
+
+	//has entry flag, network id, action and class id are all heavily skewed
+	sInstance->OptInAllFields( kReplicationHeaderClassId );
+
+	//these have to match what each class's Write actually writes- a vector is three fields
+	sInstance->RegisterState( RoboCat::kClassId, RoboCat::ECRS_PlayerId, 1 );
+	sInstance->RegisterState( RoboCat::kClassId, RoboCat::ECRS_Pose, 5 );
+	sInstance->RegisterState( RoboCat::kClassId, 0, 1 );
+	sInstance->RegisterState( RoboCat::kClassId, RoboCat::ECRS_Color, 3 );
+	sInstance->RegisterState( RoboCat::kClassId, RoboCat::ECRS_Health, 1 );
+	sInstance->OptInAllFields( RoboCat::kClassId );
+
+	sInstance->RegisterState( Mouse::kClassId, Mouse::EMRS_Pose, 3 );
+	sInstance->RegisterState( Mouse::kClassId, Mouse::EMRS_Color, 3 );
+	sInstance->OptInAllFields( Mouse::kClassId );
+
+	sInstance->RegisterState( Yarn::kClassId, Yarn::EYRS_Pose, 5 );
+	sInstance->RegisterState( Yarn::kClassId, Yarn::EYRS_Color, 3 );
+	sInstance->RegisterState( Yarn::kClassId, Yarn::EYRS_PlayerId, 2 );
+	sInstance->OptInAllFields( Yarn::kClassId );
+}
+
+EntropyFieldRegistry::EntropyFieldRegistry() :
+	mModelCount( 0 )
+{
+}
+
+uint32_t EntropyFieldRegistry::GetFieldIndex( uint32_t inStateIndex, uint32_t inSubFieldIndex )
+{
+	assert( inStateIndex < kMaxStatesPerClass && inSubFieldIndex < kMaxFieldsPerState );
+	return inStateIndex * kMaxFieldsPerState + inSubFieldIndex;
+}
+
+void EntropyFieldRegistry::RegisterState( uint32_t inClassId, uint32_t inStateBit, uint32_t inFieldCount )
+{
+	ClassFields& classFields = mClassIdToFields[ inClassId ];
+
+	//one bit each, and no state twice
+	assert( ( inStateBit & ( inStateBit - 1 ) ) == 0 && ( classFields.mRegisteredStateBits & inStateBit ) == 0 );
+	assert( classFields.mStateCount < kMaxStatesPerClass && inFieldCount < kMaxFieldsPerState );
+
+	classFields.mRegisteredStateBits |= inStateBit;
+	classFields.mStateFieldCounts[ classFields.mStateCount++ ] = inFieldCount;
+}
+
+void EntropyFieldRegistry::OptInField( uint32_t inClassId, uint32_t inFieldIndex )
+{
+	assert( inFieldIndex < kMaxFieldsPerClass );
+
+	int& modelIndex = mClassIdToFields[ inClassId ].mModelIndices[ inFieldIndex ];
+	if( modelIndex < 0 )
+	{
+		modelIndex = mModelCount++;
+	}
+}
+
+void EntropyFieldRegistry::OptInAllFields( uint32_t inClassId )
+{
+	for( uint32_t i = 0; i < kMaxFieldsPerClass; ++i )
+	{
+		OptInField( inClassId, i );
+	}
+}
+
+const EntropyFieldRegistry::ClassFields* EntropyFieldRegistry::GetClassFields( uint32_t inClassId ) const
+{
+	auto it = mClassIdToFields.find( inClassId );
+	return it != mClassIdToFields.end() ? &it->second : nullptr;
+}
+
+
+EntropyCodingContext::EntropyCodingContext() :
+	mBaseline( kInitialBaseline ),
+	mCurrentRecord( nullptr ),
+	mClassFields( nullptr ),
+	mStateIndex( 0 ),
+	mFieldIndex( 0 ),
+	mStateFieldEnd( 0 ),
+	mIsAtStateFlag( false )
+{
+	ResetModels();
+}
+
+void EntropyCodingContext::ResetModels()
+{
+	//registrations are done at startup, but size from the registry here in case any came late
+	mProbabilities.assign( EntropyFieldRegistry::sInstance->GetModelCount() * kModelSize, RangeCoder::kProbabilityInitial );
+}
+
+void EntropyCodingContext::BeginEncoding( OutputMemoryBitStream& inOutputStream, InFlightPacket* inFlightPacket )
+{
+	PacketSequenceNumber sequenceNumber = inFlightPacket->GetSequenceNumber();
+
+	uint32_t baselineDelta = 0;
+	if( mBaseline != kInitialBaseline )
+	{
+		baselineDelta = static_cast< PacketSequenceNumber >( sequenceNumber - mBaseline );
+		if( baselineDelta >= kRecordCount )
+		{
+			//nothing's been ack'd in a long time- the receiver may not have the records to catch up, so start over
+			ResetModels();
+			mBaseline = kInitialBaseline;
+			baselineDelta = 0;
+		}
+	}
+	inOutputStream.Write( baselineDelta, kBaselineDeltaBits );
+
+	StartRecord( sequenceNumber );
+	inFlightPacket->SetTransmissionData( 'ENTC', TransmissionDataPtr( new EntropyTransmissionData( this, sequenceNumber ) ) );
+
+	mEncoder.Begin( inOutputStream );
+	inOutputStream.SetEntropyCodingContext( this );
+}
+
+void EntropyCodingContext::EndEncoding( OutputMemoryBitStream& inOutputStream )
+{
+	inOutputStream.SetEntropyCodingContext( nullptr );
+	mEncoder.End();
+
+	mCurrentRecord->mIsValid = true;
+	mCurrentRecord = nullptr;
+	UndoPacketAdaptation();
+}
+
+void EntropyCodingContext::HandlePacketDelivered( PacketSequenceNumber inSequenceNumber )
+{
+	//only packets coded against our current baseline can extend it- anything older was coded against models we've moved past
+	PacketRecord& record = mRecords[ inSequenceNumber % kRecordCount ];
+	if( record.mIsValid && record.mSequenceNumber == inSequenceNumber && record.mBaseline == mBaseline )
+	{
+		ApplyRecord( record );
+		mBaseline = inSequenceNumber;
+	}
+}
+
+bool EntropyCodingContext::BeginDecoding( InputMemoryBitStream& inInputStream, PacketSequenceNumber inSequenceNumber )
+{
+	uint32_t baselineDelta = 0;
+	inInputStream.Read( baselineDelta, kBaselineDeltaBits );
+
+	int baseline = baselineDelta == 0 ? kInitialBaseline : static_cast< PacketSequenceNumber >( inSequenceNumber - baselineDelta );
+	if( !SyncToBaseline( baseline ) )
+	{
+		LOG( "Can't rebuild entropy models for baseline %d, dropping packet %d", baseline, inSequenceNumber );
+		return false;
+	}
+
+	StartRecord( inSequenceNumber );
+
+	mDecoder.Begin( inInputStream );
+	inInputStream.SetEntropyCodingContext( this );
+	return true;
+}
+
+void EntropyCodingContext::EndDecoding( InputMemoryBitStream& inInputStream )
+{
+	inInputStream.SetEntropyCodingContext( nullptr );
+	mDecoder.End();
+
+	mCurrentRecord->mIsValid = true;
+	mCurrentRecord = nullptr;
+	UndoPacketAdaptation();
+}
+
+bool EntropyCodingContext::SyncToBaseline( int inBaseline )
+{
+	//walk back through the packets we decoded until we reach models we already have, then replay forward
+	int chain[ kRecordCount ];
+	uint32_t chainLength = 0;
+
+	int baseline = inBaseline;
+	while( baseline != mBaseline && baseline != kInitialBaseline )
+	{
+		const PacketRecord& record = mRecords[ baseline % kRecordCount ];
+		if( !record.mIsValid || record.mSequenceNumber != baseline || chainLength == kRecordCount )
+		{
+			return false;
+		}
+
+		chain[ chainLength++ ] = baseline;
+		baseline = record.mBaseline;
+	}
+
+	if( baseline != mBaseline )
+	{
+		ResetModels();
+	}
+
+	while( chainLength > 0 )
+	{
+		ApplyRecord( mRecords[ chain[ --chainLength ] % kRecordCount ] );
+	}
+
+	mBaseline = inBaseline;
+	return true;
+}
+
+void EntropyCodingContext::StartRecord( PacketSequenceNumber inSequenceNumber )
+{
+	mCurrentRecord = &mRecords[ inSequenceNumber % kRecordCount ];
+	mCurrentRecord->mSequenceNumber = inSequenceNumber;
+	mCurrentRecord->mBaseline = mBaseline;
+	mCurrentRecord->mIsValid = false;
+	mCurrentRecord->mSymbols.clear();
+
+	mClassFields = nullptr;
+}
+
+void EntropyCodingContext::ApplyRecord( const PacketRecord& inRecord )
+{
+	for( const CodedSymbol& symbol : inRecord.mSymbols )
+	{
+		RangeCoderProbability* model = GetModel( symbol.mModelIndex );
+		uint32_t node = 1;
+		for( uint32_t bitCount = symbol.mBitCount; bitCount > 0; )
+		{
+			--bitCount;
+			uint32_t bit = ( symbol.mSymbol >> bitCount ) & 1;
+			RangeCoder::AdaptProbability( model[ node ], bit );
+			node = ( node << 1 ) | bit;
+		}
+	}
+}
+
+void EntropyCodingContext::UndoPacketAdaptation()
+{
+	//backwards, so a probability touched twice ends up with its oldest value
+	for( auto it = mUndoLog.rbegin(), end = mUndoLog.rend(); it != end; ++it )
+	{
+		mProbabilities[ it->first ] = it->second;
+	}
+	mUndoLog.clear();
+}
+
+void EntropyCodingContext::SaveTreePath( RangeCoderProbability* inModel, uint32_t inModelIndex, uint32_t inSymbol, uint32_t inBitCount )
+{
+	uint32_t modelOffset = inModelIndex * kModelSize;
+	uint32_t node = 1;
+	while( inBitCount > 0 )
+	{
+		--inBitCount;
+		mUndoLog.emplace_back( modelOffset + node, inModel[ node ] );
+		node = ( node << 1 ) | ( ( inSymbol >> inBitCount ) & 1 );
+	}
+}
+
+void EntropyCodingContext::BeginObject( uint32_t inClassId )
+{
+	mClassFields = EntropyFieldRegistry::sInstance->GetClassFields( inClassId );
+	if( mClassFields && mClassFields->mStateCount > 0 )
+	{
+		BeginState( 0 );
+	}
+	else
+	{
+		//no states, so the whole thing's one run of fields
+		mStateIndex = 0;
+		mFieldIndex = 0;
+		mStateFieldEnd = EntropyFieldRegistry::kMaxFieldsPerClass;
+		mIsAtStateFlag = false;
+	}
+}
+
+void EntropyCodingContext::BeginState( uint32_t inStateIndex )
+{
+	mStateIndex = inStateIndex;
+	mFieldIndex = EntropyFieldRegistry::GetFieldIndex( inStateIndex, 0 );
+	mStateFieldEnd = mFieldIndex + 1;
+	mIsAtStateFlag = true;
+}
+
+int EntropyCodingContext::GetCurrentFieldModelIndex() const
+{
+	return mClassFields && mFieldIndex < mStateFieldEnd ? mClassFields->mModelIndices[ mFieldIndex ] : -1;
+}
+
+void EntropyCodingContext::AdvanceField( uint32_t inSymbol )
+{
+	if( !mClassFields )
+	{
+		return;
+	}
+
+	if( mIsAtStateFlag )
+	{
+		mIsAtStateFlag = false;
+		if( inSymbol != 0 )
+		{
+			mStateFieldEnd += mClassFields->mStateFieldCounts[ mStateIndex ];
+		}
+	}
+
+	if( ++mFieldIndex < mStateFieldEnd )
+	{
+		return;
+	}
+
+	if( mStateIndex + 1 < mClassFields->mStateCount )
+	{
+		BeginState( mStateIndex + 1 );
+	}
+	else
+	{
+		mClassFields = nullptr;
+	}
+}
+
+void EntropyCodingContext::EncodeBits( const void* inData, uint32_t inBitCount )
+{
+	if( inBitCount == 0 )
+	{
+		return;
+	}
+
+	const uint8_t* srcByte = static_cast< const uint8_t* >( inData );
+	int modelIndex = GetCurrentFieldModelIndex();
+
+	//only the final, most significant chunk gets a model- low order bytes of wide fields are close to noise anyway
+	uint32_t leadingByteCount = ( inBitCount - 1 ) >> 3;
+	for( uint32_t i = 0; i < leadingByteCount; ++i )
+	{
+		mEncoder.EncodeDirectBits( srcByte[ i ], 8 );
+	}
+
+	uint32_t finalBitCount = inBitCount - ( leadingByteCount << 3 );
+	uint32_t symbol = srcByte[ leadingByteCount ] & ( ( 1 << finalBitCount ) - 1 );
+	if( modelIndex >= 0 )
+	{
+		RangeCoderProbability* model = GetModel( modelIndex );
+		SaveTreePath( model, modelIndex, symbol, finalBitCount );
+		mEncoder.EncodeBitTree( model, symbol, finalBitCount );
+		mCurrentRecord->mSymbols.emplace_back( modelIndex, static_cast< uint8_t >( symbol ), static_cast< uint8_t >( finalBitCount ) );
+	}
+	else
+	{
+		mEncoder.EncodeDirectBits( symbol, finalBitCount );
+	}
+
+	AdvanceField( symbol );
+}
+
+void EntropyCodingContext::DecodeBits( void* outData, uint32_t inBitCount )
+{
+	if( inBitCount == 0 )
+	{
+		return;
+	}
+
+	uint8_t* destByte = static_cast< uint8_t* >( outData );
+	int modelIndex = GetCurrentFieldModelIndex();
+
+	uint32_t leadingByteCount = ( inBitCount - 1 ) >> 3;
+	for( uint32_t i = 0; i < leadingByteCount; ++i )
+	{
+		destByte[ i ] = static_cast< uint8_t >( mDecoder.DecodeDirectBits( 8 ) );
+	}
+
+	uint32_t finalBitCount = inBitCount - ( leadingByteCount << 3 );
+	uint32_t symbol;
+	if( modelIndex >= 0 )
+	{
+		//the path isn't known until it's decoded, so walk the tree here and save each node before it adapts
+		RangeCoderProbability* model = GetModel( modelIndex );
+		uint32_t modelOffset = modelIndex * kModelSize;
+		uint32_t node = 1;
+		for( uint32_t i = 0; i < finalBitCount; ++i )
+		{
+			mUndoLog.emplace_back( modelOffset + node, model[ node ] );
+			node = ( node << 1 ) | mDecoder.DecodeBit( model[ node ] );
+		}
+		symbol = node - ( 1 << finalBitCount );
+
+		mCurrentRecord->mSymbols.emplace_back( modelIndex, static_cast< uint8_t >( symbol ), static_cast< uint8_t >( finalBitCount ) );
+	}
+	else
+	{
+		symbol = mDecoder.DecodeDirectBits( finalBitCount );
+	}
+
+	destByte[ leadingByteCount ] = static_cast< uint8_t >( symbol );
+
+	AdvanceField( symbol );
+}
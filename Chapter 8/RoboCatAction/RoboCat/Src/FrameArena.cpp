@@ -0,0 +1,70 @@
+#include "RoboCatPCH.h"
+
+namespace
+{
+	//plenty for a frame's worth of bookkeeping- it grows if a frame ever needs more
+	const size_t kInitialCapacity = 64 * 1024;
+}
+
+std::unique_ptr< FrameArena >	FrameArena::sInstance;
+
+void FrameArena::StaticInit()
+{
+	sInstance.reset( new FrameArena( kInitialCapacity ) );
+}
+
+FrameArena::FrameArena( size_t inCapacity ) :
+	mBuffer( static_cast< char* >( malloc( inCapacity ) ) ),
+	mCapacity( inCapacity ),
+	mOffset( 0 ),
+	mOverflowByteCount( 0 )
+{
+}
+
+FrameArena::~FrameArena()
+{
+	Reset();
+	free( mBuffer );
+}
+
+void* FrameArena::Allocate( size_t inSize, size_t inAlignment )
+{
+	//alignments are powers of 2, so rounding up is a mask
+	size_t alignedOffset = ( mOffset + inAlignment - 1 ) & ~( inAlignment - 1 );
+	if( alignedOffset + inSize <= mCapacity )
+	{
+		mOffset = alignedOffset + inSize;
+		return mBuffer + alignedOffset;
+	}
+
+	//too big for what's left, so this one comes off the heap. malloc's alignment covers anything we put in here
+	void* block = malloc( inSize );
+	mOverflowBlocks.push_back( block );
+	mOverflowByteCount += inSize;
+	return block;
+}
+
+void FrameArena::Reset()
+{
+	if( !mOverflowBlocks.empty() )
+	{
+		for( void* block : mOverflowBlocks )
+		{
+			free( block );
+		}
+		mOverflowBlocks.clear();
+
+		//grow to fit the whole of this frame with room to spare, so we don't go through this every frame
+		size_t neededCapacity = ( mOffset + mOverflowByteCount ) * 2;
+		if( neededCapacity > mCapacity )
+		{
+			LOG( "Frame arena overflowed by %d bytes, growing to %d", static_cast< int >( mOverflowByteCount ), static_cast< int >( neededCapacity ) );
+			free( mBuffer );
+			mBuffer = static_cast< char* >( malloc( neededCapacity ) );
+			mCapacity = neededCapacity;
+		}
+		mOverflowByteCount = 0;
+	}
+
+	mOffset = 0;
+}
@@ -1,14 +1,21 @@
 #include<RoboCatPCH.h>
 
 GameObject::GameObject() :
+	mTransformStore( &World::sInstance->GetTransformStore() ),
 	mIndexInWorld( -1 ),
-	mCollisionRadius( 0.5f ),
 	mDoesWantToDie( false ),
-	mRotation( 0.f ),
 	mNetworkId( 0 ),
-	mColor( Colors::White ),
-	mScale( 1.0f )
+	mColor( Colors::White )
 {
+	//the store starts us at the origin with no rotation, unit scale, a 0.5 collision radius and no velocity
+	mTransformIndex = mTransformStore->Add( this );
+	mHandle = GameObjectHandleTable::Get().Acquire( this );
+}
+
+GameObject::~GameObject()
+{
+	GameObjectHandleTable::Get().Release( mHandle );
+	mTransformStore->Remove( mTransformIndex );
 }
 
 void GameObject::Update()
@@ -20,7 +27,8 @@ void GameObject::Update()
 Vector3 GameObject::GetForwardVector()	const
 {
 	//should we cache this when you turn?
-	return Vector3( sinf( mRotation ), -cosf( mRotation ), 0.f );
+	float rotation = GetRotation();
+	return Vector3( sinf( rotation ), -cosf( rotation ), 0.f );
 }
 
 void GameObject::SetNetworkId( int inNetworkId )
@@ -33,5 +41,28 @@ void GameObject::SetNetworkId( int inNetworkId )
 void GameObject::SetRotation( float inRotation )
 { 
 	//should we normalize using fmodf?
-	mRotation = inRotation;
+	mTransformStore->SetRotation( mTransformIndex, inRotation );
+}
+
+void GameObject::WriteSnapshot( GameObjectSnapshotRecord& outRecord ) const
+{
+	outRecord.mClassId = GetClassId();
+	outRecord.mNetworkId = mNetworkId;
+	outRecord.mLocation = GetLocation();
+	outRecord.mColor = mColor;
+	outRecord.mVelocity = Vector3::Zero;
+	outRecord.mRotation = GetRotation();
+	outRecord.mScale = GetScale();
+	outRecord.mCollisionRadius = GetCollisionRadius();
+	outRecord.mPlayerId = 0;
+	outRecord.mHealth = 0;
+}
+
+void GameObject::ReadSnapshot( const GameObjectSnapshotRecord& inRecord )
+{
+	SetLocation( inRecord.mLocation );
+	mColor = inRecord.mColor;
+	SetRotation( inRecord.mRotation );
+	SetScale( inRecord.mScale );
+	SetCollisionRadius( inRecord.mCollisionRadius );
 }
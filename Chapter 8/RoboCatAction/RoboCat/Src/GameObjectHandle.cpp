@@ -0,0 +1,73 @@
+#include "RoboCatPCH.h"
+
+GameObjectHandleTable& GameObjectHandleTable::Get()
+{
+	static GameObjectHandleTable* sInstance = new GameObjectHandleTable();
+	return *sInstance;
+}
+
+GameObjectHandleTable::GameObjectHandleTable() :
+	mSlotCount( 1 )
+{
+	for( Slot*& page : mPages )
+	{
+		page = nullptr;
+	}
+
+	//slot 0 stays empty so a default constructed handle always resolves to nullptr
+	mPages[ 0 ] = new Slot[ kSlotsPerPage ];
+	//a page's worth, so releasing handles doesn't grow the list till there's more than a page of objects
+	mFreeIndices.reserve( kSlotsPerPage );
+}
+
+GameObjectHandle GameObjectHandleTable::Acquire( GameObject* inGameObject )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	uint32_t index;
+	if( !mFreeIndices.empty() )
+	{
+		index = mFreeIndices.back();
+		mFreeIndices.pop_back();
+	}
+	else
+	{
+		index = mSlotCount++;
+		uint32_t pageIndex = index >> kSlotsPerPageShift;
+		assert( pageIndex < kMaxPageCount );
+		if( !mPages[ pageIndex ] )
+		{
+			mPages[ pageIndex ] = new Slot[ kSlotsPerPage ];
+		}
+	}
+
+	Slot& slot = GetSlot( index );
+	uint32_t generation = slot.mGeneration.load( std::memory_order_relaxed ) + 1;
+	if( generation == 0 )
+	{
+		//wrapped- skip 0 so this can't look like a null handle
+		generation = 1;
+	}
+	slot.mGameObject = inGameObject;
+	slot.mGeneration.store( generation, std::memory_order_relaxed );
+
+	return GameObjectHandle( index, generation );
+}
+
+void GameObjectHandleTable::Release( GameObjectHandle inHandle )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	Slot& slot = GetSlot( inHandle.mIndex );
+	assert( slot.mGeneration.load( std::memory_order_relaxed ) == inHandle.mGeneration );
+
+	//bump now rather than on the next acquire, so stale handles fail even while the slot sits free
+	uint32_t generation = inHandle.mGeneration + 1;
+	if( generation == 0 )
+	{
+		generation = 1;
+	}
+	slot.mGeneration.store( generation, std::memory_order_relaxed );
+	slot.mGameObject = nullptr;
+	mFreeIndices.push_back( inHandle.mIndex );
+}
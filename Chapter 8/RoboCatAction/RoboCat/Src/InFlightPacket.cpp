@@ -2,24 +2,53 @@
 
 InFlightPacket::InFlightPacket( PacketSequenceNumber inSequenceNumber ) :
 mSequenceNumber( inSequenceNumber ),
-mTimeDispatched( Timing::sInstance.GetTimef() )
+mTimeDispatched( Timing::sInstance.GetTimef() ),
+mTransmissionDataCount( 0 )
 {
 	//null out other transmision data params...
 }
 
+void InFlightPacket::SetTransmissionData( int inKey, TransmissionDataPtr inTransmissionData )
+{
+	for( int i = 0; i < mTransmissionDataCount; ++i )
+	{
+		if( mTransmissionDataKeys[ i ] == inKey )
+		{
+			mTransmissionData[ i ] = inTransmissionData;
+			return;
+		}
+	}
+
+	assert( mTransmissionDataCount < kMaxTransmissionDataCount );
+	mTransmissionDataKeys[ mTransmissionDataCount ] = inKey;
+	mTransmissionData[ mTransmissionDataCount ] = inTransmissionData;
+	++mTransmissionDataCount;
+}
+
+const TransmissionDataPtr InFlightPacket::GetTransmissionData( int inKey ) const
+{
+	for( int i = 0; i < mTransmissionDataCount; ++i )
+	{
+		if( mTransmissionDataKeys[ i ] == inKey )
+		{
+			return mTransmissionData[ i ];
+		}
+	}
+	return nullptr;
+}
 
 void InFlightPacket::HandleDeliveryFailure( DeliveryNotificationManager* inDeliveryNotificationManager ) const
 {
-	for( const auto& pair : mTransmissionDataMap )
+	for( int i = 0; i < mTransmissionDataCount; ++i )
 	{
-		pair.second->HandleDeliveryFailure( inDeliveryNotificationManager );
+		mTransmissionData[ i ]->HandleDeliveryFailure( inDeliveryNotificationManager );
 	}
 }
 
 void InFlightPacket::HandleDeliverySuccess( DeliveryNotificationManager* inDeliveryNotificationManager ) const
 {
-	for( const auto& pair : mTransmissionDataMap )
+	for( int i = 0; i < mTransmissionDataCount; ++i )
 	{
-		pair.second->HandleDeliverySuccess( inDeliveryNotificationManager );
+		mTransmissionData[ i ]->HandleDeliverySuccess( inDeliveryNotificationManager );
 	}
 }
\ No newline at end of file
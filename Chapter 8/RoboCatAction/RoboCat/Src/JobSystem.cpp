@@ -0,0 +1,238 @@
+#include "RoboCatPCH.h"
+
+std::unique_ptr< JobSystem >	JobSystem::sInstance;
+
+ROBOCAT_THREAD_LOCAL uint32_t	JobSystem::sQueueIndex = 0;
+
+ROBOCAT_THREAD_LOCAL JobContext*	JobContext::sCurrent = nullptr;
+
+JobContext* JobContext::GetCurrent()
+{
+	return sCurrent;
+}
+
+JobContextScope::JobContextScope( JobContext* inContext ) :
+	mContext( inContext ),
+	mPreviousContext( JobContext::sCurrent )
+{
+	if( mContext != mPreviousContext )
+	{
+		if( mPreviousContext )
+		{
+			mPreviousContext->Leave();
+		}
+		JobContext::sCurrent = mContext;
+		if( mContext )
+		{
+			mContext->Enter();
+		}
+	}
+}
+
+JobContextScope::~JobContextScope()
+{
+	if( mContext != mPreviousContext )
+	{
+		if( mContext )
+		{
+			mContext->Leave();
+		}
+		JobContext::sCurrent = mPreviousContext;
+		if( mPreviousContext )
+		{
+			mPreviousContext->Enter();
+		}
+	}
+}
+
+void JobSystem::StaticInit( uint32_t inWorkerCount )
+{
+	sInstance.reset( new JobSystem( inWorkerCount ) );
+}
+
+uint32_t JobSystem::GetDefaultWorkerCount()
+{
+	//hardware_concurrency can come back 0 when it doesn't know
+	uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+	return hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0;
+}
+
+JobSystem::JobSystem( uint32_t inWorkerCount ) :
+	mQueuedJobCount( 0 ),
+	mIsShuttingDown( false )
+{
+	for( uint32_t i = 0; i <= inWorkerCount; ++i )
+	{
+		mQueues.emplace_back( new WorkQueue() );
+	}
+
+	for( uint32_t i = 0; i < inWorkerCount; ++i )
+	{
+		mWorkers.emplace_back( &JobSystem::WorkerLoop, this, i + 1 );
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard< std::mutex > lock( mWakeMutex );
+		mIsShuttingDown = true;
+	}
+	mWakeCondition.notify_all();
+
+	for( std::thread& worker : mWorkers )
+	{
+		worker.join();
+	}
+}
+
+void JobSystem::ParallelFor( uint32_t inCount, uint32_t inGrainSize, const RangeFunction& inFunction )
+{
+	if( inCount == 0 )
+	{
+		return;
+	}
+
+	inGrainSize = std::max( inGrainSize, 1u );
+
+	//not worth waking anyone for a single chunk
+	if( mWorkers.empty() || inCount <= inGrainSize )
+	{
+		inFunction( 0, inCount );
+		return;
+	}
+
+	uint32_t jobCount = ( inCount + inGrainSize - 1 ) / inGrainSize;
+	std::atomic< uint32_t > remainingJobCount( jobCount );
+
+	//deal the chunks round the queues, so everyone starts with a share and only steals once they run dry
+	uint32_t queueCount = static_cast< uint32_t >( mQueues.size() );
+	for( uint32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+	{
+		Job job;
+		job.mFunction = &inFunction;
+		job.mBegin = jobIndex * inGrainSize;
+		job.mEnd = std::min( job.mBegin + inGrainSize, inCount );
+		job.mRemainingJobCount = &remainingJobCount;
+		job.mContext = JobContext::GetCurrent();
+		job.mAllocationPhase = AllocationCounter::GetPhase();
+		Push( ( sQueueIndex + jobIndex ) % queueCount, job );
+	}
+
+	//taking the lock means a worker that's just checked the count is already waiting, so it can't miss this
+	{
+		std::lock_guard< std::mutex > lock( mWakeMutex );
+	}
+	mWakeCondition.notify_all();
+
+	//help out until everything's been picked up, then wait on whatever the workers are still chewing on.
+	//that can mean someone else's jobs too, which is what keeps a worker waiting on its own from stalling the pool
+	Job job;
+	while( remainingJobCount.load() > 0 )
+	{
+		if( FindJob( sQueueIndex, job ) )
+		{
+			RunJob( job );
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::Push( uint32_t inQueueIndex, const Job& inJob )
+{
+	WorkQueue& queue = *mQueues[ inQueueIndex ];
+	std::lock_guard< std::mutex > lock( queue.mMutex );
+
+	uint32_t capacity = static_cast< uint32_t >( queue.mJobs.size() );
+	if( queue.mCount == capacity )
+	{
+		//full, so unroll into a bigger ring
+		vector< Job > jobs( std::max( capacity * 2, 16u ) );
+		for( uint32_t i = 0; i < queue.mCount; ++i )
+		{
+			jobs[ i ] = queue.mJobs[ ( queue.mHead + i ) % capacity ];
+		}
+		queue.mJobs.swap( jobs );
+		queue.mHead = 0;
+		capacity = static_cast< uint32_t >( queue.mJobs.size() );
+	}
+
+	queue.mJobs[ ( queue.mHead + queue.mCount ) % capacity ] = inJob;
+	++queue.mCount;
+	++mQueuedJobCount;
+}
+
+bool JobSystem::PopOwn( uint32_t inQueueIndex, Job& outJob )
+{
+	WorkQueue& queue = *mQueues[ inQueueIndex ];
+	std::lock_guard< std::mutex > lock( queue.mMutex );
+	if( queue.mCount == 0 )
+	{
+		return false;
+	}
+
+	--queue.mCount;
+	outJob = queue.mJobs[ ( queue.mHead + queue.mCount ) % static_cast< uint32_t >( queue.mJobs.size() ) ];
+	--mQueuedJobCount;
+	return true;
+}
+
+bool JobSystem::Steal( uint32_t inThiefIndex, Job& outJob )
+{
+	//start with the next queue along, so thieves don't all pile onto the same victim
+	uint32_t queueCount = static_cast< uint32_t >( mQueues.size() );
+	for( uint32_t offset = 1; offset < queueCount; ++offset )
+	{
+		WorkQueue& queue = *mQueues[ ( inThiefIndex + offset ) % queueCount ];
+		std::lock_guard< std::mutex > lock( queue.mMutex );
+		if( queue.mCount > 0 )
+		{
+			outJob = queue.mJobs[ queue.mHead ];
+			queue.mHead = ( queue.mHead + 1 ) % static_cast< uint32_t >( queue.mJobs.size() );
+			--queue.mCount;
+			--mQueuedJobCount;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool JobSystem::FindJob( uint32_t inQueueIndex, Job& outJob )
+{
+	return PopOwn( inQueueIndex, outJob ) || Steal( inQueueIndex, outJob );
+}
+
+void JobSystem::RunJob( const Job& inJob )
+{
+	JobContextScope contextScope( inJob.mContext );
+	AllocationPhaseScope phaseScope( inJob.mAllocationPhase );
+
+	( *inJob.mFunction )( inJob.mBegin, inJob.mEnd );
+	--( *inJob.mRemainingJobCount );
+}
+
+void JobSystem::WorkerLoop( uint32_t inQueueIndex )
+{
+	sQueueIndex = inQueueIndex;
+
+	for( ;; )
+	{
+		Job job;
+		if( FindJob( inQueueIndex, job ) )
+		{
+			RunJob( job );
+			continue;
+		}
+
+		std::unique_lock< std::mutex > lock( mWakeMutex );
+		mWakeCondition.wait( lock, [ this ]() { return mIsShuttingDown || mQueuedJobCount.load() > 0; } );
+		if( mIsShuttingDown )
+		{
+			return;
+		}
+	}
+}
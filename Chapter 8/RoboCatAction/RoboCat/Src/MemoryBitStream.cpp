@@ -35,6 +35,12 @@ void OutputMemoryBitStream::WriteBits( uint8_t inData,
 
 void OutputMemoryBitStream::WriteBits( const void* inData, uint32_t inBitCount )
 {
+	if( mEntropyCodingContext )
+	{
+		mEntropyCodingContext->EncodeBits( inData, inBitCount );
+		return;
+	}
+
 	const char* srcByte = static_cast< const char* >( inData );
 	//write all the bytes
 	while( inBitCount > 8 )
@@ -50,6 +56,14 @@ void OutputMemoryBitStream::WriteBits( const void* inData, uint32_t inBitCount )
 	}
 }
 
+void OutputMemoryBitStream::BeginEntropyCodedObject( uint32_t inClassId )
+{
+	if( mEntropyCodingContext )
+	{
+		mEntropyCodingContext->BeginObject( inClassId );
+	}
+}
+
 void OutputMemoryBitStream::Write( const Vector3& inVector )
 {
 	Write( inVector.mX );
@@ -129,6 +143,12 @@ void InputMemoryBitStream::ReadBits( uint8_t& outData, uint32_t inBitCount )
 
 void InputMemoryBitStream::ReadBits( void* outData, uint32_t inBitCount )
 {
+	if( mEntropyCodingContext )
+	{
+		mEntropyCodingContext->DecodeBits( outData, inBitCount );
+		return;
+	}
+
 	uint8_t* destByte = reinterpret_cast< uint8_t* >( outData );
 	//write all the bytes
 	while( inBitCount > 8 )
@@ -144,6 +164,14 @@ void InputMemoryBitStream::ReadBits( void* outData, uint32_t inBitCount )
 	}
 }
 
+void InputMemoryBitStream::BeginEntropyCodedObject( uint32_t inClassId )
+{
+	if( mEntropyCodingContext )
+	{
+		mEntropyCodingContext->BeginObject( inClassId );
+	}
+}
+
 void InputMemoryBitStream::Read( Quaternion& outQuat )
 {
 	float precision = ( 2.f / 65535.f );
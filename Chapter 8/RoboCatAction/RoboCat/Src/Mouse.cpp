@@ -7,10 +7,9 @@ Mouse::Mouse()
 }
 
 
-bool Mouse::HandleCollisionWithCat( RoboCat* inCat )
+void Mouse::HandleCollisionWithCat( RoboCat* inCat )
 {
 	( void ) inCat;
-	return false;
 }
 
 
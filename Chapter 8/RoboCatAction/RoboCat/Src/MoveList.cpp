@@ -1,32 +1,70 @@
 #include <RoboCatPCH.h>
 
+namespace
+{
+	//moves are sampled every 30ms or so, so the step to the next one nearly always fits in the short form
+	const uint32_t kShortTickDeltaBitCount = 6;
+	const uint32_t kMaxShortTickDelta = 1 << kShortTickDeltaBitCount;
+
+	//held keys give long runs of the same input. longer runs just get split
+	const uint32_t kRunLengthBitCount = 4;
+	const uint32_t kMaxRunLength = 1 << kRunLengthBitCount;
+
+	//ticks only go up, so the step is at least 1 and gets written less 1
+	void WriteTickDelta( OutputMemoryBitStream& inOutputStream, uint32_t inTickDelta )
+	{
+		bool isShort = inTickDelta <= kMaxShortTickDelta;
+		inOutputStream.Write( isShort );
+		inOutputStream.Write( inTickDelta - 1, isShort ? kShortTickDeltaBitCount : 32 );
+	}
+
+	uint32_t ReadTickDelta( InputMemoryBitStream& inInputStream )
+	{
+		bool isShort;
+		inInputStream.Read( isShort );
+		uint32_t tickDelta = 0;
+		inInputStream.Read( tickDelta, isShort ? kShortTickDeltaBitCount : 32 );
+		return tickDelta + 1;
+	}
+}
+
 const Move& MoveList::AddMove( const InputState& inInputState, float inTimestamp )
 {
+	//two moves in the same tick would look like one- nudge the later one on, it's a millisecond at most
+	uint32_t tick = Move::TimeToTick( inTimestamp );
+	if( mLastMoveTimestamp >= 0.f && tick <= mLastMoveTick )
+	{
+		tick = mLastMoveTick + 1;
+	}
+
 	//first move has 0 time. it's okay, it only happens once
-	float deltaTime = mLastMoveTimestamp >= 0.f ? inTimestamp - mLastMoveTimestamp : 0.f;
+	//worked out from ticks, so the server gets exactly the same time when it adds the move at its end
+	float deltaTime = mLastMoveTimestamp >= 0.f ? Move::TickToTime( tick - mLastMoveTick ) : 0.f;
 
-	mMoves.emplace_back( inInputState, inTimestamp, deltaTime );
+	Move& move = PushMove();
+	move = Move( inInputState, tick, deltaTime );
 
-	mLastMoveTimestamp = inTimestamp;
+	mLastMoveTimestamp = move.GetTimestamp();
+	mLastMoveTick = tick;
 
-	return mMoves.back();
+	return move;
 }
 
-bool MoveList::AddMoveIfNew( const Move& inMove )
+bool MoveList::AddMoveIfNew( const InputState& inInputState, uint32_t inTick )
 {
 	//we might have already received this move in another packet ( since we're sending the same move in multiple packets )
 	//so make sure it's new...
 
 	//adjust the deltatime and then place!
-	float timeStamp = inMove.GetTimestamp();
-
-	if( timeStamp > mLastMoveTimestamp )
+	if( mLastMoveTimestamp < 0.f || inTick > mLastMoveTick )
 	{
-		float deltaTime = mLastMoveTimestamp >= 0.f ? timeStamp - mLastMoveTimestamp : 0.f;
+		float deltaTime = mLastMoveTimestamp >= 0.f ? Move::TickToTime( inTick - mLastMoveTick ) : 0.f;
 
-		mLastMoveTimestamp = timeStamp;
+		Move& move = PushMove();
+		move = Move( inInputState, inTick, deltaTime );
 
-		mMoves.emplace_back( inMove.GetInputState(), timeStamp, deltaTime );
+		mLastMoveTimestamp = move.GetTimestamp();
+		mLastMoveTick = inTick;
 		return true;
 	}
 
@@ -35,8 +73,105 @@ bool MoveList::AddMoveIfNew( const Move& inMove )
 
 void	MoveList::RemovedProcessedMoves( float inLastMoveProcessedOnServerTimestamp )
 {
-	while( !mMoves.empty() && mMoves.front().GetTimestamp() <= inLastMoveProcessedOnServerTimestamp )
+	while( mMoveCount > 0 && GetMove( 0 ).GetTimestamp() <= inLastMoveProcessedOnServerTimestamp )
+	{
+		mFirstMoveIndex = ( mFirstMoveIndex + 1 ) & ( kCapacity - 1 );
+		--mMoveCount;
+	}
+}
+
+Move& MoveList::PushMove()
+{
+	if( mMoveCount == kCapacity )
+	{
+		//full- the oldest goes
+		if( mOverflowCount++ == 0 )
+		{
+			LOG( "Move list full, dropping the oldest moves", 0 );
+		}
+		mFirstMoveIndex = ( mFirstMoveIndex + 1 ) & ( kCapacity - 1 );
+		--mMoveCount;
+	}
+
+	++mMoveCount;
+	return mMoves[ ( mFirstMoveIndex + mMoveCount - 1 ) & ( kCapacity - 1 ) ];
+}
+
+void MoveList::Write( OutputMemoryBitStream& inOutputStream, uint32_t inFirstTick ) const
+{
+	uint32_t firstMoveIndex = mMoveCount;
+	while( firstMoveIndex > 0 && GetMove( firstMoveIndex - 1 ).GetTick() >= inFirstTick && mMoveCount - firstMoveIndex < kMaxMovesPerPacket )
 	{
-		mMoves.pop_front();
+		--firstMoveIndex;
 	}
+
+	uint32_t moveCount = mMoveCount - firstMoveIndex;
+	inOutputStream.Write( moveCount, kMoveCountBitCount );
+	if( moveCount == 0 )
+	{
+		return;
+	}
+
+	//the first tick in full, then the step to each of the others
+	inOutputStream.Write( GetMove( firstMoveIndex ).GetTick() );
+	for( uint32_t i = firstMoveIndex + 1; i < mMoveCount; ++i )
+	{
+		WriteTickDelta( inOutputStream, GetMove( i ).GetTick() - GetMove( i - 1 ).GetTick() );
+	}
+
+	//then the input, once per run of moves that all had the same
+	for( uint32_t runStart = firstMoveIndex; runStart < mMoveCount; )
+	{
+		const InputState& inputState = GetMove( runStart ).GetInputState();
+
+		uint32_t runEnd = runStart + 1;
+		while( runEnd < mMoveCount && runEnd - runStart < kMaxRunLength && GetMove( runEnd ).GetInputState() == inputState )
+		{
+			++runEnd;
+		}
+
+		inputState.Write( inOutputStream );
+		inOutputStream.Write( runEnd - runStart - 1, kRunLengthBitCount );
+
+		runStart = runEnd;
+	}
+}
+
+bool MoveList::ReadAndAddNewMoves( InputMemoryBitStream& inInputStream )
+{
+	uint32_t moveCount = 0;
+	inInputStream.Read( moveCount, kMoveCountBitCount );
+	if( moveCount == 0 )
+	{
+		return false;
+	}
+
+	uint32_t ticks[ kMaxMovesPerPacket ];
+	inInputStream.Read( ticks[ 0 ] );
+	for( uint32_t i = 1; i < moveCount; ++i )
+	{
+		ticks[ i ] = ticks[ i - 1 ] + ReadTickDelta( inInputStream );
+	}
+
+	bool isAnyMoveNew = false;
+	for( uint32_t moveIndex = 0; moveIndex < moveCount; )
+	{
+		InputState inputState;
+		inputState.Read( inInputStream );
+		uint32_t runLength = 0;
+		inInputStream.Read( runLength, kRunLengthBitCount );
+
+		//a run can't go past the moves we were told about, whatever the packet says
+		uint32_t runEnd = std::min( moveIndex + runLength + 1, moveCount );
+		for( ; moveIndex < runEnd; ++moveIndex )
+		{
+			//most moves in a packet are ones we've had already- they only cost a compare
+			if( AddMoveIfNew( inputState, ticks[ moveIndex ] ) )
+			{
+				isAnyMoveNew = true;
+			}
+		}
+	}
+
+	return isAnyMoveNew;
 }
@@ -1,7 +1,11 @@
 #include <RoboCatPCH.h>
 
+const float NetworkManager::kInterpolationDelay = 0.1f;
+
 NetworkManager::NetworkManager() :
+	mIsSocketShared( false ),
 	mBytesSentThisFrame( 0 ),
+	mBytesReceivedThisFrame( 0 ),
 	mDropPacketChance( 0.f ),
 	mSimulatedLatency( 0.f )
 {
@@ -36,12 +40,27 @@ bool NetworkManager::Init( uint16_t inPort )
 	return true;
 }
 
+void NetworkManager::Init( UDPSocketPtr inSharedSocket )
+{
+	mSocket = inSharedSocket;
+	mIsSocketShared = true;
+
+	mBytesReceivedPerSecond = WeightedTimedMovingAverage( 1.f );
+	mBytesSentPerSecond = WeightedTimedMovingAverage( 1.f );
+}
+
 void NetworkManager::ProcessIncomingPackets()
 {
-	ReadIncomingPacketsIntoQueue();
+	//with a shared socket, whoever owns it has already queued up our packets
+	if( !mIsSocketShared )
+	{
+		ReadIncomingPacketsIntoQueue();
+	}
 
 	ProcessQueuedPackets();
 
+	UpdateBytesReceivedLastFrame();
+
 	UpdateBytesSentLastFrame();
 
 }
@@ -57,7 +76,6 @@ void NetworkManager::ReadIncomingPacketsIntoQueue()
 
 	//keep reading until we don't have anything to read ( or we hit a max number that we'll process per frame )
 	int receivedPackedCount = 0;
-	int totalReadByteCount = 0;
 
 	while( receivedPackedCount < kMaxPacketsPerFrameCount )
 	{
@@ -76,34 +94,35 @@ void NetworkManager::ReadIncomingPacketsIntoQueue()
 		{
 			inputStream.ResetToCapacity( readByteCount );
 			++receivedPackedCount;
-			totalReadByteCount += readByteCount;
-
-			//now, should we drop the packet?
-			if( RoboMath::GetRandomFloat() >= mDropPacketChance )
-			{
-				//we made it
-				//shove the packet into the queue and we'll handle it as soon as we should...
-				//we'll pretend it wasn't received until simulated latency from now
-				//this doesn't sim jitter, for that we would need to.....
-
-				float simulatedReceivedTime = Timing::sInstance.GetTimef() + mSimulatedLatency;
-				mPacketQueue.emplace( simulatedReceivedTime, inputStream, fromAddress );
-			}
-			else
-			{
-				LOG( "Dropped packet!", 0 );
-				//dropped!
-			}
+
+			QueuePacket( inputStream, fromAddress );
 		}
 		else
 		{
 			//uhoh, error? exit or just keep going?
 		}
 	}
+}
 
-	if( totalReadByteCount > 0 )
+void NetworkManager::QueuePacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress )
+{
+	mBytesReceivedThisFrame += inInputStream.GetRemainingBitCount() / 8;
+
+	//now, should we drop the packet?
+	if( RoboMath::GetRandomFloat() >= mDropPacketChance )
+	{
+		//we made it
+		//shove the packet into the queue and we'll handle it as soon as we should...
+		//we'll pretend it wasn't received until simulated latency from now
+		//this doesn't sim jitter, for that we would need to.....
+
+		float simulatedReceivedTime = Timing::sInstance.GetTimef() + mSimulatedLatency;
+		mPacketQueue.emplace( simulatedReceivedTime, inInputStream, inFromAddress );
+	}
+	else
 	{
-		mBytesReceivedPerSecond.UpdatePerSecond( static_cast< float >( totalReadByteCount ) );
+		LOG( "Dropped packet!", 0 );
+		//dropped!
 	}
 }
 
@@ -129,6 +148,8 @@ void NetworkManager::ProcessQueuedPackets()
 
 void NetworkManager::SendPacket( const OutputMemoryBitStream& inOutputStream, const SocketAddress& inFromAddress )
 {
+	AllocationPhaseScope phaseScope( EAP_Send );
+
 	int sentByteCount = mSocket->SendTo( inOutputStream.GetBufferPtr(), inOutputStream.GetByteLength(), inFromAddress );
 	if( sentByteCount > 0 )
 	{
@@ -136,6 +157,16 @@ void NetworkManager::SendPacket( const OutputMemoryBitStream& inOutputStream, co
 	}
 }
 
+void NetworkManager::UpdateBytesReceivedLastFrame()
+{
+	if( mBytesReceivedThisFrame > 0 )
+	{
+		mBytesReceivedPerSecond.UpdatePerSecond( static_cast< float >( mBytesReceivedThisFrame ) );
+
+		mBytesReceivedThisFrame = 0;
+	}
+}
+
 void NetworkManager::UpdateBytesSentLastFrame()
 {
 	if( mBytesSentThisFrame > 0 )
@@ -150,18 +181,20 @@ void NetworkManager::UpdateBytesSentLastFrame()
 
 NetworkManager::ReceivedPacket::ReceivedPacket( float inReceivedTime, InputMemoryBitStream& ioInputMemoryBitStream, const SocketAddress& inFromAddress ) :
 	mReceivedTime( inReceivedTime ),
-	mFromAddress( inFromAddress ),
-	mPacketBuffer( ioInputMemoryBitStream )
+	//packets get queued before anyone reads from them, so what's left is the whole packet
+	mPacketMem( ioInputMemoryBitStream.GetBufferPtr(), ioInputMemoryBitStream.GetBufferPtr() + ioInputMemoryBitStream.GetRemainingBitCount() / 8 ),
+	mPacketBuffer( mPacketMem.data(), ioInputMemoryBitStream.GetRemainingBitCount() ),
+	mFromAddress( inFromAddress )
 {
 }
 
 
-void NetworkManager::AddToNetworkIdToGameObjectMap( GameObjectPtr inGameObject )
+void NetworkManager::AddToNetworkIdToGameObjectMap( GameObject* inGameObject )
 {
-	mNetworkIdToGameObjectMap[ inGameObject->GetNetworkId() ] = inGameObject;
+	mNetworkIdToGameObjectMap[ inGameObject->GetNetworkId() ] = inGameObject->GetHandle();
 }
 
-void NetworkManager::RemoveFromNetworkIdToGameObjectMap( GameObjectPtr inGameObject )
+void NetworkManager::RemoveFromNetworkIdToGameObjectMap( GameObject* inGameObject )
 {
 	mNetworkIdToGameObjectMap.erase( inGameObject->GetNetworkId() );
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "RoboCatPCH.h"
+
+namespace
+{
+	size_t RoundUpToAlignment( size_t inSize )
+	{
+		return ( inSize + ObjectPools::kAlignment - 1 ) & ~( ObjectPools::kAlignment - 1 );
+	}
+
+	FixedBlockPool** CreatePools()
+	{
+		const size_t poolCount = ObjectPools::kMaxPooledSize / ObjectPools::kAlignment + 1;
+		FixedBlockPool** pools = new FixedBlockPool*[ poolCount ];
+		for( size_t i = 0; i < poolCount; ++i )
+		{
+			//pool 0 is only for zero byte requests
+			pools[ i ] = new FixedBlockPool( std::max( i * ObjectPools::kAlignment, size_t( 1 ) ), ObjectPools::kBlocksPerChunk );
+		}
+		return pools;
+	}
+}
+
+FixedBlockPool::FixedBlockPool( size_t inBlockSize, size_t inBlocksPerChunk ) :
+	mBlockSize( std::max( RoundUpToAlignment( inBlockSize ), sizeof( FreeBlock ) ) ),
+	mBlocksPerChunk( inBlocksPerChunk ),
+	mFreeList( nullptr )
+{
+}
+
+void* FixedBlockPool::Allocate()
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	if( !mFreeList )
+	{
+		AddChunk();
+	}
+
+	FreeBlock* block = mFreeList;
+	mFreeList = block->mNext;
+	return block;
+}
+
+void FixedBlockPool::Free( void* inBlock )
+{
+	std::lock_guard< std::mutex > lock( mMutex );
+
+	FreeBlock* block = static_cast< FreeBlock* >( inBlock );
+	block->mNext = mFreeList;
+	mFreeList = block;
+}
+
+void FixedBlockPool::AddChunk()
+{
+	//new[] gives back memory aligned for anything, and block sizes are a multiple of the alignment, so every block is too
+	char* chunk = new char[ mBlockSize * mBlocksPerChunk ];
+	mChunks.emplace_back( chunk );
+
+	//thread the list through back to front so blocks come out in address order
+	for( size_t i = mBlocksPerChunk; i > 0; --i )
+	{
+		FreeBlock* block = reinterpret_cast< FreeBlock* >( chunk + ( i - 1 ) * mBlockSize );
+		block->mNext = mFreeList;
+		mFreeList = block;
+	}
+}
+
+
+void* ObjectPools::Allocate( size_t inSize )
+{
+	FixedBlockPool* pool = GetPool( inSize );
+	return pool ? pool->Allocate() : ::operator new( inSize );
+}
+
+void ObjectPools::Free( void* inBlock, size_t inSize )
+{
+	FixedBlockPool* pool = GetPool( inSize );
+	if( pool )
+	{
+		pool->Free( inBlock );
+	}
+	else
+	{
+		::operator delete( inBlock );
+	}
+}
+
+FixedBlockPool* ObjectPools::GetPool( size_t inSize )
+{
+	if( inSize > kMaxPooledSize )
+	{
+		return nullptr;
+	}
+
+	//deliberately never freed- game objects held by other singletons can be destroyed after any static of ours would be.
+	//every size is made up front, on the first call from the main thread, so finding one later never has to lock
+	static FixedBlockPool** sPools = CreatePools();
+
+	return sPools[ RoundUpToAlignment( inSize ) / kAlignment ];
+}
@@ -0,0 +1,185 @@
+#include "RoboCatPCH.h"
+
+using namespace RangeCoder;
+
+void OutputRangeCoder::Begin( OutputMemoryBitStream& inOutputStream )
+{
+	mOutputStream = &inOutputStream;
+	mLow = 0;
+	mRange = 0xffffffff;
+	mCacheSize = 1;
+	mCache = 0;
+	mHasSkippedFirstByte = false;
+}
+
+void OutputRangeCoder::End()
+{
+	//push out everything still sitting in low so the decoder can resolve the final range
+	for( int i = 0; i < 5; ++i )
+	{
+		ShiftLow();
+	}
+
+	mOutputStream = nullptr;
+}
+
+void OutputRangeCoder::ShiftLow()
+{
+	if( static_cast< uint32_t >( mLow ) < 0xff000000 || ( mLow >> 32 ) != 0 )
+	{
+		//we know the top byte can't change anymore, so flush the cached byte and any pending 0xff's, with carry
+		uint8_t carry = static_cast< uint8_t >( mLow >> 32 );
+		uint8_t temp = mCache;
+		do
+		{
+			if( mHasSkippedFirstByte )
+			{
+				mOutputStream->WriteBits( static_cast< uint8_t >( temp + carry ), 8 );
+			}
+			mHasSkippedFirstByte = true;
+			temp = 0xff;
+		}
+		while( --mCacheSize != 0 );
+
+		mCache = static_cast< uint8_t >( static_cast< uint32_t >( mLow ) >> 24 );
+	}
+
+	++mCacheSize;
+	mLow = ( mLow & 0x00ffffff ) << 8;
+}
+
+void OutputRangeCoder::EncodeBit( RangeCoderProbability& ioProbability, uint32_t inBit )
+{
+	uint32_t bound = ( mRange >> kProbabilityBits ) * ioProbability;
+	if( inBit == 0 )
+	{
+		mRange = bound;
+	}
+	else
+	{
+		mLow += bound;
+		mRange -= bound;
+	}
+
+	AdaptProbability( ioProbability, inBit );
+
+	while( mRange < kTopValue )
+	{
+		mRange <<= 8;
+		ShiftLow();
+	}
+}
+
+void OutputRangeCoder::EncodeDirectBits( uint32_t inValue, uint32_t inBitCount )
+{
+	//msb first, each bit at exactly 50%
+	while( inBitCount > 0 )
+	{
+		--inBitCount;
+		mRange >>= 1;
+		if( ( inValue >> inBitCount ) & 1 )
+		{
+			mLow += mRange;
+		}
+
+		while( mRange < kTopValue )
+		{
+			mRange <<= 8;
+			ShiftLow();
+		}
+	}
+}
+
+void OutputRangeCoder::EncodeBitTree( RangeCoderProbability* ioProbabilities, uint32_t inSymbol, uint32_t inBitCount )
+{
+	uint32_t node = 1;
+	while( inBitCount > 0 )
+	{
+		--inBitCount;
+		uint32_t bit = ( inSymbol >> inBitCount ) & 1;
+		EncodeBit( ioProbabilities[ node ], bit );
+		node = ( node << 1 ) | bit;
+	}
+}
+
+
+void InputRangeCoder::Begin( InputMemoryBitStream& inInputStream )
+{
+	mInputStream = &inInputStream;
+	mRange = 0xffffffff;
+	mCode = 0;
+
+	//the encoder never sends its leading 0 byte, so there are only 4 bytes to prime with
+	for( int i = 0; i < 4; ++i )
+	{
+		uint8_t byte;
+		mInputStream->ReadBits( byte, 8 );
+		mCode = ( mCode << 8 ) | byte;
+	}
+}
+
+inline void InputRangeCoder::Normalize()
+{
+	while( mRange < kTopValue )
+	{
+		uint8_t byte;
+		mInputStream->ReadBits( byte, 8 );
+		mRange <<= 8;
+		mCode = ( mCode << 8 ) | byte;
+	}
+}
+
+uint32_t InputRangeCoder::DecodeBit( RangeCoderProbability& ioProbability )
+{
+	uint32_t bound = ( mRange >> kProbabilityBits ) * ioProbability;
+	uint32_t bit;
+	if( mCode < bound )
+	{
+		mRange = bound;
+		bit = 0;
+	}
+	else
+	{
+		mCode -= bound;
+		mRange -= bound;
+		bit = 1;
+	}
+
+	AdaptProbability( ioProbability, bit );
+	Normalize();
+
+	return bit;
+}
+
+uint32_t InputRangeCoder::DecodeDirectBits( uint32_t inBitCount )
+{
+	uint32_t value = 0;
+	while( inBitCount > 0 )
+	{
+		--inBitCount;
+		mRange >>= 1;
+		uint32_t bit = 0;
+		if( mCode >= mRange )
+		{
+			mCode -= mRange;
+			bit = 1;
+		}
+		value = ( value << 1 ) | bit;
+
+		Normalize();
+	}
+
+	return value;
+}
+
+uint32_t InputRangeCoder::DecodeBitTree( RangeCoderProbability* ioProbabilities, uint32_t inBitCount )
+{
+	uint32_t node = 1;
+	for( uint32_t i = 0; i < inBitCount; ++i )
+	{
+		node = ( node << 1 ) | DecodeBit( ioProbabilities[ node ] );
+	}
+
+	//strip the leading 1 that marked the root
+	return node - ( 1 << inBitCount );
+}
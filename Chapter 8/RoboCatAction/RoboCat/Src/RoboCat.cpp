@@ -4,6 +4,15 @@
 const float HALF_WORLD_HEIGHT = 3.6f;
 const float HALF_WORLD_WIDTH = 6.4f;
 
+namespace
+{
+	//distances get worked out this many at a time, on the stack
+	const uint32_t kCollisionBatchSize = 256;
+
+	//five shots a second
+	const uint32_t kTicksBetweenShots = Move::kTicksPerSecond / 5;
+}
+
 RoboCat::RoboCat() :
 	GameObject(),
 	mMaxRotationSpeed( 5.f ),
@@ -14,7 +23,9 @@ RoboCat::RoboCat() :
 	mThrustDir( 0.f ),
 	mPlayerId( 0 ),
 	mIsShooting( false ),
-	mHealth( 10 )
+	mHealth( 10 ),
+	mTickOfNextShot( 0 ),
+	mTouchedObjectCount( 0 )
 {
 	SetCollisionRadius( 0.5f );
 }
@@ -36,6 +47,17 @@ void RoboCat::ProcessInput( float inDeltaTime, const InputState& inInputState )
 
 }
 
+bool RoboCat::TryShoot( uint32_t inMoveTick )
+{
+	if( mIsShooting && inMoveTick >= mTickOfNextShot )
+	{
+		mTickOfNextShot = inMoveTick + kTicksBetweenShots;
+		return true;
+	}
+
+	return false;
+}
+
 void RoboCat::AdjustVelocityByThrust( float inDeltaTime )
 {
 	//just set the velocity based on the thrust direction -- no thrust will lead to 0 velocity
@@ -45,6 +67,13 @@ void RoboCat::AdjustVelocityByThrust( float inDeltaTime )
 }
 
 void RoboCat::SimulateMovement( float inDeltaTime )
+{
+	IntegrateMovement( inDeltaTime );
+
+	ProcessCollisionsWithObjects();
+}
+
+void RoboCat::IntegrateMovement( float inDeltaTime )
 {
 	//simulate us...
 	AdjustVelocityByThrust( inDeltaTime );
@@ -52,7 +81,7 @@ void RoboCat::SimulateMovement( float inDeltaTime )
 
 	SetLocation( GetLocation() + mVelocity * inDeltaTime );
 
-	ProcessCollisions();
+	ProcessCollisionsWithScreenWalls();
 }
 
 void RoboCat::Update()
@@ -65,6 +94,11 @@ void RoboCat::ProcessCollisions()
 	//right now just bounce off the sides..
 	ProcessCollisionsWithScreenWalls();
 
+	ProcessCollisionsWithObjects();
+}
+
+void RoboCat::ProcessCollisionsWithObjects()
+{
 	float sourceRadius = GetCollisionRadius();
 	Vector3 sourceLocation = GetLocation();
 
@@ -73,62 +107,63 @@ void RoboCat::ProcessCollisions()
 	//but in a real game, brute-force checking collisions against every other object is not efficient.
 	//it would be preferable to use a quad tree or some other structure to minimize the
 	//number of collisions that need to be tested.
-	for( auto goIt = World::sInstance->GetGameObjects().begin(), end = World::sInstance->GetGameObjects().end(); goIt != end; ++goIt )
+	//the distances come straight out of the transform store in simd batches, and we only touch an object once it's close enough to hit
+	//everything's checked against where it was when the frame started- other cats are moving on other threads meanwhile,
+	//and this way it can't matter which of us moved first. only other cats push us around in here. anything else we ran into
+	//is just remembered, and hears about it in HandleTouchedObjects once it's safe to touch
+	const TransformStore& transforms = World::sInstance->GetTransformStore();
+	uint32_t targetCount = transforms.GetFrameStartCount();
+	GameObjectHandle handle = GetHandle();
+	float distancesSq[ kCollisionBatchSize ];
+	for( uint32_t batchStart = 0; batchStart < targetCount; batchStart += kCollisionBatchSize )
 	{
-		GameObject* target = goIt->get();
-		if( target != this && !target->DoesWantToDie() )
+		uint32_t batchCount = std::min( targetCount - batchStart, kCollisionBatchSize );
+		RoboMath::DistanceSq2DBatch( sourceLocation, transforms.GetFrameStartLocationXs() + batchStart, transforms.GetFrameStartLocationYs() + batchStart, batchCount, distancesSq );
+
+		for( uint32_t i = 0; i < batchCount; ++i )
 		{
 			//simple collision test for spheres- are the radii summed less than the distance?
-			Vector3 targetLocation = target->GetLocation();
-			float targetRadius = target->GetCollisionRadius();
+			uint32_t targetIndex = batchStart + i;
+			const TransformStore::FrameStartEntry& target = transforms.GetFrameStartEntry( targetIndex );
+			float collisionDist = ( sourceRadius + target.mCollisionRadius );
+			if( distancesSq[ i ] >= ( collisionDist * collisionDist ) )
+			{
+				continue;
+			}
 
-			Vector3 delta = targetLocation - sourceLocation;
-			float distSq = delta.LengthSq2D();
-			float collisionDist = ( sourceRadius + targetRadius );
-			if( distSq < ( collisionDist * collisionDist ) )
+			if( target.mHandle != handle && !target.mDoesWantToDie )
 			{
-				//first, tell the other guy there was a collision with a cat, so it can do something...
+				if( !target.mIsCat )
+				{
+					TouchObject( target.mHandle );
+					continue;
+				}
+
+				Vector3 targetLocation = transforms.GetFrameStartLocation( targetIndex );
+				Vector3 delta = targetLocation - sourceLocation;
+
+				//okay, you hit something!
+				//so, project your location far enough that you're not colliding
+				Vector3 dirToTarget = delta;
+				dirToTarget.Normalize2D();
+				Vector3 acceptableDeltaFromSourceToTarget = dirToTarget * collisionDist;
+				//important note- we only move this cat. the other cat can take care of moving itself
+				SetLocation( targetLocation - acceptableDeltaFromSourceToTarget );
+
+				
+				//the other cat might have velocity, so there might be relative velocity...
+				Vector3 relVel = mVelocity - target.mVelocity;
+
+				//got vel with dir between objects to figure out if they're moving towards each other
+				//and if so, the magnitude of the impulse ( since they're both just balls )
+				float relVelDotDir = Dot2D( relVel, dirToTarget );
 
-				if( target->HandleCollisionWithCat( this ) )
+				if (relVelDotDir > 0.f)
 				{
-					//okay, you hit something!
-					//so, project your location far enough that you're not colliding
-					Vector3 dirToTarget = delta;
-					dirToTarget.Normalize2D();
-					Vector3 acceptableDeltaFromSourceToTarget = dirToTarget * collisionDist;
-					//important note- we only move this cat. the other cat can take care of moving itself
-					SetLocation( targetLocation - acceptableDeltaFromSourceToTarget );
-
-					
-					Vector3 relVel = mVelocity;
+					Vector3 impulse = relVelDotDir * dirToTarget;
 				
-					//if other object is a cat, it might have velocity, so there might be relative velocity...
-					RoboCat* targetCat = target->GetAsCat();
-					if( targetCat )
-					{
-						relVel -= targetCat->mVelocity;
-					}
-
-					//got vel with dir between objects to figure out if they're moving towards each other
-					//and if so, the magnitude of the impulse ( since they're both just balls )
-					float relVelDotDir = Dot2D( relVel, dirToTarget );
-
-					if (relVelDotDir > 0.f)
-					{
-						Vector3 impulse = relVelDotDir * dirToTarget;
-					
-						if( targetCat )
-						{
-							mVelocity -= impulse;
-							mVelocity *= mCatRestitution;
-						}
-						else
-						{
-							mVelocity -= impulse * 2.f;
-							mVelocity *= mWallRestitution;
-						}
-
-					}
+					mVelocity -= impulse;
+					mVelocity *= mCatRestitution;
 				}
 			}
 		}
@@ -136,6 +171,38 @@ void RoboCat::ProcessCollisions()
 
 }
 
+void RoboCat::TouchObject( GameObjectHandle inHandle )
+{
+	for( uint32_t i = 0; i < mTouchedObjectCount; ++i )
+	{
+		if( mTouchedObjects[ i ] == inHandle )
+		{
+			return;
+		}
+	}
+
+	//a cat's only ever on top of a mouse or two at once, so a full list means something odd's going on- drop the extras
+	if( mTouchedObjectCount < kMaxTouchedObjects )
+	{
+		mTouchedObjects[ mTouchedObjectCount++ ] = inHandle;
+	}
+}
+
+void RoboCat::HandleTouchedObjects()
+{
+	for( uint32_t i = 0; i < mTouchedObjectCount; ++i )
+	{
+		//someone else may have got to it first this frame
+		GameObject* target = mTouchedObjects[ i ].Get();
+		if( target && !target->DoesWantToDie() )
+		{
+			target->HandleCollisionWithCat( this );
+		}
+	}
+
+	mTouchedObjectCount = 0;
+}
+
 void RoboCat::ProcessCollisionsWithScreenWalls()
 {
 	Vector3 location = GetLocation();
@@ -259,4 +326,20 @@ uint32_t RoboCat::Write( OutputMemoryBitStream& inOutputStream, uint32_t inDirty
 
 }
 
+void RoboCat::WriteSnapshot( GameObjectSnapshotRecord& outRecord ) const
+{
+	GameObject::WriteSnapshot( outRecord );
+
+	outRecord.mVelocity = mVelocity;
+	outRecord.mPlayerId = mPlayerId;
+	outRecord.mHealth = mHealth;
+}
 
+void RoboCat::ReadSnapshot( const GameObjectSnapshotRecord& inRecord )
+{
+	GameObject::ReadSnapshot( inRecord );
+
+	mVelocity = inRecord.mVelocity;
+	mPlayerId = inRecord.mPlayerId;
+	mHealth = inRecord.mHealth;
+}
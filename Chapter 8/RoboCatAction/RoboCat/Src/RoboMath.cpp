@@ -15,8 +15,15 @@ const Vector3 Vector3::UnitX( 1.0f, 0.0f, 0.0f );
 const Vector3 Vector3::UnitY( 0.0f, 1.0f, 0.0f );
 const Vector3 Vector3::UnitZ( 0.0f, 0.0f, 1.0f );
 
+namespace
+{
+	//shared by every thread that wants a number, so it's locked
+	std::mutex sRandomMutex;
+}
+
 float RoboMath::GetRandomFloat()
 {
+	std::lock_guard< std::mutex > lock( sRandomMutex );
 	static std::random_device rd;
 	static std::mt19937 gen( rd() );
 	static std::uniform_real_distribution< float > dis( 0.f, 1.f );
@@ -28,3 +35,96 @@ Vector3 RoboMath::GetRandomVector( const Vector3& inMin, const Vector3& inMax )
 	Vector3 r = Vector3( GetRandomFloat(), GetRandomFloat(), GetRandomFloat() );
 	return inMin + ( inMax - inMin ) * r;
 }
+
+void RoboMath::DistanceSq2DBatch( const Vector3& inPoint, const float* inXs, const float* inYs, uint32_t inCount, float* outDistancesSq )
+{
+	uint32_t i = 0;
+
+#if ROBOMATH_USE_SIMD
+	using namespace Simd;
+	Float4 pointX = Splat( inPoint.mX );
+	Float4 pointY = Splat( inPoint.mY );
+	for( ; i + 4 <= inCount; i += 4 )
+	{
+		Float4 deltaX = Subtract( Load( inXs + i ), pointX );
+		Float4 deltaY = Subtract( Load( inYs + i ), pointY );
+		Store( outDistancesSq + i, Add( Multiply( deltaX, deltaX ), Multiply( deltaY, deltaY ) ) );
+	}
+#endif
+
+	//whatever's left over, or everything when there's no simd
+	for( ; i < inCount; ++i )
+	{
+		float deltaX = inXs[ i ] - inPoint.mX;
+		float deltaY = inYs[ i ] - inPoint.mY;
+		outDistancesSq[ i ] = deltaX * deltaX + deltaY * deltaY;
+	}
+}
+
+void RoboMath::Normalize2DBatch( float* ioXs, float* ioYs, uint32_t inCount )
+{
+	uint32_t i = 0;
+
+#if ROBOMATH_USE_SIMD
+	using namespace Simd;
+	Float4 zero = Splat( 0.f );
+	Float4 one = Splat( 1.f );
+	for( ; i + 4 <= inCount; i += 4 )
+	{
+		Float4 x = Load( ioXs + i );
+		Float4 y = Load( ioYs + i );
+		Float4 length = Sqrt( Add( Multiply( x, x ), Multiply( y, y ) ) );
+		//zero lanes divide by zero here, but they get thrown away by the select
+		Mask4 hasLength = GreaterThan( length, zero );
+		Float4 inverseLength = Divide( one, length );
+		Store( ioXs + i, Select( hasLength, Multiply( x, inverseLength ), x ) );
+		Store( ioYs + i, Select( hasLength, Multiply( y, inverseLength ), y ) );
+	}
+#endif
+
+	for( ; i < inCount; ++i )
+	{
+		float length = sqrtf( ioXs[ i ] * ioXs[ i ] + ioYs[ i ] * ioYs[ i ] );
+		if( length > 0.f )
+		{
+			float inverseLength = 1.f / length;
+			ioXs[ i ] *= inverseLength;
+			ioYs[ i ] *= inverseLength;
+		}
+	}
+}
+
+void RoboMath::NormalizeBatch( float* ioXs, float* ioYs, float* ioZs, uint32_t inCount )
+{
+	uint32_t i = 0;
+
+#if ROBOMATH_USE_SIMD
+	using namespace Simd;
+	Float4 zero = Splat( 0.f );
+	Float4 one = Splat( 1.f );
+	for( ; i + 4 <= inCount; i += 4 )
+	{
+		Float4 x = Load( ioXs + i );
+		Float4 y = Load( ioYs + i );
+		Float4 z = Load( ioZs + i );
+		Float4 length = Sqrt( Add( Add( Multiply( x, x ), Multiply( y, y ) ), Multiply( z, z ) ) );
+		Mask4 hasLength = GreaterThan( length, zero );
+		Float4 inverseLength = Divide( one, length );
+		Store( ioXs + i, Select( hasLength, Multiply( x, inverseLength ), x ) );
+		Store( ioYs + i, Select( hasLength, Multiply( y, inverseLength ), y ) );
+		Store( ioZs + i, Select( hasLength, Multiply( z, inverseLength ), z ) );
+	}
+#endif
+
+	for( ; i < inCount; ++i )
+	{
+		float length = sqrtf( ioXs[ i ] * ioXs[ i ] + ioYs[ i ] * ioYs[ i ] + ioZs[ i ] * ioZs[ i ] );
+		if( length > 0.f )
+		{
+			float inverseLength = 1.f / length;
+			ioXs[ i ] *= inverseLength;
+			ioYs[ i ] *= inverseLength;
+			ioZs[ i ] *= inverseLength;
+		}
+	}
+}
@@ -1,11 +1,17 @@
 #include "RoboCatPCH.h"
 
-std::unique_ptr< ScoreBoardManager >	ScoreBoardManager::sInstance;
+namespace
+{
+	std::unique_ptr< ScoreBoardManager >	sProgramScoreBoardManager;
+}
+
+ROBOCAT_THREAD_LOCAL ScoreBoardManager*	ScoreBoardManager::sInstance = nullptr;
 
 
 void ScoreBoardManager::StaticInit()
 {
-	sInstance.reset( new ScoreBoardManager() );
+	sProgramScoreBoardManager.reset( new ScoreBoardManager() );
+	sInstance = sProgramScoreBoardManager.get();
 }
 
 ScoreBoardManager::ScoreBoardManager()
@@ -63,11 +69,16 @@ bool ScoreBoardManager::RemoveEntry( uint32_t inPlayerId )
 }
 
 void ScoreBoardManager::AddEntry( uint32_t inPlayerId, const string& inPlayerName )
+{
+	AddEntry( inPlayerId, inPlayerName, mDefaultColors[ inPlayerId % mDefaultColors.size() ] );
+}
+
+void ScoreBoardManager::AddEntry( uint32_t inPlayerId, const string& inPlayerName, const Vector3& inColor )
 {
 	//if this player id exists already, remove it first- it would be crazy to have two of the same id
 	RemoveEntry( inPlayerId );
 	
-	mEntries.emplace_back( inPlayerId, inPlayerName, mDefaultColors[ inPlayerId % mDefaultColors.size() ] );
+	mEntries.emplace_back( inPlayerId, inPlayerName, inColor );
 }
 
 void ScoreBoardManager::IncScore( uint32_t inPlayerId, int inAmount )
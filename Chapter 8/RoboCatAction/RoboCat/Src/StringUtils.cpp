@@ -22,8 +22,8 @@ string StringUtils::GetCommandLineArg( int inIndex )
 
 string StringUtils::Sprintf( const char* inFormat, ... )
 {
-	//not thread safe...
-	static char temp[ 4096 ];
+	//on the stack, since the server's matches log from whichever thread they're on
+	char temp[ 4096 ];
 	
 	va_list args;
 	va_start (args, inFormat );
@@ -44,8 +44,7 @@ string StringUtils::Sprintf( const char* inFormat, ... )
 
 void StringUtils::Log( const char* inFormat, ... )
 {
-	//not thread safe...
-	static char temp[ 4096 ];
+	char temp[ 4096 ];
 	
 	va_list args;
 	va_start (args, inFormat );
@@ -0,0 +1,217 @@
+#include "RoboCatPCH.h"
+
+namespace
+{
+	//fine enough for timeouts and respawns, and a second's worth fits in the first wheel
+	const float kTicksPerSecond = 64.f;
+
+	const uint32_t kNoTimer = 0xffffffff;
+	//every yarn in flight holds one, so this matches the world's own initial capacity
+	const uint32_t kInitialTimerCapacity = 256;
+
+	uint64_t TimeToTick( float inTime )
+	{
+		return inTime > 0.f ? static_cast< uint64_t >( inTime * kTicksPerSecond ) : 0;
+	}
+
+	std::unique_ptr< TimerWheel >	sProgramTimerWheel;
+}
+
+ROBOCAT_THREAD_LOCAL TimerWheel*	TimerWheel::sInstance = nullptr;
+
+void TimerWheel::StaticInit()
+{
+	sProgramTimerWheel.reset( new TimerWheel() );
+	sInstance = sProgramTimerWheel.get();
+}
+
+TimerWheel::TimerWheel() :
+	mCurrentTick( TimeToTick( Timing::sInstance.GetFrameStartTime() ) ),
+	mScheduledCount( 0 )
+{
+	for( uint32_t& slotHead : mSlotHeads )
+	{
+		slotHead = kNoTimer;
+	}
+
+	mTimers.reserve( kInitialTimerCapacity );
+	mFreeIndices.reserve( kInitialTimerCapacity );
+}
+
+TimerHandle TimerWheel::ScheduleAt( float inTime, const Callback& inCallback )
+{
+	uint32_t index;
+	if( !mFreeIndices.empty() )
+	{
+		index = mFreeIndices.back();
+		mFreeIndices.pop_back();
+	}
+	else
+	{
+		index = static_cast< uint32_t >( mTimers.size() );
+		mTimers.emplace_back();
+	}
+
+	Timer& timer = mTimers[ index ];
+	timer.mCallback = inCallback;
+	//round up so it never goes off early. anything already due goes off next tick- the current one's been and gone
+	timer.mDueTick = std::max( static_cast< uint64_t >( ceil( std::max( inTime, 0.f ) * kTicksPerSecond ) ), mCurrentTick + 1 );
+	timer.mIsScheduled = true;
+	++mScheduledCount;
+
+	Insert( index );
+
+	return TimerHandle( index, timer.mGeneration );
+}
+
+TimerHandle TimerWheel::Schedule( float inDelay, const Callback& inCallback )
+{
+	return ScheduleAt( Timing::sInstance.GetFrameStartTime() + inDelay, inCallback );
+}
+
+bool TimerWheel::Cancel( TimerHandle inHandle )
+{
+	if( !IsScheduled( inHandle ) )
+	{
+		return false;
+	}
+
+	Unlink( inHandle.mIndex );
+	Release( inHandle.mIndex );
+	return true;
+}
+
+bool TimerWheel::IsScheduled( TimerHandle inHandle ) const
+{
+	if( inHandle.IsNull() || inHandle.mIndex >= mTimers.size() )
+	{
+		return false;
+	}
+
+	const Timer& timer = mTimers[ inHandle.mIndex ];
+	return timer.mIsScheduled && timer.mGeneration == inHandle.mGeneration;
+}
+
+void TimerWheel::Advance( float inTime )
+{
+	uint64_t targetTick = TimeToTick( inTime );
+
+	//nothing waiting means no slots worth visiting
+	if( mScheduledCount == 0 )
+	{
+		mCurrentTick = std::max( mCurrentTick, targetTick );
+		return;
+	}
+
+	while( mCurrentTick < targetTick )
+	{
+		++mCurrentTick;
+
+		//each time a wheel comes back round to its first slot, the next wheel up has a slot's worth to pour down
+		for( uint32_t level = 1; level < kLevelCount; ++level )
+		{
+			if( ( mCurrentTick & ( ( 1ull << ( kSlotBits * level ) ) - 1 ) ) != 0 )
+			{
+				break;
+			}
+			Cascade( level );
+		}
+
+		FireDueTimers();
+	}
+}
+
+void TimerWheel::Insert( uint32_t inIndex )
+{
+	Timer& timer = mTimers[ inIndex ];
+
+	//the finest wheel whose slots still cover the wait. past the last wheel, it goes round the last one until it's close enough
+	uint64_t ticksToWait = timer.mDueTick > mCurrentTick ? timer.mDueTick - mCurrentTick : 0;
+	uint32_t level = 0;
+	while( level + 1 < kLevelCount && ticksToWait >= ( 1ull << ( kSlotBits * ( level + 1 ) ) ) )
+	{
+		++level;
+	}
+
+	uint32_t slot = level * kSlotCount + static_cast< uint32_t >( ( timer.mDueTick >> ( kSlotBits * level ) ) & ( kSlotCount - 1 ) );
+
+	timer.mSlot = slot;
+	timer.mPrevious = kNoTimer;
+	timer.mNext = mSlotHeads[ slot ];
+	if( timer.mNext != kNoTimer )
+	{
+		mTimers[ timer.mNext ].mPrevious = inIndex;
+	}
+	mSlotHeads[ slot ] = inIndex;
+}
+
+void TimerWheel::Unlink( uint32_t inIndex )
+{
+	Timer& timer = mTimers[ inIndex ];
+
+	if( timer.mPrevious != kNoTimer )
+	{
+		mTimers[ timer.mPrevious ].mNext = timer.mNext;
+	}
+	else
+	{
+		mSlotHeads[ timer.mSlot ] = timer.mNext;
+	}
+
+	if( timer.mNext != kNoTimer )
+	{
+		mTimers[ timer.mNext ].mPrevious = timer.mPrevious;
+	}
+}
+
+void TimerWheel::Release( uint32_t inIndex )
+{
+	Timer& timer = mTimers[ inIndex ];
+
+	timer.mCallback = nullptr;
+	timer.mIsScheduled = false;
+	if( ++timer.mGeneration == 0 )
+	{
+		//wrapped- skip 0 so this can't look like a null handle
+		timer.mGeneration = 1;
+	}
+
+	--mScheduledCount;
+	mFreeIndices.push_back( inIndex );
+}
+
+void TimerWheel::Cascade( uint32_t inLevel )
+{
+	uint32_t slot = inLevel * kSlotCount + static_cast< uint32_t >( ( mCurrentTick >> ( kSlotBits * inLevel ) ) & ( kSlotCount - 1 ) );
+
+	//take the whole list first- timers can land right back in this slot if they're due a lap or more later
+	uint32_t index = mSlotHeads[ slot ];
+	mSlotHeads[ slot ] = kNoTimer;
+
+	while( index != kNoTimer )
+	{
+		uint32_t nextIndex = mTimers[ index ].mNext;
+		Insert( index );
+		index = nextIndex;
+	}
+}
+
+void TimerWheel::FireDueTimers()
+{
+	uint32_t& slotHead = mSlotHeads[ mCurrentTick & ( kSlotCount - 1 ) ];
+
+	//anything a callback schedules is due next tick at the soonest, so this can't go round forever
+	while( slotHead != kNoTimer )
+	{
+		uint32_t index = slotHead;
+		assert( mTimers[ index ].mDueTick <= mCurrentTick );
+
+		Unlink( index );
+
+		//out of the timer before it's released- the callback might schedule something that reuses it, or grows the array
+		Callback callback = std::move( mTimers[ index ].mCallback );
+		Release( index );
+
+		callback();
+	}
+}
@@ -0,0 +1,128 @@
+#include "RoboCatPCH.h"
+
+namespace
+{
+	//ioValues[ i ] += inRates[ i ] * inScale
+	void MultiplyAdd( float* ioValues, const float* inRates, float inScale, uint32_t inCount )
+	{
+		uint32_t i = 0;
+
+#if ROBOMATH_USE_SIMD
+		using namespace RoboMath::Simd;
+		Float4 scale = Splat( inScale );
+		for( ; i + 4 <= inCount; i += 4 )
+		{
+			Store( ioValues + i, Add( Load( ioValues + i ), Multiply( Load( inRates + i ), scale ) ) );
+		}
+#endif
+
+		//whatever's left over, or everything when there's no simd
+		for( ; i < inCount; ++i )
+		{
+			ioValues[ i ] += inRates[ i ] * inScale;
+		}
+	}
+}
+
+void TransformStore::Reserve( uint32_t inCapacity )
+{
+	mLocationX.reserve( inCapacity );
+	mLocationY.reserve( inCapacity );
+	mLocationZ.reserve( inCapacity );
+	mVelocityX.reserve( inCapacity );
+	mVelocityY.reserve( inCapacity );
+	mVelocityZ.reserve( inCapacity );
+	mRotation.reserve( inCapacity );
+	mScale.reserve( inCapacity );
+	mCollisionRadius.reserve( inCapacity );
+	mOwners.reserve( inCapacity );
+
+	mFrameStartLocationX.reserve( inCapacity );
+	mFrameStartLocationY.reserve( inCapacity );
+	mFrameStartEntries.reserve( inCapacity );
+}
+
+uint32_t TransformStore::Add( GameObject* inOwner )
+{
+	uint32_t index = GetCount();
+
+	mLocationX.push_back( 0.f );
+	mLocationY.push_back( 0.f );
+	mLocationZ.push_back( 0.f );
+	mVelocityX.push_back( 0.f );
+	mVelocityY.push_back( 0.f );
+	mVelocityZ.push_back( 0.f );
+	mRotation.push_back( 0.f );
+	mScale.push_back( 1.f );
+	mCollisionRadius.push_back( 0.5f );
+	mOwners.push_back( inOwner );
+
+	return index;
+}
+
+void TransformStore::Remove( uint32_t inIndex )
+{
+	uint32_t lastIndex = GetCount() - 1;
+	if( inIndex != lastIndex )
+	{
+		mLocationX[ inIndex ] = mLocationX[ lastIndex ];
+		mLocationY[ inIndex ] = mLocationY[ lastIndex ];
+		mLocationZ[ inIndex ] = mLocationZ[ lastIndex ];
+		mVelocityX[ inIndex ] = mVelocityX[ lastIndex ];
+		mVelocityY[ inIndex ] = mVelocityY[ lastIndex ];
+		mVelocityZ[ inIndex ] = mVelocityZ[ lastIndex ];
+		mRotation[ inIndex ] = mRotation[ lastIndex ];
+		mScale[ inIndex ] = mScale[ lastIndex ];
+		mCollisionRadius[ inIndex ] = mCollisionRadius[ lastIndex ];
+		mOwners[ inIndex ] = mOwners[ lastIndex ];
+		mOwners[ inIndex ]->SetTransformIndex( inIndex );
+	}
+
+	mLocationX.pop_back();
+	mLocationY.pop_back();
+	mLocationZ.pop_back();
+	mVelocityX.pop_back();
+	mVelocityY.pop_back();
+	mVelocityZ.pop_back();
+	mRotation.pop_back();
+	mScale.pop_back();
+	mCollisionRadius.pop_back();
+	mOwners.pop_back();
+}
+
+void TransformStore::Integrate( float inDeltaTime )
+{
+	uint32_t count = GetCount();
+	if( count == 0 )
+	{
+		return;
+	}
+
+	//things sitting still just add zero- cheaper than keeping movers and non movers apart
+	MultiplyAdd( mLocationX.data(), mVelocityX.data(), inDeltaTime, count );
+	MultiplyAdd( mLocationY.data(), mVelocityY.data(), inDeltaTime, count );
+	MultiplyAdd( mLocationZ.data(), mVelocityZ.data(), inDeltaTime, count );
+}
+
+void TransformStore::CaptureFrameStart()
+{
+	uint32_t count = GetCount();
+
+	//assign keeps the capacity, so once the world's stopped growing this doesn't touch the heap
+	mFrameStartLocationX.assign( mLocationX.begin(), mLocationX.end() );
+	mFrameStartLocationY.assign( mLocationY.begin(), mLocationY.end() );
+	mFrameStartEntries.resize( count );
+
+	for( uint32_t i = 0; i < count; ++i )
+	{
+		GameObject* owner = mOwners[ i ];
+		RoboCat* cat = owner->GetAsCat();
+
+		FrameStartEntry& entry = mFrameStartEntries[ i ];
+		entry.mVelocity = cat ? cat->GetVelocity() : GetVelocity( i );
+		entry.mCollisionRadius = mCollisionRadius[ i ];
+		entry.mHandle = owner->GetHandle();
+		entry.mIsCat = cat != nullptr;
+		entry.mDoesWantToDie = owner->DoesWantToDie();
+	}
+}
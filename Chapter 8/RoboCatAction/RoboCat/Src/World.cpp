@@ -1,16 +1,28 @@
 #include <RoboCatPCH.h>
 
+namespace
+{
+	//objects per job- small worlds come in under this and never leave the main thread
+	const uint32_t kParallelUpdateGrainSize = 16;
+	//a busy match's cats, mice and yarn all fit, so a firefight doesn't grow the arrays mid frame
+	const uint32_t kInitialObjectCapacity = 256;
+
+	std::unique_ptr< World >	sProgramWorld;
+}
 
 
-std::unique_ptr< World >	World::sInstance;
+ROBOCAT_THREAD_LOCAL World*	World::sInstance = nullptr;
 
 void World::StaticInit()
 {
-	sInstance.reset( new World() );
+	sProgramWorld.reset( new World() );
+	sInstance = sProgramWorld.get();
 }
 
 World::World()
 {
+	mTransformStore.Reserve( kInitialObjectCapacity );
+	mGameObjects.reserve( kInitialObjectCapacity );
 }
 
 
@@ -21,14 +33,14 @@ void World::AddGameObject( GameObjectPtr inGameObject )
 }
 
 
-void World::RemoveGameObject( GameObjectPtr inGameObject )
+void World::RemoveGameObject( GameObject* inGameObject )
 {
 	int index = inGameObject->GetIndexInWorld();
 
 	int lastIndex = mGameObjects.size() - 1;
 	if( index != lastIndex )
 	{
-		mGameObjects[ index ] = mGameObjects[ lastIndex ];
+		mGameObjects[ index ] = std::move( mGameObjects[ lastIndex ] );
 		mGameObjects[ index ]->SetIndexInWorld( index );
 	}
 
@@ -40,11 +52,30 @@ void World::RemoveGameObject( GameObjectPtr inGameObject )
 
 void World::Update()
 {
-	//update all game objects- sometimes they want to die, so we need to tread carefully...
+	//move everything that has a velocity in one pass, then let objects do their own thing
+	mTransformStore.Integrate( Timing::sInstance.GetDeltaTime() );
+
+	//everyone simulates their own state side by side first. objects don't touch each other in here, and only look at each other
+	//as they were right now, so the result is the same whichever threads pick up whichever objects
+	mTransformStore.CaptureFrameStart();
+	JobSystem::sInstance->ParallelFor( static_cast< uint32_t >( mGameObjects.size() ), kParallelUpdateGrainSize, [ this ]( uint32_t inBegin, uint32_t inEnd )
+	{
+		for( uint32_t i = inBegin; i < inEnd; ++i )
+		{
+			GameObject* go = mGameObjects[ i ].get();
+			if( !go->DoesWantToDie() )
+			{
+				go->ParallelUpdate();
+			}
+		}
+	} );
+
+	//then update all game objects in order, which is where they get to affect each other- sometimes they want to die, so we need to tread carefully...
 
+	//a raw pointer is enough while the object's still in the world- no need to touch the ref count for everything every frame
 	for( int i = 0, c = mGameObjects.size(); i < c; ++i )
 	{
-		GameObjectPtr go = mGameObjects[ i ];
+		GameObject* go = mGameObjects[ i ].get();
 		
 
 		if( !go->DoesWantToDie() )
@@ -54,6 +85,8 @@ void World::Update()
 		//you might suddenly want to die after your update, so check again
 		if( go->DoesWantToDie() )
 		{
+			//the world's reference may be the last, so hang on to it until the object's done dying
+			GameObjectPtr dyingGameObject = std::move( mGameObjects[ i ] );
 			RemoveGameObject( go );
 			go->HandleDying();
 			--i;
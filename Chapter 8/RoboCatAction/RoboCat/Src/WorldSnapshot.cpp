@@ -0,0 +1,240 @@
+#include "RoboCatPCH.h"
+
+#if !_WIN32
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+namespace
+{
+	//records get used in place, so their layout is the file format- changing these means bumping kVersion
+	static_assert( sizeof( GameObjectSnapshotRecord ) == 64, "GameObjectSnapshotRecord layout changed" );
+	static_assert( sizeof( ScoreBoardSnapshotRecord ) == 64, "ScoreBoardSnapshotRecord layout changed" );
+	static_assert( sizeof( WorldSnapshot::Header ) % 4 == 0, "records after the header must stay 4 byte aligned" );
+
+	bool WriteFile( const string& inPath, const vector< char >& inBuffer )
+	{
+		FILE* file = fopen( inPath.c_str(), "wb" );
+		if( !file )
+		{
+			return false;
+		}
+
+		bool didSucceed = fwrite( inBuffer.data(), 1, inBuffer.size(), file ) == inBuffer.size();
+		didSucceed = fclose( file ) == 0 && didSucceed;
+		return didSucceed;
+	}
+}
+
+WorldSnapshot::WorldSnapshot() :
+	mData( nullptr ),
+	mSize( 0 )
+#if _WIN32
+	,
+	mFile( INVALID_HANDLE_VALUE ),
+	mMapping( nullptr )
+#endif
+{
+}
+
+WorldSnapshot::~WorldSnapshot()
+{
+	Close();
+}
+
+bool WorldSnapshot::Save( const string& inPath, int inNewNetworkId, int inNewPlayerId )
+{
+	const auto& gameObjects = World::sInstance->GetGameObjects();
+	const auto& entries = ScoreBoardManager::sInstance->GetEntries();
+
+	//build the whole image in memory so the file only ever sees one write
+	vector< char > buffer( sizeof( Header ) + gameObjects.size() * sizeof( GameObjectSnapshotRecord ) + entries.size() * sizeof( ScoreBoardSnapshotRecord ) );
+
+	Header* header = reinterpret_cast< Header* >( buffer.data() );
+	header->mMagic = kMagic;
+	header->mVersion = kVersion;
+	header->mHeaderSize = sizeof( Header );
+	header->mObjectRecordSize = sizeof( GameObjectSnapshotRecord );
+	header->mScoreBoardRecordSize = sizeof( ScoreBoardSnapshotRecord );
+	header->mObjectCount = static_cast< uint32_t >( gameObjects.size() );
+	header->mScoreBoardEntryCount = static_cast< uint32_t >( entries.size() );
+	header->mNewNetworkId = inNewNetworkId;
+	header->mNewPlayerId = inNewPlayerId;
+
+	GameObjectSnapshotRecord* objectRecord = reinterpret_cast< GameObjectSnapshotRecord* >( header + 1 );
+	for( const GameObjectPtr& gameObject : gameObjects )
+	{
+		gameObject->WriteSnapshot( *objectRecord );
+		++objectRecord;
+	}
+
+	ScoreBoardSnapshotRecord* scoreBoardRecord = reinterpret_cast< ScoreBoardSnapshotRecord* >( objectRecord );
+	for( const ScoreBoardManager::Entry& entry : entries )
+	{
+		scoreBoardRecord->mPlayerId = entry.GetPlayerId();
+		scoreBoardRecord->mScore = entry.GetScore();
+		scoreBoardRecord->mColor = entry.GetColor();
+		//the buffer started zeroed, so the terminator's already there
+		strncpy( scoreBoardRecord->mName, entry.GetPlayerName().c_str(), ScoreBoardSnapshotRecord::kMaxNameLength );
+		++scoreBoardRecord;
+	}
+
+	string tempPath = inPath + ".tmp";
+	if( !WriteFile( tempPath, buffer ) )
+	{
+		LOG( "Couldn't write world snapshot to %s", tempPath.c_str() );
+		return false;
+	}
+
+#if _WIN32
+	bool didSucceed = MoveFileExA( tempPath.c_str(), inPath.c_str(), MOVEFILE_REPLACE_EXISTING ) != 0;
+#else
+	bool didSucceed = rename( tempPath.c_str(), inPath.c_str() ) == 0;
+#endif
+	if( !didSucceed )
+	{
+		LOG( "Couldn't move world snapshot into place at %s", inPath.c_str() );
+	}
+
+	return didSucceed;
+}
+
+bool WorldSnapshot::Open( const string& inPath )
+{
+	Close();
+
+#if _WIN32
+	mFile = CreateFileA( inPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+	if( mFile == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if( !GetFileSizeEx( mFile, &fileSize ) || fileSize.QuadPart < static_cast< LONGLONG >( sizeof( Header ) ) )
+	{
+		LOG( "World snapshot %s is too small", inPath.c_str() );
+		Close();
+		return false;
+	}
+
+	mMapping = CreateFileMappingA( mFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	mData = mMapping ? static_cast< const char* >( MapViewOfFile( mMapping, FILE_MAP_READ, 0, 0, 0 ) ) : nullptr;
+	mSize = static_cast< size_t >( fileSize.QuadPart );
+#else
+	int file = open( inPath.c_str(), O_RDONLY );
+	if( file < 0 )
+	{
+		return false;
+	}
+
+	struct stat fileStats;
+	if( fstat( file, &fileStats ) != 0 || fileStats.st_size < static_cast< off_t >( sizeof( Header ) ) )
+	{
+		LOG( "World snapshot %s is too small", inPath.c_str() );
+		close( file );
+		return false;
+	}
+
+	//the mapping keeps its own reference to the file, so we're done with the descriptor either way
+	mSize = static_cast< size_t >( fileStats.st_size );
+	void* data = mmap( nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0 );
+	close( file );
+	mData = data != MAP_FAILED ? static_cast< const char* >( data ) : nullptr;
+#endif
+
+	if( !mData )
+	{
+		LOG( "Couldn't map world snapshot %s", inPath.c_str() );
+		Close();
+		return false;
+	}
+
+	if( !IsValid( inPath ) )
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void WorldSnapshot::Close()
+{
+#if _WIN32
+	if( mData )
+	{
+		UnmapViewOfFile( mData );
+	}
+	if( mMapping )
+	{
+		CloseHandle( mMapping );
+		mMapping = nullptr;
+	}
+	if( mFile != INVALID_HANDLE_VALUE )
+	{
+		CloseHandle( mFile );
+		mFile = INVALID_HANDLE_VALUE;
+	}
+#else
+	if( mData )
+	{
+		munmap( const_cast< char* >( mData ), mSize );
+	}
+#endif
+
+	mData = nullptr;
+	mSize = 0;
+}
+
+bool WorldSnapshot::IsValid( const string& inPath ) const
+{
+	const Header& header = GetHeader();
+	if( header.mMagic != kMagic )
+	{
+		if( header.mMagic == ByteSwap( kMagic ) )
+		{
+			LOG( "World snapshot %s was saved with the other byte order", inPath.c_str() );
+		}
+		else
+		{
+			LOG( "%s isn't a world snapshot", inPath.c_str() );
+		}
+		return false;
+	}
+
+	if( header.mVersion != kVersion ||
+		header.mHeaderSize != sizeof( Header ) ||
+		header.mObjectRecordSize != sizeof( GameObjectSnapshotRecord ) ||
+		header.mScoreBoardRecordSize != sizeof( ScoreBoardSnapshotRecord ) )
+	{
+		LOG( "World snapshot %s is version %d, expected %d", inPath.c_str(), header.mVersion, kVersion );
+		return false;
+	}
+
+	//64 bit math so a corrupt count can't wrap around and pass
+	uint64_t expectedSize = static_cast< uint64_t >( header.mHeaderSize ) +
+		static_cast< uint64_t >( header.mObjectCount ) * header.mObjectRecordSize +
+		static_cast< uint64_t >( header.mScoreBoardEntryCount ) * header.mScoreBoardRecordSize;
+	if( expectedSize != mSize )
+	{
+		LOG( "World snapshot %s is truncated", inPath.c_str() );
+		return false;
+	}
+
+	return true;
+}
+
+void WorldSnapshot::RestoreScoreBoard() const
+{
+	const ScoreBoardSnapshotRecord* records = GetScoreBoardRecords();
+	for( uint32_t i = 0, c = GetHeader().mScoreBoardEntryCount; i < c; ++i )
+	{
+		const ScoreBoardSnapshotRecord& record = records[ i ];
+
+		//don't trust the file to be terminated
+		string name( record.mName, strnlen( record.mName, ScoreBoardSnapshotRecord::kMaxNameLength ) );
+		ScoreBoardManager::sInstance->AddEntry( record.mPlayerId, name, record.mColor );
+		ScoreBoardManager::sInstance->GetEntry( record.mPlayerId )->SetScore( record.mScore );
+	}
+}
@@ -2,8 +2,8 @@
 
 Yarn::Yarn() :
 	mMuzzleSpeed( 3.f ),
-	mVelocity( Vector3::Zero ),
-	mPlayerId( 0 )
+	mPlayerId( 0 ),
+	mShotTick( 0 )
 {
 	SetScale( GetScale() * 0.25f );
 	SetCollisionRadius( 0.125f );
@@ -54,6 +54,7 @@ uint32_t Yarn::Write( OutputMemoryBitStream& inOutputStream, uint32_t inDirtySta
 		inOutputStream.Write( (bool)true );
 
 		inOutputStream.Write( mPlayerId, 8 );
+		inOutputStream.Write( mShotTick );
 
 		writtenState |= EYRS_PlayerId;
 	}
@@ -70,7 +71,7 @@ uint32_t Yarn::Write( OutputMemoryBitStream& inOutputStream, uint32_t inDirtySta
 
 
 
-bool Yarn::HandleCollisionWithCat( RoboCat* inCat )
+void Yarn::HandleCollisionWithCat( RoboCat* inCat )
 {
 	( void ) inCat;
 
@@ -78,29 +79,39 @@ bool Yarn::HandleCollisionWithCat( RoboCat* inCat )
 	
 
 
-	return false;
 }
 
 
 void Yarn::InitFromShooter( RoboCat* inShooter )
+{
+	InitFromShooter( inShooter, inShooter->GetLocation(), inShooter->GetVelocity(), inShooter->GetRotation() );
+}
+
+void Yarn::InitFromShooter( RoboCat* inShooter, const Vector3& inLocation, const Vector3& inVelocity, float inRotation )
 {
 	SetColor( inShooter->GetColor() );
 	SetPlayerId( inShooter->GetPlayerId() );
 
-	Vector3 forward = inShooter->GetForwardVector();
-	SetVelocity( inShooter->GetVelocity() + forward * mMuzzleSpeed );
-	SetLocation( inShooter->GetLocation() /* + forward * 0.55f */ );
+	//same rotation as the shooter, so our forward is theirs
+	SetRotation( inRotation );
 
-	SetRotation( inShooter->GetRotation() );
+	Vector3 forward = GetForwardVector();
+	SetVelocity( inVelocity + forward * mMuzzleSpeed );
+	SetLocation( inLocation /* + forward * 0.55f */ );
 }
 
-void Yarn::Update()
+void Yarn::WriteSnapshot( GameObjectSnapshotRecord& outRecord ) const
 {
-	
-	float deltaTime = Timing::sInstance.GetDeltaTime();
+	GameObject::WriteSnapshot( outRecord );
 
-	SetLocation( GetLocation() + mVelocity * deltaTime );
-	
+	outRecord.mVelocity = GetVelocity();
+	outRecord.mPlayerId = mPlayerId;
+}
+
+void Yarn::ReadSnapshot( const GameObjectSnapshotRecord& inRecord )
+{
+	GameObject::ReadSnapshot( inRecord );
 
-	//we'll let the cats handle the collisions
+	SetVelocity( inRecord.mVelocity );
+	mPlayerId = inRecord.mPlayerId;
 }
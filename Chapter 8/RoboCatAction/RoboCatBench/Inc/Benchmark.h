@@ -0,0 +1,25 @@
+//minimal timing harness- each case runs until it's been going long enough to trust, then reports ns/op and MB/s
+//output is one line per case, so two runs can be diffed to gate a change
+namespace Benchmark
+{
+	//the body does inOpsPerCall operations and returns how many bytes they produced or consumed
+	typedef std::function< uint32_t() >	BenchmarkBody;
+
+	//only cases whose name contains the filter run. empty runs everything
+	void	SetFilter( const string& inFilter );
+
+	void	PrintHeader( const char* inSuiteName );
+	void	Run( const string& inName, uint32_t inOpsPerCall, const BenchmarkBody& inBody );
+
+	//fold results in here so the optimizer can't throw the work away
+	void	Consume( uint32_t inValue );
+}
+
+//suites
+void RunBitStreamBenchmarks();
+void RunRoboMathBenchmarks();
+
+
+//checks that ride along with the benchmarks- they print what went wrong and return false
+bool CheckEntropyCodingRoundTrip();
+bool CheckMoveListRoundTrip();
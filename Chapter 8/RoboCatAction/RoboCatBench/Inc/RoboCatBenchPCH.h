@@ -0,0 +1,5 @@
+#include <RoboCatShared.h>
+
+#include <functional>
+
+#include <Benchmark.h>
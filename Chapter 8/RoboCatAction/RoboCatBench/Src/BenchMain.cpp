@@ -0,0 +1,35 @@
+#include <RoboCatBenchPCH.h>
+
+#if !_WIN32
+const char** __argv;
+int __argc;
+#endif
+
+int main( int argc, const char** argv )
+{
+#if _WIN32
+	( void ) argc;
+	( void ) argv;
+#else
+	__argc = argc;
+	__argv = argv;
+#endif
+
+	//game objects keep their transforms in the world, so there has to be one
+	World::StaticInit();
+	EntropyFieldRegistry::StaticInit();
+
+	//first argument, if any, filters cases by name
+	Benchmark::SetFilter( StringUtils::GetCommandLineArg( 1 ) );
+
+	//correctness first- no point timing coding that doesn't round trip
+	if( !CheckEntropyCodingRoundTrip() || !CheckMoveListRoundTrip() )
+	{
+		return 1;
+	}
+
+	RunBitStreamBenchmarks();
+	RunRoboMathBenchmarks();
+
+	return 0;
+}
@@ -0,0 +1,50 @@
+#include <RoboCatBenchPCH.h>
+
+namespace
+{
+	const double kMinSecondsPerCase = 0.25;
+
+	string sFilter;
+	volatile uint32_t sSink;
+}
+
+void Benchmark::SetFilter( const string& inFilter )
+{
+	sFilter = inFilter;
+}
+
+void Benchmark::PrintHeader( const char* inSuiteName )
+{
+	printf( "\n%-44s %12s %12s\n", inSuiteName, "ns/op", "MB/s" );
+}
+
+void Benchmark::Run( const string& inName, uint32_t inOpsPerCall, const BenchmarkBody& inBody )
+{
+	if( !sFilter.empty() && inName.find( sFilter ) == string::npos )
+	{
+		return;
+	}
+
+	//warm up caches and the allocator before the clock starts
+	inBody();
+
+	uint64_t callCount = 0;
+	uint64_t byteCount = 0;
+	double startTime = Timing::sInstance.GetTime();
+	double elapsed;
+	do
+	{
+		byteCount += inBody();
+		++callCount;
+		elapsed = Timing::sInstance.GetTime() - startTime;
+	}
+	while( elapsed < kMinSecondsPerCase );
+
+	double opCount = static_cast< double >( callCount ) * inOpsPerCall;
+	printf( "%-44s %12.2f %12.1f\n", inName.c_str(), elapsed * 1e9 / opCount, byteCount / elapsed / ( 1024.0 * 1024.0 ) );
+}
+
+void Benchmark::Consume( uint32_t inValue )
+{
+	sSink = sSink + inValue;
+}
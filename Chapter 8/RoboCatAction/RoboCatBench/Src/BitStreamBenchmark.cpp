@@ -0,0 +1,490 @@
+#include <RoboCatBenchPCH.h>
+
+namespace
+{
+	const uint32_t kOpsPerCall = 1024;
+	//start every stream off a byte boundary so nothing gets to take an aligned fast path for free
+	const uint32_t kMisalignBitCount = 3;
+
+	//input streams don't own a buffer handed to them, so keep a copy of what the output stream wrote
+	struct WrittenStream
+	{
+		WrittenStream( const OutputMemoryBitStream& inOutputStream ) :
+			mBuffer( inOutputStream.GetBufferPtr(), inOutputStream.GetBufferPtr() + inOutputStream.GetByteLength() ),
+			mBitLength( inOutputStream.GetBitLength() )
+		{}
+
+		vector< char >	mBuffer;
+		uint32_t		mBitLength;
+	};
+
+	void Misalign( OutputMemoryBitStream& ioStream )
+	{
+		ioStream.WriteBits( static_cast< uint8_t >( 0 ), kMisalignBitCount );
+	}
+
+	void Misalign( InputMemoryBitStream& ioStream )
+	{
+		uint8_t padding;
+		ioStream.ReadBits( padding, kMisalignBitCount );
+	}
+
+	void BenchmarkWriteBits( uint32_t inBitCount )
+	{
+		vector< uint32_t > values( kOpsPerCall );
+		uint32_t mask = inBitCount == 32 ? 0xffffffff : ( 1u << inBitCount ) - 1;
+		for( uint32_t& value : values )
+		{
+			value = static_cast< uint32_t >( rand() ) * 2654435761u & mask;
+		}
+
+		Benchmark::Run( StringUtils::Sprintf( "WriteBits %2d bits unaligned", inBitCount ), kOpsPerCall, [ & ]()
+		{
+			OutputMemoryBitStream stream;
+			Misalign( stream );
+			for( uint32_t value : values )
+			{
+				stream.Write( value, inBitCount );
+			}
+			return stream.GetByteLength();
+		} );
+
+		OutputMemoryBitStream stream;
+		Misalign( stream );
+		for( uint32_t value : values )
+		{
+			stream.Write( value, inBitCount );
+		}
+		WrittenStream written( stream );
+
+		Benchmark::Run( StringUtils::Sprintf( "ReadBits %2d bits unaligned", inBitCount ), kOpsPerCall, [ & ]()
+		{
+			InputMemoryBitStream inputStream( written.mBuffer.data(), written.mBitLength );
+			Misalign( inputStream );
+			uint32_t sum = 0;
+			for( uint32_t i = 0; i < kOpsPerCall; ++i )
+			{
+				uint32_t value = 0;
+				inputStream.Read( value, inBitCount );
+				sum += value;
+			}
+			Benchmark::Consume( sum );
+			return static_cast< uint32_t >( written.mBuffer.size() );
+		} );
+	}
+
+	void BenchmarkVectors()
+	{
+		vector< Vector3 > vectors( kOpsPerCall );
+		for( Vector3& value : vectors )
+		{
+			value = RoboMath::GetRandomVector( Vector3( -100.f, -100.f, -100.f ), Vector3( 100.f, 100.f, 100.f ) );
+		}
+
+		Benchmark::Run( "Write Vector3", kOpsPerCall, [ & ]()
+		{
+			OutputMemoryBitStream stream;
+			Misalign( stream );
+			for( const Vector3& value : vectors )
+			{
+				stream.Write( value );
+			}
+			return stream.GetByteLength();
+		} );
+
+		OutputMemoryBitStream stream;
+		Misalign( stream );
+		for( const Vector3& value : vectors )
+		{
+			stream.Write( value );
+		}
+		WrittenStream written( stream );
+
+		Benchmark::Run( "Read Vector3", kOpsPerCall, [ & ]()
+		{
+			InputMemoryBitStream inputStream( written.mBuffer.data(), written.mBitLength );
+			Misalign( inputStream );
+			float sum = 0.f;
+			for( uint32_t i = 0; i < kOpsPerCall; ++i )
+			{
+				Vector3 value;
+				inputStream.Read( value );
+				sum += value.mX;
+			}
+			Benchmark::Consume( static_cast< uint32_t >( sum ) );
+			return static_cast< uint32_t >( written.mBuffer.size() );
+		} );
+	}
+
+	void BenchmarkQuaternions()
+	{
+		vector< Quaternion > quaternions( kOpsPerCall );
+		for( Quaternion& quaternion : quaternions )
+		{
+			Vector3 axis = RoboMath::GetRandomVector( Vector3( -1.f, -1.f, -1.f ), Vector3( 1.f, 1.f, 1.f ) );
+			axis.Normalize();
+			float halfAngle = RoboMath::GetRandomFloat() * RoboMath::PI;
+			float sinHalfAngle = sinf( halfAngle );
+			quaternion.mX = axis.mX * sinHalfAngle;
+			quaternion.mY = axis.mY * sinHalfAngle;
+			quaternion.mZ = axis.mZ * sinHalfAngle;
+			quaternion.mW = cosf( halfAngle );
+		}
+
+		Benchmark::Run( "Write Quaternion", kOpsPerCall, [ & ]()
+		{
+			OutputMemoryBitStream stream;
+			Misalign( stream );
+			for( const Quaternion& quaternion : quaternions )
+			{
+				stream.Write( quaternion );
+			}
+			return stream.GetByteLength();
+		} );
+
+		OutputMemoryBitStream stream;
+		Misalign( stream );
+		for( const Quaternion& quaternion : quaternions )
+		{
+			stream.Write( quaternion );
+		}
+		WrittenStream written( stream );
+
+		Benchmark::Run( "Read Quaternion", kOpsPerCall, [ & ]()
+		{
+			InputMemoryBitStream inputStream( written.mBuffer.data(), written.mBitLength );
+			Misalign( inputStream );
+			float sum = 0.f;
+			for( uint32_t i = 0; i < kOpsPerCall; ++i )
+			{
+				Quaternion quaternion;
+				inputStream.Read( quaternion );
+				sum += quaternion.mW;
+			}
+			Benchmark::Consume( static_cast< uint32_t >( sum ) );
+			return static_cast< uint32_t >( written.mBuffer.size() );
+		} );
+	}
+
+	void BenchmarkStrings()
+	{
+		vector< string > names( kOpsPerCall );
+		for( uint32_t i = 0; i < kOpsPerCall; ++i )
+		{
+			names[ i ] = StringUtils::Sprintf( "RoboCat Player %d", i );
+		}
+
+		Benchmark::Run( "Write string", kOpsPerCall, [ & ]()
+		{
+			OutputMemoryBitStream stream;
+			Misalign( stream );
+			for( const string& name : names )
+			{
+				stream.Write( name );
+			}
+			return stream.GetByteLength();
+		} );
+
+		OutputMemoryBitStream stream;
+		Misalign( stream );
+		for( const string& name : names )
+		{
+			stream.Write( name );
+		}
+		WrittenStream written( stream );
+
+		Benchmark::Run( "Read string", kOpsPerCall, [ & ]()
+		{
+			InputMemoryBitStream inputStream( written.mBuffer.data(), written.mBitLength );
+			Misalign( inputStream );
+			uint32_t totalLength = 0;
+			string name;
+			for( uint32_t i = 0; i < kOpsPerCall; ++i )
+			{
+				inputStream.Read( name );
+				totalLength += static_cast< uint32_t >( name.size() );
+			}
+			Benchmark::Consume( totalLength );
+			return static_cast< uint32_t >( written.mBuffer.size() );
+		} );
+	}
+
+	void BenchmarkRoboCatWrite()
+	{
+		const uint32_t kCatCount = 64;
+
+		vector< GameObjectPtr > cats;
+		for( uint32_t i = 0; i < kCatCount; ++i )
+		{
+			RoboCat* cat = static_cast< RoboCat* >( RoboCat::StaticCreate() );
+			cat->SetPlayerId( i + 1 );
+			cat->SetLocation( RoboMath::GetRandomVector( Vector3( -10.f, -10.f, 0.f ), Vector3( 10.f, 10.f, 0.f ) ) );
+			cat->SetVelocity( RoboMath::GetRandomVector( Vector3( -5.f, -5.f, 0.f ), Vector3( 5.f, 5.f, 0.f ) ) );
+			cat->SetRotation( RoboMath::GetRandomFloat() * 2.f * RoboMath::PI );
+			cat->SetColor( RoboMath::GetRandomVector( Vector3::Zero, Vector3( 1.f, 1.f, 1.f ) ) );
+			cats.push_back( GameObjectPtr( cat ) );
+		}
+
+		Benchmark::Run( "RoboCat::Write all state", kCatCount, [ & ]()
+		{
+			OutputMemoryBitStream stream;
+			for( const GameObjectPtr& cat : cats )
+			{
+				cat->Write( stream, RoboCat::ECRS_AllState );
+			}
+			return stream.GetByteLength();
+		} );
+
+		Benchmark::Run( "RoboCat::Write pose only", kCatCount, [ & ]()
+		{
+			OutputMemoryBitStream stream;
+			for( const GameObjectPtr& cat : cats )
+			{
+				cat->Write( stream, RoboCat::ECRS_Pose );
+			}
+			return stream.GetByteLength();
+		} );
+	}
+}
+
+bool CheckEntropyCodingRoundTrip()
+{
+	const uint32_t kMouseCount = 16;
+	const uint32_t kPacketCount = 200;
+
+	vector< GameObjectPtr > sentMice;
+	vector< GameObjectPtr > receivedMice;
+	for( uint32_t i = 0; i < kMouseCount; ++i )
+	{
+		sentMice.push_back( GameObjectPtr( Mouse::StaticCreate() ) );
+		receivedMice.push_back( GameObjectPtr( Mouse::StaticCreate() ) );
+	}
+
+	EntropyCodingContext serverContext;
+	EntropyCodingContext clientContext;
+
+	//every fifth packet goes missing, and each ack only gets back to the server as the next packet goes out
+	int unackedSequenceNumber = -1;
+	for( uint32_t packet = 0; packet < kPacketCount; ++packet )
+	{
+		PacketSequenceNumber sequenceNumber = static_cast< PacketSequenceNumber >( packet );
+		bool isLost = packet % 5 == 3;
+
+		if( unackedSequenceNumber >= 0 )
+		{
+			serverContext.HandlePacketDelivered( static_cast< PacketSequenceNumber >( unackedSequenceNumber ) );
+			unackedSequenceNumber = -1;
+		}
+
+		//nothing, pose, color and both in turn, so every state gets coded after every other state being skipped
+		uint32_t dirtyStates[ kMouseCount ];
+		for( uint32_t i = 0; i < kMouseCount; ++i )
+		{
+			dirtyStates[ i ] = ( packet + i ) % 4;
+			GameObject* mouse = sentMice[ i ].get();
+			if( dirtyStates[ i ] & Mouse::EMRS_Pose )
+			{
+				mouse->SetLocation( RoboMath::GetRandomVector( Vector3( -10.f, -10.f, 0.f ), Vector3( 10.f, 10.f, 0.f ) ) );
+				mouse->SetRotation( RoboMath::GetRandomFloat() * 2.f * RoboMath::PI );
+			}
+			if( dirtyStates[ i ] & Mouse::EMRS_Color )
+			{
+				mouse->SetColor( RoboMath::GetRandomVector( Vector3::Zero, Vector3( 1.f, 1.f, 1.f ) ) );
+			}
+		}
+
+		OutputMemoryBitStream stream;
+		InFlightPacket inFlightPacket( sequenceNumber );
+		serverContext.BeginEncoding( stream, &inFlightPacket );
+		for( uint32_t i = 0; i < kMouseCount; ++i )
+		{
+			stream.BeginEntropyCodedObject( Mouse::kClassId );
+			sentMice[ i ]->Write( stream, dirtyStates[ i ] );
+		}
+		serverContext.EndEncoding( stream );
+
+		if( isLost )
+		{
+			continue;
+		}
+
+		WrittenStream written( stream );
+		InputMemoryBitStream inputStream( written.mBuffer.data(), written.mBitLength );
+		if( !clientContext.BeginDecoding( inputStream, sequenceNumber ) )
+		{
+			printf( "Entropy coding round trip FAILED: couldn't rebuild the models for packet %d\n", packet );
+			return false;
+		}
+		for( uint32_t i = 0; i < kMouseCount; ++i )
+		{
+			inputStream.BeginEntropyCodedObject( Mouse::kClassId );
+			receivedMice[ i ]->Read( inputStream );
+		}
+		clientContext.EndDecoding( inputStream );
+
+		for( uint32_t i = 0; i < kMouseCount; ++i )
+		{
+			const GameObject* sent = sentMice[ i ].get();
+			const GameObject* received = receivedMice[ i ].get();
+			bool isPoseOk = !( dirtyStates[ i ] & Mouse::EMRS_Pose ) ||
+				( sent->GetLocation().mX == received->GetLocation().mX && sent->GetLocation().mY == received->GetLocation().mY && sent->GetRotation() == received->GetRotation() );
+			bool isColorOk = !( dirtyStates[ i ] & Mouse::EMRS_Color ) ||
+				( sent->GetColor().mX == received->GetColor().mX && sent->GetColor().mY == received->GetColor().mY && sent->GetColor().mZ == received->GetColor().mZ );
+			if( !isPoseOk || !isColorOk )
+			{
+				printf( "Entropy coding round trip FAILED: mouse %d came out different in packet %d\n", i, packet );
+				return false;
+			}
+		}
+
+		unackedSequenceNumber = packet;
+	}
+
+	//a server that thinks a lost packet got through codes the next one against models the client never had
+	if( unackedSequenceNumber >= 0 )
+	{
+		serverContext.HandlePacketDelivered( static_cast< PacketSequenceNumber >( unackedSequenceNumber ) );
+	}
+	for( uint32_t packet = kPacketCount; packet < kPacketCount + 2; ++packet )
+	{
+		PacketSequenceNumber sequenceNumber = static_cast< PacketSequenceNumber >( packet );
+		OutputMemoryBitStream stream;
+		InFlightPacket inFlightPacket( sequenceNumber );
+		serverContext.BeginEncoding( stream, &inFlightPacket );
+		stream.BeginEntropyCodedObject( Mouse::kClassId );
+		sentMice[ 0 ]->Write( stream, Mouse::EMRS_AllState );
+		serverContext.EndEncoding( stream );
+
+		if( packet == kPacketCount )
+		{
+			serverContext.HandlePacketDelivered( sequenceNumber );
+			continue;
+		}
+
+		WrittenStream written( stream );
+		InputMemoryBitStream inputStream( written.mBuffer.data(), written.mBitLength );
+		if( clientContext.BeginDecoding( inputStream, sequenceNumber ) )
+		{
+			printf( "Entropy coding round trip FAILED: decoded packet %d against a baseline the client never saw\n", packet );
+			return false;
+		}
+	}
+
+	printf( "Entropy coding round trip ok\n" );
+	return true;
+}
+
+namespace
+{
+	//writes inSent from inFirstTick on, reads it into ioReceived and checks ioReceived now ends with inSent's moves from inFirstSentIndex on
+	bool IsMoveListRoundTripOk( const char* inCaseName, const MoveList& inSent, uint32_t inFirstTick, uint32_t inFirstSentIndex, MoveList& ioReceived )
+	{
+		OutputMemoryBitStream stream;
+		inSent.Write( stream, inFirstTick );
+		WrittenStream written( stream );
+		InputMemoryBitStream inputStream( written.mBuffer.data(), written.mBitLength );
+		ioReceived.ReadAndAddNewMoves( inputStream );
+
+		uint32_t expectedCount = inSent.GetMoveCount() - inFirstSentIndex;
+		if( static_cast< uint32_t >( ioReceived.GetMoveCount() ) < expectedCount )
+		{
+			printf( "Move list round trip FAILED: %s got %d moves, wanted %d\n", inCaseName, ioReceived.GetMoveCount(), expectedCount );
+			return false;
+		}
+
+		uint32_t firstReceivedIndex = ioReceived.GetMoveCount() - expectedCount;
+		for( uint32_t i = 0; i < expectedCount; ++i )
+		{
+			const Move& sent = inSent.GetMove( inFirstSentIndex + i );
+			const Move& received = ioReceived.GetMove( firstReceivedIndex + i );
+			//the very first move a list ever gets has no time, so there's no delta to check on that one
+			bool isDeltaTimeOk = firstReceivedIndex + i == 0 || sent.GetDeltaTime() == received.GetDeltaTime();
+			if( sent.GetTick() != received.GetTick() || !( sent.GetInputState() == received.GetInputState() ) || !isDeltaTimeOk )
+			{
+				printf( "Move list round trip FAILED: %s move %d came out different\n", inCaseName, i );
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+bool CheckMoveListRoundTrip()
+{
+	const InputState kInputStates[] = { InputState( 0.f, 1.f, false ), InputState( -1.f, 1.f, true ), InputState( 1.f, 0.f, false ), InputState( 0.f, -1.f, true ) };
+
+	//steps either side of the 6 bit short form, and a 40 move run of the same input that has to be split into runs of 16
+	MoveList sent;
+	uint32_t tick = 1000;
+	const uint32_t kTickSteps[] = { 1, 33, 64, 65, 250000 };
+	for( uint32_t i = 0; i < 50; ++i )
+	{
+		tick += kTickSteps[ i % 5 ];
+		sent.AddMoveIfNew( kInputStates[ i < 40 ? 0 : i % 4 ], tick );
+	}
+	MoveList received;
+	if( !IsMoveListRoundTripOk( "tick steps and long runs", sent, 0, 0, received ) )
+	{
+		return false;
+	}
+
+	//sending the same moves again adds nothing
+	OutputMemoryBitStream resentStream;
+	sent.Write( resentStream, 0 );
+	WrittenStream resent( resentStream );
+	InputMemoryBitStream resentInputStream( resent.mBuffer.data(), resent.mBitLength );
+	if( received.ReadAndAddNewMoves( resentInputStream ) || received.GetMoveCount() != sent.GetMoveCount() )
+	{
+		printf( "Move list round trip FAILED: resent moves got added again\n" );
+		return false;
+	}
+
+	//more pending than a packet holds- only the newest kMaxMovesPerPacket go
+	const uint32_t kPendingMoveCount = 100;
+	MoveList pending;
+	for( uint32_t i = 0; i < kPendingMoveCount; ++i )
+	{
+		pending.AddMoveIfNew( kInputStates[ ( i / 3 ) % 4 ], 5000 + i * 33 );
+	}
+	MoveList truncated;
+	if( !IsMoveListRoundTripOk( "more than a packet's worth", pending, 0, kPendingMoveCount - MoveList::kMaxMovesPerPacket, truncated ) )
+	{
+		return false;
+	}
+	if( truncated.GetMoveCount() != static_cast< int >( MoveList::kMaxMovesPerPacket ) )
+	{
+		printf( "Move list round trip FAILED: %d moves got through, a packet holds %d\n", truncated.GetMoveCount(), MoveList::kMaxMovesPerPacket );
+		return false;
+	}
+
+	//and a first tick part way through only sends from there on
+	MoveList fromTick;
+	if( !IsMoveListRoundTripOk( "from a first tick", pending, pending.GetMove( 90 ).GetTick(), 90, fromTick ) )
+	{
+		return false;
+	}
+	if( fromTick.GetMoveCount() != 10 )
+	{
+		printf( "Move list round trip FAILED: writing from a first tick sent %d moves, wanted 10\n", fromTick.GetMoveCount() );
+		return false;
+	}
+
+	printf( "Move list round trip ok\n" );
+	return true;
+}
+
+void RunBitStreamBenchmarks()
+{
+	Benchmark::PrintHeader( "MemoryBitStream" );
+
+	for( uint32_t bitCount = 1; bitCount <= 32; ++bitCount )
+	{
+		BenchmarkWriteBits( bitCount );
+	}
+
+	BenchmarkVectors();
+	BenchmarkQuaternions();
+	BenchmarkStrings();
+	BenchmarkRoboCatWrite();
+}
@@ -0,0 +1 @@
+#include <RoboCatBenchPCH.h>
\ No newline at end of file
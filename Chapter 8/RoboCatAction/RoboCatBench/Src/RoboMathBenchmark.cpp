@@ -0,0 +1,159 @@
+#include <RoboCatBenchPCH.h>
+
+namespace
+{
+	const uint32_t kPointCount = 1024;
+	const uint32_t kWorldObjectCount = 1024;
+
+	//the same points twice- one array of vectors for the one at a time math, separate arrays for the batches
+	struct PointSet
+	{
+		PointSet( uint32_t inCount ) :
+			mVectors( inCount ), mXs( inCount ), mYs( inCount ), mZs( inCount )
+		{
+			for( uint32_t i = 0; i < inCount; ++i )
+			{
+				Vector3 point = RoboMath::GetRandomVector( Vector3( -10.f, -10.f, -10.f ), Vector3( 10.f, 10.f, 10.f ) );
+				mVectors[ i ] = point;
+				mXs[ i ] = point.mX;
+				mYs[ i ] = point.mY;
+				mZs[ i ] = point.mZ;
+			}
+		}
+
+		vector< Vector3 >	mVectors;
+		vector< float >		mXs;
+		vector< float >		mYs;
+		vector< float >		mZs;
+	};
+
+	uint32_t Sum( const float* inValues, uint32_t inCount )
+	{
+		float sum = 0.f;
+		for( uint32_t i = 0; i < inCount; ++i )
+		{
+			sum += inValues[ i ];
+		}
+		return static_cast< uint32_t >( sum );
+	}
+
+	void BenchmarkDistanceSq()
+	{
+		PointSet points( kPointCount );
+		Vector3 origin( 1.f, 2.f, 0.f );
+		vector< float > distancesSq( kPointCount );
+
+		Benchmark::Run( "DistanceSq2D one at a time", kPointCount, [ & ]()
+		{
+			for( uint32_t i = 0; i < kPointCount; ++i )
+			{
+				distancesSq[ i ] = ( points.mVectors[ i ] - origin ).LengthSq2D();
+			}
+			Benchmark::Consume( Sum( distancesSq.data(), 4 ) );
+			return static_cast< uint32_t >( kPointCount * sizeof( Vector3 ) );
+		} );
+
+		Benchmark::Run( "DistanceSq2D batch", kPointCount, [ & ]()
+		{
+			RoboMath::DistanceSq2DBatch( origin, points.mXs.data(), points.mYs.data(), kPointCount, distancesSq.data() );
+			Benchmark::Consume( Sum( distancesSq.data(), 4 ) );
+			return static_cast< uint32_t >( kPointCount * 2 * sizeof( float ) );
+		} );
+	}
+
+	void BenchmarkNormalize()
+	{
+		//normalizing is idempotent near enough, so the same points can go round again and again
+		PointSet points( kPointCount );
+
+		Benchmark::Run( "Normalize2D one at a time", kPointCount, [ & ]()
+		{
+			for( Vector3& point : points.mVectors )
+			{
+				point.Normalize2D();
+			}
+			Benchmark::Consume( static_cast< uint32_t >( points.mVectors[ 0 ].mX * 100.f ) );
+			return static_cast< uint32_t >( kPointCount * sizeof( Vector3 ) );
+		} );
+
+		Benchmark::Run( "Normalize2D batch", kPointCount, [ & ]()
+		{
+			RoboMath::Normalize2DBatch( points.mXs.data(), points.mYs.data(), kPointCount );
+			Benchmark::Consume( Sum( points.mXs.data(), 4 ) );
+			return static_cast< uint32_t >( kPointCount * 2 * sizeof( float ) );
+		} );
+
+		Benchmark::Run( "Normalize one at a time", kPointCount, [ & ]()
+		{
+			for( Vector3& point : points.mVectors )
+			{
+				point.Normalize();
+			}
+			Benchmark::Consume( static_cast< uint32_t >( points.mVectors[ 0 ].mX * 100.f ) );
+			return static_cast< uint32_t >( kPointCount * sizeof( Vector3 ) );
+		} );
+
+		Benchmark::Run( "Normalize batch", kPointCount, [ & ]()
+		{
+			RoboMath::NormalizeBatch( points.mXs.data(), points.mYs.data(), points.mZs.data(), kPointCount );
+			Benchmark::Consume( Sum( points.mXs.data(), 4 ) );
+			return static_cast< uint32_t >( kPointCount * 3 * sizeof( float ) );
+		} );
+	}
+
+	void BenchmarkCollisionQuery()
+	{
+		//a world full of mice spread out so nothing actually hits- this is the cost of looking
+		vector< GameObjectPtr > mice;
+		for( uint32_t i = 0; i < kWorldObjectCount; ++i )
+		{
+			GameObjectPtr mouse = MakeGameObjectPtr( Mouse::StaticCreate() );
+			mouse->SetLocation( Vector3( static_cast< float >( i % 32 ) * 2.f + 10.f, static_cast< float >( i / 32 ) * 2.f + 10.f, 0.f ) );
+			World::sInstance->AddGameObject( mouse );
+			mice.push_back( mouse );
+		}
+
+		GameObjectPtr catObject = MakeGameObjectPtr( RoboCat::StaticCreate() );
+		RoboCat* cat = catObject->GetAsCat();
+		//cats collide against where things were at the start of the frame, and nothing moves in here
+		World::sInstance->GetTransformStore().CaptureFrameStart();
+
+		//what ProcessCollisions used to do: chase every object in the world for its location and radius
+		Benchmark::Run( "Cat collision query one at a time", kWorldObjectCount, [ & ]()
+		{
+			Vector3 sourceLocation = cat->GetLocation();
+			float sourceRadius = cat->GetCollisionRadius();
+			uint32_t hitCount = 0;
+			for( const GameObjectPtr& target : World::sInstance->GetGameObjects() )
+			{
+				float collisionDist = sourceRadius + target->GetCollisionRadius();
+				if( ( target->GetLocation() - sourceLocation ).LengthSq2D() < collisionDist * collisionDist )
+				{
+					++hitCount;
+				}
+			}
+			Benchmark::Consume( hitCount );
+			return static_cast< uint32_t >( kWorldObjectCount * 2 * sizeof( float ) );
+		} );
+
+		Benchmark::Run( "Cat collision query batch", kWorldObjectCount, [ & ]()
+		{
+			cat->ProcessCollisions();
+			return static_cast< uint32_t >( kWorldObjectCount * 2 * sizeof( float ) );
+		} );
+
+		for( const GameObjectPtr& mouse : mice )
+		{
+			World::sInstance->RemoveGameObject( mouse.get() );
+		}
+	}
+}
+
+void RunRoboMathBenchmarks()
+{
+	Benchmark::PrintHeader( "RoboMath" );
+
+	BenchmarkDistanceSq();
+	BenchmarkNormalize();
+	BenchmarkCollisionQuery();
+}
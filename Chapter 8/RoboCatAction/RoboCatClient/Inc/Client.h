@@ -10,9 +10,16 @@ protected:
 
 	virtual void	DoFrame() override;
 	virtual void	HandleEvent( SDL_Event* inEvent ) override;
+	virtual int		DoRunLoop() override;
 
 private:
 
+	//input, network and simulation at a fixed rate, so a slow present or a vsync wait can't hold up sampling moves or packets
+	void			RunSimulationLoop();
+
+	//when it's on, this thread just handles events and draws the snapshots the simulation thread hands over
+	bool				mIsSimulationThreaded;
+	std::atomic< bool >	mIsSimulationRunning;
 
 
 };
\ No newline at end of file
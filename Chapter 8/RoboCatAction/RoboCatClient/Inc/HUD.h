@@ -9,7 +9,9 @@ public:
 	static void StaticInit();
 	static std::unique_ptr< HUD >	sInstance;
 
-	void Render();
+	//copies what the hud shows into the snapshot, on the simulation's side
+	void CaptureSnapshot( RenderSnapshot& ioSnapshot ) const;
+	void Render( const RenderSnapshot& inSnapshot );
 
 	void			SetPlayerHealth( int inHealth )	{ mHealth = inHealth; }
 
@@ -17,10 +19,10 @@ private:
 
 	HUD();
 
-	void	RenderBandWidth();
-	void	RenderRoundTripTime();
-	void	RenderScoreBoard();
-	void	RenderHealth();
+	void	RenderBandWidth( const RenderSnapshot& inSnapshot );
+	void	RenderRoundTripTime( const RenderSnapshot& inSnapshot );
+	void	RenderScoreBoard( const RenderSnapshot& inSnapshot );
+	void	RenderHealth( const RenderSnapshot& inSnapshot );
 	void	RenderText( const string& inStr, const Vector3& origin, const Vector3& inColor );
 
 	Vector3										mBandwidthOrigin;
@@ -9,7 +9,8 @@ public:
 
 	void HandleInput( EInputAction inInputAction, int inKeyCode );
 
-	const InputState& GetState()	const	{ return mCurrentState; }
+	//a copy- keys can come in on another thread while the simulation's sampling
+	InputState		GetState();
 
 	MoveList&			GetMoveList()		{ return mMoveList; }
 
@@ -20,6 +21,7 @@ public:
 private:
 
 	InputState							mCurrentState;
+	std::mutex							mCurrentStateMutex;
 
 	InputManager();
 
@@ -1,7 +1,7 @@
 class MouseClient : public Mouse
 {
 public:
-	static	GameObjectPtr	StaticCreate()		{ return GameObjectPtr( new MouseClient() ); }
+	static	GameObjectPtr	StaticCreate()		{ return MakeGameObjectPtr( new MouseClient() ); }
 
 protected:
 	MouseClient();
@@ -23,6 +23,12 @@ public:
 			float									GetRoundTripTime()		const	{ return mAvgRoundTripTime.GetValue(); }
 			int		GetPlayerId()											const	{ return mPlayerId; }
 			float	GetLastMoveProcessedByServerTimestamp()					const	{ return mLastMoveProcessedByServerTimestamp; }
+
+			const	ServerClock&	GetServerClock()						const	{ return mServerClock; }
+
+			//yarn we fired ourselves, waiting for the server's copy to turn up and take it over
+			void		AddPredictedYarn( YarnClient* inYarn );
+			YarnClient*	TakePredictedYarn( uint32_t inShotTick );
 private:
 			NetworkManagerClient();
 			void Init( const SocketAddress& inServerAddress, const string& inName );
@@ -39,13 +45,16 @@ private:
 
 			void	UpdateSendingInputPacket();
 			void	SendInputPacket();
+			void	UpdateInputRedundancy();
 
-			void	DestroyGameObjectsInMap( const IntToGameObjectMap& inObjectsToDestroy );
+			void	DestroyGameObjectsInMap( const FrameIntToGameObjectMap& inObjectsToDestroy );
 
 
 	
 	DeliveryNotificationManager	mDeliveryNotificationManager;
 	ReplicationManagerClient	mReplicationManagerClient;
+	EntropyCodingContext		mEntropyCodingContext;
+	ServerClock					mServerClock;
 
 	SocketAddress		mServerAddress;
 
@@ -54,11 +63,26 @@ private:
 	float				mTimeOfLastHello;
 	float				mTimeOfLastInputPacket;
 
+	//each move goes out in this many input packets, or until the server says it's had it, whichever's first
+	static const uint32_t	kMaxInputRedundancy = 5;
+	uint32_t			mInputRedundancy;
+	//the first tick new to each of the last few input packets, newest first
+	uint32_t			mInputPacketFirstTicks[ kMaxInputRedundancy ];
+	uint32_t			mNextUnsentMoveTick;
+
+	float				mIncomingLossRate;
+	uint32_t			mReceivedPacketCountAtLossSample;
+	uint32_t			mMissedPacketCountAtLossSample;
+
 	string				mName;
 	int					mPlayerId;
+	uint32_t			mConnectionId;
 
 	float				mLastMoveProcessedByServerTimestamp;
 
+	//only ever a handful- a shot's only waiting for a round trip
+	vector< GameObjectHandle >	mPredictedYarns;
+
 	WeightedTimedMovingAverage	mAvgRoundTripTime;
 	float						mLastRoundTripTime;
 
@@ -7,8 +7,12 @@ public:
 	static void StaticInit();
 	static std::unique_ptr< RenderManager >	sInstance;
 
+	//the simulation fills the next snapshot from the components and the hud, and hands it over.
+	//it never waits on drawing- if the last one hasn't been drawn yet, this one replaces it
+	void CaptureSnapshot();
+	//draws the newest snapshot, or the one before again if there's nothing new
 	void Render();
-	void RenderComponents();
+	bool HasNewSnapshot();
 
 	//vert inefficient method of tracking scene graph...
 	void AddComponent( SpriteComponent* inComponent );
@@ -19,11 +23,23 @@ private:
 
 	RenderManager();
 
+	void RenderSprites( const RenderSnapshot& inSnapshot );
+	void DrawSprite( const RenderSnapshot::Sprite& inSprite );
+
 	//this can't be only place that holds on to component- it has to live inside a GameObject in the world
 	vector< SpriteComponent* >		mComponents;
 
 	SDL_Rect						mViewTransform;
 
+	//one being filled, one being drawn, and the newest finished one waiting in between, so neither side waits on the other.
+	//the indices only change under the lock
+	RenderSnapshot					mSnapshots[ 3 ];
+	uint32_t						mCaptureIndex;
+	uint32_t						mReadyIndex;
+	uint32_t						mRenderIndex;
+	bool							mHasNewSnapshot;
+	std::mutex						mSnapshotMutex;
+
 
 };
 
@@ -0,0 +1,32 @@
+/*
+* everything a frame draws, copied out of the world and the hud. drawing only ever looks at one of these,
+* so it can happen on another thread while the simulation carries on with the next
+*/
+struct RenderSnapshot
+{
+	RenderSnapshot() :
+		mHealth( 0 ),
+		mRoundTripTime( 0.f ),
+		mBytesReceivedPerSecond( 0.f ),
+		mBytesSentPerSecond( 0.f )
+	{}
+
+	struct Sprite
+	{
+		//textures live as long as the texture manager, so there's no need to hold on to them
+		const Texture*	mTexture;
+		Vector3			mLocation;
+		float			mRotation;
+		float			mScale;
+		Vector3			mColor;
+	};
+
+	//cleared and refilled every time, so after the first few frames the vectors have all the room they need
+	vector< Sprite >					mSprites;
+
+	int									mHealth;
+	float								mRoundTripTime;
+	float								mBytesReceivedPerSecond;
+	float								mBytesSentPerSecond;
+	vector< ScoreBoardManager::Entry >	mScoreBoardEntries;
+};
@@ -1,15 +1,14 @@
 class RoboCatClient : public RoboCat
 {
 public:
-	static	GameObjectPtr	StaticCreate()		{ return GameObjectPtr( new RoboCatClient() ); }
+	static	GameObjectPtr	StaticCreate()		{ return MakeGameObjectPtr( new RoboCatClient() ); }
 
 	virtual void Update();
 	virtual void	HandleDying() override;
 
 	virtual void	Read( InputMemoryBitStream& inInputStream ) override;
 
-	void DoClientSidePredictionAfterReplicationForLocalCat( uint32_t inReadState );
-	void DoClientSidePredictionAfterReplicationForRemoteCat( uint32_t inReadState );
+	void DoClientSidePredictionAfterReplicationForLocalCat( uint32_t inReadState, float inOldRotation, const Vector3& inOldLocation, const Vector3& inOldVelocity );
 
 
 
@@ -19,10 +18,34 @@ protected:
 
 private:
 
-	void InterpolateClientSidePrediction( float inOldRotation, const Vector3& inOldLocation, const Vector3& inOldVelocity, bool inIsForRemoteCat );
+	//where we thought the cat would be after one of our moves
+	struct PredictedState
+	{
+		uint32_t	mTick;
+		float		mRotation;
+		Vector3		mLocation;
+		Vector3		mVelocity;
+	};
+
+	void			RecordPredictedState( uint32_t inTick );
+	PredictedState*	FindPredictedState( uint32_t inTick );
+	bool			IsPredictedStateCurrent( const PredictedState& inPredictedState ) const;
+	void			ReplayUnprocessedMoves();
+
+	void InterpolateClientSidePrediction( float inOldRotation, const Vector3& inOldLocation, const Vector3& inOldVelocity );
+
+	//remote cats are drawn a fixed delay behind the newest pose, between poses we've already had
+	void UpdateFromSnapshots();
 
 	float				mTimeLocationBecameOutOfSync;
 	float				mTimeVelocityBecameOutOfSync;
+
+	//one for every move the move list could be holding, newest last
+	PredictedState		mPredictedStates[ MoveList::kCapacity ];
+	uint32_t			mPredictedStateCount;
+	uint32_t			mNextPredictedStateIndex;
 	
+	SnapshotBuffer		mSnapshotBuffer;
+
 	SpriteComponentPtr	mSpriteComponent;
 };
\ No newline at end of file
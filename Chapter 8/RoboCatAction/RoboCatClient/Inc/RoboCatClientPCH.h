@@ -6,11 +6,13 @@
 
 #include <Texture.h>
 #include <TextureManager.h>
+#include <RenderSnapshot.h>
 #include <SpriteComponent.h>
 #include <RenderManager.h>
 #include <GraphicsDriver.h>
 #include <WindowManager.h>
 
+#include <SnapshotBuffer.h>
 #include <RoboCatClient.h>
 #include <MouseClient.h>
 #include <YarnClient.h>
@@ -19,6 +21,7 @@
 
 
 #include <ReplicationManagerClient.h>
+#include <ServerClock.h>
 #include <NetworkManagerClient.h>
 #include <Client.h>
 
@@ -0,0 +1,57 @@
+/*
+* what time it is on the server, ntp style. now and then an input packet carries when we sent it, and the next state packet back
+* says when the server got that and when it sent the reply- four timestamps, which give the round trip without the time the server sat on it,
+* and the offset between the clocks assuming the trip's as long each way. queueing only ever makes a trip longer,
+* so the offset comes from the quickest of the last few. drift is the offset's slope over longer stretches
+*/
+class ServerClock
+{
+public:
+
+	ServerClock();
+
+	//a bit, plus our send time and what we think the offset is whenever a request's due
+	void	WriteRequest( OutputMemoryBitStream& inOutputStream );
+	//every state packet carries the server's send time, and sometimes the answer to one of our requests
+	void	ReadStatePacketTimes( InputMemoryBitStream& inInputStream );
+
+	//until the first answer, it's as though the last state packet took no time at all to get here
+	bool	IsSynchronized()						const	{ return mSampleCount > 0; }
+
+	float	GetServerTime()							const	{ return ToServerTime( Timing::sInstance.GetTimef() ); }
+	float	ToServerTime( float inLocalTime )		const	{ return inLocalTime + mOffset + mDrift * ( inLocalTime - mOffsetLocalTime ); }
+
+	//when the server sent the state packet we read last
+	float	GetStatePacketServerTime()				const	{ return mStatePacketServerTime; }
+	//averaged, without the server's turnaround
+	float	GetRoundTripTime()						const	{ return mRoundTripTime; }
+
+private:
+
+	struct Sample
+	{
+		float	mLocalTime;
+		float	mOffset;
+		float	mRoundTripTime;
+	};
+
+	void	AddSample( const Sample& inSample );
+	void	UpdateDrift( const Sample& inSample );
+
+	static const uint32_t	kSampleCount = 8;
+
+	Sample		mSamples[ kSampleCount ];
+	uint32_t	mSampleCount;
+	uint32_t	mNextSampleIndex;
+
+	float		mOffset;
+	float		mOffsetLocalTime;
+	float		mDrift;
+	//drift's measured between this and an offset far enough after it
+	float		mDriftReferenceOffset;
+	float		mDriftReferenceLocalTime;
+
+	float		mRoundTripTime;
+	float		mStatePacketServerTime;
+	float		mTimeOfLastRequest;
+};
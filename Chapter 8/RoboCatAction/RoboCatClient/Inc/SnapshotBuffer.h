@@ -0,0 +1,40 @@
+/*
+* the last few poses the server sent for an object, stamped with when the server sent them. sampling between two of them blends the pair,
+* so a remote object can be drawn a fixed delay behind the newest pose with nothing to simulate and nothing to correct
+*/
+class SnapshotBuffer
+{
+public:
+
+	struct Snapshot
+	{
+		float	mTime;
+		Vector3	mLocation;
+		Vector3	mVelocity;
+		float	mRotation;
+	};
+
+	SnapshotBuffer() : mFirstSnapshotIndex( 0 ), mSnapshotCount( 0 ) {}
+
+	//anything older than the newest came in out of order, and is dropped
+	void	AddSnapshot( float inTime, const Vector3& inLocation, const Vector3& inVelocity, float inRotation );
+	//false if there's nothing to sample yet. before the oldest it holds there. past the newest, it carries the newest on at its velocity-
+	//the server only sends a new pose when that's drifted too far- for up to kMaxExtrapolationTime, after which it's probably not moving
+	bool	Sample( float inTime, Snapshot& outSnapshot ) const;
+
+	void	Clear()									{ mSnapshotCount = 0; }
+
+private:
+
+	//a power of two, so wrapping round is a mask
+	static const uint32_t	kCapacity = 16;
+
+	static const float		kMaxExtrapolationTime;
+
+	//0 is the oldest
+	const Snapshot&	GetSnapshot( uint32_t inIndex ) const	{ return mSnapshots[ ( mFirstSnapshotIndex + inIndex ) & ( kCapacity - 1 ) ]; }
+
+	Snapshot	mSnapshots[ kCapacity ];
+	uint32_t	mFirstSnapshotIndex;
+	uint32_t	mSnapshotCount;
+};
@@ -5,7 +5,8 @@ public:
 	SpriteComponent( GameObject* inGameObject );
 	~SpriteComponent();
 
-	virtual void		Draw( const SDL_Rect& inViewTransform );
+	//where and how the game object's to be drawn, as of now
+	virtual void		AddToSnapshot( RenderSnapshot& ioSnapshot ) const;
 
 			void		SetTexture( TexturePtr inTexture )			{ mTexture = inTexture; }
 
@@ -1,15 +1,24 @@
 class YarnClient : public Yarn
 {
 public:
-	static	GameObjectPtr	StaticCreate()		{ return GameObjectPtr( new YarnClient() ); }
+	static	GameObjectPtr	StaticCreate()		{ return MakeGameObjectPtr( new YarnClient() ); }
 
 	virtual void		Read( InputMemoryBitStream& inInputStream ) override;
-	virtual bool		HandleCollisionWithCat( RoboCat* inCat ) override;
+	virtual void		HandleCollisionWithCat( RoboCat* inCat ) override;
+	virtual void		HandleDying() override;
+
+	//for a shot we've just fired- it flies straight away, and the server's copy takes over from it when that arrives
+	void				InitAsPredicted( RoboCat* inShooter, uint32_t inShotTick );
 
 protected:
 	YarnClient();
 
 private:
 
+	void				TakeOverFromPredictedYarn( YarnClient* inPredictedYarn );
+
 	SpriteComponentPtr	mSpriteComponent;
+
+	//if the server never fires it, it goes away on its own
+	TimerHandle			mPredictionTimeoutTimer;
 };
\ No newline at end of file
@@ -1,5 +1,12 @@
 
 #include <RoboCatClientPCH.h>
+#include <chrono>
+
+namespace
+{
+	//the window's refresh rate doesn't matter any more, so it may as well be quick- moves get sampled within a frame of when they're due
+	const double kSimulationFrameInterval = 1.0 / 120.0;
+}
 
 bool Client::StaticInit( )
 {
@@ -27,7 +34,9 @@ bool Client::StaticInit( )
 	return true;
 }
 
-Client::Client()
+Client::Client() :
+	mIsSimulationThreaded( false ),
+	mIsSimulationRunning( false )
 {
 	GameObjectRegistry::sInstance->RegisterCreationFunction( 'RCAT', RoboCatClient::StaticCreate );
 	GameObjectRegistry::sInstance->RegisterCreationFunction( 'MOUS', MouseClient::StaticCreate );
@@ -40,6 +49,8 @@ Client::Client()
 
 	NetworkManagerClient::StaticInit( *serverAddress, name );
 
+	mIsSimulationThreaded = StringUtils::GetCommandLineArg( 3 ) == "threaded";
+
 	//NetworkManagerClient::sInstance->SetDropPacketChance( 0.6f );
 	//NetworkManagerClient::sInstance->SetSimulatedLatency( 0.25f );
 	//NetworkManagerClient::sInstance->SetSimulatedLatency( 0.5f );
@@ -56,11 +67,90 @@ void Client::DoFrame()
 
 	NetworkManagerClient::sInstance->ProcessIncomingPackets();
 
-	RenderManager::sInstance->Render();
+	RenderManager::sInstance->CaptureSnapshot();
+	//otherwise the main thread draws it whenever it's free
+	if( !mIsSimulationThreaded )
+	{
+		RenderManager::sInstance->Render();
+	}
 
 	NetworkManagerClient::sInstance->SendOutgoingPackets();
 }
 
+int Client::DoRunLoop()
+{
+	if( !mIsSimulationThreaded )
+	{
+		return Engine::DoRunLoop();
+	}
+
+	//the frames' allocation counts are the simulation's business, so nothing this thread does counts against them
+	AllocationPhaseScope phaseScope( EAP_Untracked );
+
+	mIsSimulationRunning = true;
+	std::thread simulationThread( &Client::RunSimulationLoop, this );
+
+	//sdl wants events and drawing on the thread that made the window, so that's this one
+	bool quit = false;
+	SDL_Event event;
+	memset( &event, 0, sizeof( SDL_Event ) );
+
+	while( !quit && ShouldKeepRunning() )
+	{
+		if( SDL_PollEvent( &event ) )
+		{
+			if( event.type == SDL_QUIT )
+			{
+				quit = true;
+			}
+			else
+			{
+				HandleEvent( &event );
+			}
+		}
+		else if( RenderManager::sInstance->HasNewSnapshot() )
+		{
+			RenderManager::sInstance->Render();
+		}
+		else
+		{
+			//nothing new to draw, so wait for an event instead of spinning- but not past the next snapshot
+			SDL_WaitEventTimeout( nullptr, 1 );
+		}
+	}
+
+	mIsSimulationRunning = false;
+	simulationThread.join();
+
+	return event.type;
+}
+
+void Client::RunSimulationLoop()
+{
+	//same world as the main thread
+	JobContextScope contextScope( this );
+
+	BeginFrames();
+
+	double nextFrameTime = Timing::sInstance.GetTime();
+	while( mIsSimulationRunning )
+	{
+		RunFrame();
+
+		//a frame that ran long just pushes the rest back, rather than a burst of short ones to catch up
+		nextFrameTime += kSimulationFrameInterval;
+		double time = Timing::sInstance.GetTime();
+		if( time < nextFrameTime )
+		{
+			std::this_thread::sleep_for( std::chrono::duration< double >( nextFrameTime - time ) );
+		}
+		else
+		{
+			nextFrameTime = time;
+		}
+	}
+}
+
 void Client::HandleEvent( SDL_Event* inEvent )
 {
 	switch( inEvent->type )
@@ -25,42 +25,51 @@ void HUD::StaticInit()
 	sInstance.reset( new HUD() );
 }
 
-void HUD::Render()
+void HUD::CaptureSnapshot( RenderSnapshot& ioSnapshot ) const
 {
-	//RenderBandWidth();
-	RenderRoundTripTime();
-	RenderScoreBoard();
-	RenderHealth();
+	ioSnapshot.mHealth = mHealth;
+	ioSnapshot.mRoundTripTime = NetworkManagerClient::sInstance->GetAvgRoundTripTime().GetValue();
+	ioSnapshot.mBytesReceivedPerSecond = NetworkManagerClient::sInstance->GetBytesReceivedPerSecond().GetValue();
+	ioSnapshot.mBytesSentPerSecond = NetworkManagerClient::sInstance->GetBytesSentPerSecond().GetValue();
+	ioSnapshot.mScoreBoardEntries = ScoreBoardManager::sInstance->GetEntries();
 }
 
-void HUD::RenderHealth()
+void HUD::Render( const RenderSnapshot& inSnapshot )
 {
-	if( mHealth > 0 )
+	//RenderBandWidth( inSnapshot );
+	RenderRoundTripTime( inSnapshot );
+	RenderScoreBoard( inSnapshot );
+	RenderHealth( inSnapshot );
+}
+
+void HUD::RenderHealth( const RenderSnapshot& inSnapshot )
+{
+	if( inSnapshot.mHealth > 0 )
 	{
-		string healthString = StringUtils::Sprintf( "Health %d", mHealth );
+		string healthString = StringUtils::Sprintf( "Health %d", inSnapshot.mHealth );
 		RenderText( healthString, mHealthOffset, Colors::Red );
 	}
 }
 
-void HUD::RenderBandWidth()
+void HUD::RenderBandWidth( const RenderSnapshot& inSnapshot )
 {
 	string bandwidth = StringUtils::Sprintf( "In %d  Bps, Out %d Bps",
-												static_cast< int >( NetworkManagerClient::sInstance->GetBytesReceivedPerSecond().GetValue() ),
-												static_cast< int >( NetworkManagerClient::sInstance->GetBytesSentPerSecond().GetValue() ) );
+												static_cast< int >( inSnapshot.mBytesReceivedPerSecond ),
+												static_cast< int >( inSnapshot.mBytesSentPerSecond ) );
 	RenderText( bandwidth, mBandwidthOrigin, Colors::White );
 }
 
-void HUD::RenderRoundTripTime()
+void HUD::RenderRoundTripTime( const RenderSnapshot& inSnapshot )
 {
-	float rttMS = NetworkManagerClient::sInstance->GetAvgRoundTripTime().GetValue() * 1000.f;
+	float rttMS = inSnapshot.mRoundTripTime * 1000.f;
 
 	string roundTripTime = StringUtils::Sprintf( "RTT %d ms", ( int ) rttMS  );
 	RenderText( roundTripTime, mRoundTripTimeOrigin, Colors::White );
 }
 
-void HUD::RenderScoreBoard()
+void HUD::RenderScoreBoard( const RenderSnapshot& inSnapshot )
 {
-	const vector< ScoreBoardManager::Entry >& entries = ScoreBoardManager::sInstance->GetEntries();
+	const vector< ScoreBoardManager::Entry >& entries = inSnapshot.mScoreBoardEntries;
 	Vector3 offset = mScoreBoardOrigin;
 	
 	for( const auto& entry: entries )
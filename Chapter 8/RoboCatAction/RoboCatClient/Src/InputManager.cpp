@@ -42,6 +42,8 @@ namespace
 
 void InputManager::HandleInput( EInputAction inInputAction, int inKeyCode )
 {
+	std::lock_guard< std::mutex > lock( mCurrentStateMutex );
+
 	switch( inKeyCode )
 	{
 	case 'a':
@@ -71,6 +73,12 @@ InputManager::InputManager() :
 
 }
 
+InputState InputManager::GetState()
+{
+	std::lock_guard< std::mutex > lock( mCurrentStateMutex );
+	return mCurrentState;
+}
+
 const Move& InputManager::SampleInputAsMove()
 {
 	return mMoveList.AddMove( GetState(), Timing::sInstance.GetFrameStartTime() );
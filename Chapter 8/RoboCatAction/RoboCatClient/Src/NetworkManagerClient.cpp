@@ -6,13 +6,30 @@ namespace
 {
 	const float kTimeBetweenHellos = 1.f;
 	const float kTimeBetweenInputPackets = 0.033f;
+
+	//enough copies of each move that losing all of them is about a one in a thousand chance. never fewer than two, so one drop never costs a move
+	const uint32_t kMinInputRedundancy = 2;
+	const float kTargetMoveLossChance = 0.001f;
+	//how many incoming packets to count, lost ones included, before taking a new loss reading
+	const uint32_t kPacketsPerLossSample = 30;
 }
 
 NetworkManagerClient::NetworkManagerClient() :
 	mState( NCS_Uninitialized ),
 	mDeliveryNotificationManager( true, false ),
+	mInputRedundancy( kMinInputRedundancy ),
+	mNextUnsentMoveTick( 0 ),
+	mIncomingLossRate( 0.f ),
+	mReceivedPacketCountAtLossSample( 0 ),
+	mMissedPacketCountAtLossSample( 0 ),
+	mConnectionId( 0 ),
+	mLastMoveProcessedByServerTimestamp( -1.f ),
 	mLastRoundTripTime( 0.f )
 {
+	for( uint32_t& firstTick : mInputPacketFirstTicks )
+	{
+		firstTick = 0;
+	}
 }
 
 void NetworkManagerClient::StaticInit( const SocketAddress& inServerAddress, const string& inName )
@@ -35,18 +52,19 @@ void NetworkManagerClient::Init( const SocketAddress& inServerAddress, const str
 
 void NetworkManagerClient::ProcessPacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress )
 {
-	uint32_t	packetType;
-	inInputStream.Read( packetType );
+	uint32_t	packetType = 0;
+	inInputStream.Read( packetType, kPacketTypeBitCount );
 	switch( packetType )
 	{
-	case kWelcomeCC:
+	case kWelcomePacket:
 		HandleWelcomePacket( inInputStream );
 		break;
-	case kStateCC:
+	case kStatePacket:
 		if( mDeliveryNotificationManager.ReadAndProcessState( inInputStream ) )
 		{
 			HandleStatePacket( inInputStream );
 		}
+		UpdateInputRedundancy();
 		break;
 	}
 }
@@ -80,7 +98,7 @@ void NetworkManagerClient::SendHelloPacket()
 {
 	OutputMemoryBitStream helloPacket; 
 
-	helloPacket.Write( kHelloCC );
+	helloPacket.Write( kHelloPacket, kPacketTypeBitCount );
 	helloPacket.Write( mName );
 
 	SendPacket( helloPacket, mServerAddress );
@@ -94,6 +112,8 @@ void NetworkManagerClient::HandleWelcomePacket( InputMemoryBitStream& inInputStr
 		int playerId;
 		inInputStream.Read( playerId );
 		mPlayerId = playerId;
+		//and what to put on everything we send from now on
+		inInputStream.Read( mConnectionId, kConnectionIdBitCount );
 		mState = NCS_Welcomed;
 		LOG( "'%s' was welcomed on client as player %d", mName.c_str(), mPlayerId );
 	}
@@ -106,13 +126,28 @@ void NetworkManagerClient::HandleStatePacket( InputMemoryBitStream& inInputStrea
 	if( mState == NCS_Welcomed )
 	{
 		ReadLastMoveProcessedOnServerTimestamp( inInputStream );
+		mServerClock.ReadStatePacketTimes( inInputStream );
 
 		//old
 		//HandleGameObjectState( inPacketBuffer );
 		HandleScoreBoardState( inInputStream );
 
 		//tell the replication manager to handle the rest...
-		mReplicationManagerClient.Read( inInputStream );
+		bool isEntropyCoded; inInputStream.Read( isEntropyCoded );
+		if( !isEntropyCoded )
+		{
+			mReplicationManagerClient.Read( inInputStream );
+		}
+		else if( mEntropyCodingContext.BeginDecoding( inInputStream, mDeliveryNotificationManager.GetLastReceivedSequenceNumber() ) )
+		{
+			mReplicationManagerClient.Read( inInputStream );
+			mEntropyCodingContext.EndDecoding( inInputStream );
+		}
+		else
+		{
+			//the server mustn't think we got what's in it- no ack means it's resent, and the baseline stays on a packet we did decode
+			mDeliveryNotificationManager.RetractLastAck();
+		}
 	}
 }
 
@@ -136,7 +171,7 @@ void NetworkManagerClient::ReadLastMoveProcessedOnServerTimestamp( InputMemoryBi
 void NetworkManagerClient::HandleGameObjectState( InputMemoryBitStream& inInputStream )
 {
 	//copy the mNetworkIdToGameObjectMap so that anything that doesn't get an updated can be destroyed...
-	IntToGameObjectMap	objectsToDestroy = mNetworkIdToGameObjectMap;
+	FrameIntToGameObjectMap	objectsToDestroy( mNetworkIdToGameObjectMap.begin(), mNetworkIdToGameObjectMap.end() );
 
 	int stateCount;
 	inInputStream.Read( stateCount );
@@ -149,19 +184,19 @@ void NetworkManagerClient::HandleGameObjectState( InputMemoryBitStream& inInputS
 
 			inInputStream.Read( networkId );
 			inInputStream.Read( fourCC );
-			GameObjectPtr go;
+			GameObject* go;
 			auto itGO = mNetworkIdToGameObjectMap.find( networkId );
 			//didn't find it, better create it!
 			if( itGO == mNetworkIdToGameObjectMap.end() )
 			{
-				go = GameObjectRegistry::sInstance->CreateGameObject( fourCC );
+				go = GameObjectRegistry::sInstance->CreateGameObject( fourCC ).get();
 				go->SetNetworkId( networkId );
 				AddToNetworkIdToGameObjectMap( go );
 			}
 			else
 			{
 				//found it
-				go = itGO->second;
+				go = itGO->second.Get();
 			}
 
 			//now we can update into it
@@ -179,11 +214,47 @@ void NetworkManagerClient::HandleScoreBoardState( InputMemoryBitStream& inInputS
 	ScoreBoardManager::sInstance->Read( inInputStream );
 }
  
-void NetworkManagerClient::DestroyGameObjectsInMap( const IntToGameObjectMap& inObjectsToDestroy )
+void NetworkManagerClient::AddPredictedYarn( YarnClient* inYarn )
+{
+	mPredictedYarns.push_back( inYarn->GetHandle() );
+}
+
+YarnClient* NetworkManagerClient::TakePredictedYarn( uint32_t inShotTick )
+{
+	YarnClient* predictedYarn = nullptr;
+
+	//tidy up any that timed out or hit something while we're here
+	for( size_t i = 0; i < mPredictedYarns.size(); )
+	{
+		GameObject* gameObject = mPredictedYarns[ i ].Get();
+		YarnClient* yarn = gameObject && !gameObject->DoesWantToDie() ? static_cast< YarnClient* >( gameObject ) : nullptr;
+		if( yarn && ( predictedYarn || yarn->GetShotTick() != inShotTick ) )
+		{
+			++i;
+		}
+		else
+		{
+			if( yarn )
+			{
+				predictedYarn = yarn;
+			}
+			mPredictedYarns[ i ] = mPredictedYarns.back();
+			mPredictedYarns.pop_back();
+		}
+	}
+
+	return predictedYarn;
+}
+
+void NetworkManagerClient::DestroyGameObjectsInMap( const FrameIntToGameObjectMap& inObjectsToDestroy )
 {
 	for( auto& pair: inObjectsToDestroy )
 	{
-		pair.second->SetDoesWantToDie( true );
+		GameObject* gameObject = pair.second.Get();
+		if( gameObject )
+		{
+			gameObject->SetDoesWantToDie( true );
+		}
 		//and remove from our map!
 		mNetworkIdToGameObjectMap.erase( pair.first );
 	}
@@ -212,28 +283,55 @@ void NetworkManagerClient::SendInputPacket()
 	{
 		OutputMemoryBitStream inputPacket; 
 
-		inputPacket.Write( kInputCC );
+		inputPacket.Write( kInputPacket, kPacketTypeBitCount );
+		inputPacket.Write( mConnectionId, kConnectionIdBitCount );
 
 		mDeliveryNotificationManager.WriteState( inputPacket );
+		mServerClock.WriteRequest( inputPacket );
 
-		//eventually write the 3 latest moves so they have three chances to get through...
-		int moveCount = moveList.GetMoveCount();
-		int firstMoveIndex = moveCount - 3;
-		if( firstMoveIndex < 3 )
+		//this packet's new moves are the ones after what we last sent. along with them go whichever moves from the last few packets
+		//the server hasn't said it's had- the move list lets go of those as soon as it does
+		for( uint32_t i = kMaxInputRedundancy - 1; i > 0; --i )
 		{
-			firstMoveIndex = 0;
+			mInputPacketFirstTicks[ i ] = mInputPacketFirstTicks[ i - 1 ];
 		}
-		auto move = moveList.begin() + firstMoveIndex;
+		mInputPacketFirstTicks[ 0 ] = mNextUnsentMoveTick;
 
-		//only need two bits to write the move count, because it's 0, 1, 2 or 3
-		inputPacket.Write( moveCount - firstMoveIndex, 2 );
-
-		for( ; firstMoveIndex < moveCount; ++firstMoveIndex, ++move )
-		{
-			///would be nice to optimize the time stamp...
-			move->Write( inputPacket );
-		}
+		moveList.Write( inputPacket, mInputPacketFirstTicks[ mInputRedundancy - 1 ] );
+		mNextUnsentMoveTick = moveList.GetLatestMove().GetTick() + 1;
 
 		SendPacket( inputPacket, mServerAddress );
 	}
+}
+
+void NetworkManagerClient::UpdateInputRedundancy()
+{
+	//we never hear what happens to our input packets, so what goes missing on the way here is the best guess for what goes missing on the way there
+	uint32_t receivedCount = mDeliveryNotificationManager.GetReceivedPacketCount() - mReceivedPacketCountAtLossSample;
+	uint32_t missedCount = mDeliveryNotificationManager.GetMissedPacketCount() - mMissedPacketCountAtLossSample;
+	if( receivedCount + missedCount < kPacketsPerLossSample )
+	{
+		return;
+	}
+
+	mReceivedPacketCountAtLossSample += receivedCount;
+	mMissedPacketCountAtLossSample += missedCount;
+
+	//halfway to the new reading, so one bad second doesn't swing it all the way
+	float lossRate = static_cast< float >( missedCount ) / static_cast< float >( receivedCount + missedCount );
+	mIncomingLossRate = ( mIncomingLossRate + lossRate ) * 0.5f;
+
+	uint32_t redundancy = kMinInputRedundancy;
+	float allCopiesLostChance = pow( mIncomingLossRate, static_cast< float >( redundancy ) );
+	while( redundancy < kMaxInputRedundancy && allCopiesLostChance > kTargetMoveLossChance )
+	{
+		++redundancy;
+		allCopiesLostChance *= mIncomingLossRate;
+	}
+
+	if( redundancy != mInputRedundancy )
+	{
+		LOG( "Loss at %d%%, sending each move %d times", static_cast< int >( mIncomingLossRate * 100.f ), redundancy );
+		mInputRedundancy = redundancy;
+	}
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 std::unique_ptr< RenderManager >	RenderManager::sInstance;
 
-RenderManager::RenderManager()
+RenderManager::RenderManager() :
+	mCaptureIndex( 0 ),
+	mReadyIndex( 1 ),
+	mRenderIndex( 2 ),
+	mHasNewSnapshot( false )
 {
 	SDL_Rect viewport = GraphicsDriver::sInstance->GetLogicalViewport();
 
@@ -54,29 +58,86 @@ int RenderManager::GetComponentIndex( SpriteComponent* inComponent ) const
 }
 
 
+void RenderManager::CaptureSnapshot()
+{
+	RenderSnapshot& snapshot = mSnapshots[ mCaptureIndex ];
+
+	snapshot.mSprites.clear();
+	for( const SpriteComponent* component : mComponents )
+	{
+		component->AddToSnapshot( snapshot );
+	}
+
+	HUD::sInstance->CaptureSnapshot( snapshot );
+
+	std::lock_guard< std::mutex > lock( mSnapshotMutex );
+	std::swap( mCaptureIndex, mReadyIndex );
+	mHasNewSnapshot = true;
+}
+
+bool RenderManager::HasNewSnapshot()
+{
+	std::lock_guard< std::mutex > lock( mSnapshotMutex );
+	return mHasNewSnapshot;
+}
+
 //this part that renders the world is really a camera-
 //in a more detailed engine, we'd have a list of cameras, and then render manager would
 //render the cameras in order
-void RenderManager::RenderComponents()
+//one draw call per sprite, since tint and rotation are per texture state here. batching them into one vertex buffer takes
+//SDL_RenderGeometry, which arrived in SDL 2.0.18- the bundled SDL is 2.0.3
+void RenderManager::RenderSprites( const RenderSnapshot& inSnapshot )
 {
-	//Get the logical viewport so we can pass this to the SpriteComponents when it's draw time
-	SDL_Rect viewport = GraphicsDriver::sInstance->GetLogicalViewport();
-	for( auto cIt = mComponents.begin(), end = mComponents.end(); cIt != end; ++cIt )
+	for( const RenderSnapshot::Sprite& sprite : inSnapshot.mSprites )
 	{
-		( *cIt )->Draw( mViewTransform );
+		DrawSprite( sprite );
 	}
 }
 
+void RenderManager::DrawSprite( const RenderSnapshot::Sprite& inSprite )
+{
+	const Texture* texture = inSprite.mTexture;
+
+	// Texture color multiplier
+	Uint8 r = static_cast<Uint8>( inSprite.mColor.mX * 255 );
+	Uint8 g = static_cast<Uint8>( inSprite.mColor.mY * 255 );
+	Uint8 b = static_cast<Uint8>( inSprite.mColor.mZ * 255 );
+	SDL_SetTextureColorMod( texture->GetData(), r, g, b );
+
+	// Compute the destination rectangle
+	SDL_Rect dstRect;
+	dstRect.w = static_cast< int >( texture->GetWidth() * inSprite.mScale );
+	dstRect.h = static_cast< int >( texture->GetHeight() * inSprite.mScale );
+	dstRect.x = static_cast<int>( inSprite.mLocation.mX * mViewTransform.w + mViewTransform.x - dstRect.w / 2 );
+	dstRect.y = static_cast<int>( inSprite.mLocation.mY * mViewTransform.h + mViewTransform.y - dstRect.h / 2 );
+
+	// Blit the texture
+	SDL_RenderCopyEx( GraphicsDriver::sInstance->GetRenderer(), texture->GetData(), nullptr,
+		&dstRect, RoboMath::ToDegrees( inSprite.mRotation ), nullptr, SDL_FLIP_NONE );
+}
+
 void RenderManager::Render()
 {
+	{
+		std::lock_guard< std::mutex > lock( mSnapshotMutex );
+		if( mHasNewSnapshot )
+		{
+			std::swap( mRenderIndex, mReadyIndex );
+			mHasNewSnapshot = false;
+		}
+	}
+
+	//only this thread touches the one being drawn, so there's no need to hold the lock through a slow present
+	const RenderSnapshot& snapshot = mSnapshots[ mRenderIndex ];
+
 	//
     // Clear the back buffer
     //
 	GraphicsDriver::sInstance->Clear();
 	
-	RenderManager::sInstance->RenderComponents();
+	RenderSprites( snapshot );
 
-	HUD::sInstance->Render();
+	HUD::sInstance->Render( snapshot );
 	
 	//
     // Present our back buffer to our front buffer
@@ -3,8 +3,25 @@
 
 void ReplicationManagerClient::Read( InputMemoryBitStream& inInputStream )
 {
-	while( inInputStream.GetRemainingBitCount() >= 32 )
+	bool isEntropyCoded = inInputStream.GetEntropyCodingContext() != nullptr;
+
+	for( ;; )
 	{
+		//range coded streams flag each entry, plain ones just run until there's not enough left for a network id
+		inInputStream.BeginEntropyCodedObject( EntropyFieldRegistry::kReplicationHeaderClassId );
+		if( isEntropyCoded )
+		{
+			bool hasEntry; inInputStream.Read( hasEntry );
+			if( !hasEntry )
+			{
+				break;
+			}
+		}
+		else if( inInputStream.GetRemainingBitCount() < 32 )
+		{
+			break;
+		}
+
 		//read the network id...
 		int networkId; inInputStream.Read( networkId );
 		
@@ -36,11 +53,11 @@ void ReplicationManagerClient::ReadAndDoCreateAction( InputMemoryBitStream& inIn
 
 	//we might already have this object- could happen if our ack of the create got dropped so server resends create request 
 	//( even though we might have created )
-	GameObjectPtr gameObject = NetworkManagerClient::sInstance->GetGameObject( inNetworkId );
+	GameObject* gameObject = NetworkManagerClient::sInstance->GetGameObject( inNetworkId );
 	if( !gameObject )
 	{
 		//create the object and map it...
-		gameObject = GameObjectRegistry::sInstance->CreateGameObject( fourCCName );
+		gameObject = GameObjectRegistry::sInstance->CreateGameObject( fourCCName ).get();
 		gameObject->SetNetworkId( inNetworkId );
 		NetworkManagerClient::sInstance->AddToNetworkIdToGameObjectMap( gameObject );
 		
@@ -49,16 +66,18 @@ void ReplicationManagerClient::ReadAndDoCreateAction( InputMemoryBitStream& inIn
 	}
 
 	//and read state
+	inInputStream.BeginEntropyCodedObject( fourCCName );
 	gameObject->Read( inInputStream );
 }
 
 void ReplicationManagerClient::ReadAndDoUpdateAction( InputMemoryBitStream& inInputStream, int inNetworkId )
 {
 	//need object
-	GameObjectPtr gameObject = NetworkManagerClient::sInstance->GetGameObject( inNetworkId );
+	GameObject* gameObject = NetworkManagerClient::sInstance->GetGameObject( inNetworkId );
 
 	//gameObject MUST be found, because create was ack'd if we're getting an update...
 	//and read state
+	inInputStream.BeginEntropyCodedObject( gameObject->GetClassId() );
 	gameObject->Read( inInputStream );
 }
 
@@ -66,7 +85,7 @@ void ReplicationManagerClient::ReadAndDoDestroyAction( InputMemoryBitStream& inI
 {
 	//if something was destroyed before the create went through, we'll never get it
 	//but we might get the destroy request, so be tolerant of being asked to destroy something that wasn't created
-	GameObjectPtr gameObject = NetworkManagerClient::sInstance->GetGameObject( inNetworkId );
+	GameObject* gameObject = NetworkManagerClient::sInstance->GetGameObject( inNetworkId );
 	if( gameObject )
 	{
 		gameObject->SetDoesWantToDie( true );
@@ -1,10 +1,18 @@
 #include <RoboCatClientPCH.h>
 
-
+namespace
+{
+	//how far the server can be from what we predicted before it's worth replaying our moves on top of what it says
+	const float kPredictionLocationTolerance = 0.01f;
+	const float kPredictionVelocityTolerance = 0.01f;
+	const float kPredictionRotationTolerance = 0.001f;
+}
 
 RoboCatClient::RoboCatClient() :
 	mTimeLocationBecameOutOfSync( 0.f ),
-	mTimeVelocityBecameOutOfSync( 0.f )
+	mTimeVelocityBecameOutOfSync( 0.f ),
+	mPredictedStateCount( 0 ),
+	mNextPredictedStateIndex( 0 )
 {
 	mSpriteComponent.reset( new SpriteComponent( this ) );
 	mSpriteComponent->SetTexture( TextureManager::sInstance->GetTexture( "cat" ) );
@@ -40,19 +48,23 @@ void RoboCatClient::Update()
 			//and simulate!
 
 			SimulateMovement( deltaTime );
+			HandleTouchedObjects();
+
+			RecordPredictedState( pendingMove->GetTick() );
+
+			//the server shoots on the same moves we do, so there's no need to wait to hear about it
+			if( TryShoot( pendingMove->GetTick() ) )
+			{
+				YarnClient* yarn = static_cast< YarnClient* >( GameObjectRegistry::sInstance->CreateGameObject( 'YARN' ).get() );
+				yarn->InitAsPredicted( this, pendingMove->GetTick() );
+			}
 			
 			//LOG( "Client Move Time: %3.4f deltaTime: %3.4f left rot at %3.4f", latestMove.GetTimestamp(), deltaTime, GetRotation() );
 		}
 	}
 	else
 	{
-		SimulateMovement( Timing::sInstance.GetDeltaTime() );
-
-		if( RoboMath::Is2DVectorEqual( GetVelocity(), Vector3::Zero ) )
-		{
-			//we're in sync if our velocity is 0
-			mTimeLocationBecameOutOfSync = 0.f;
-		}
+		UpdateFromSnapshots();
 	}
 }
 
@@ -134,24 +146,23 @@ void RoboCatClient::Read( InputMemoryBitStream& inInputStream )
 			HUD::sInstance->SetPlayerHealth( mHealth );
 		}
 
-		DoClientSidePredictionAfterReplicationForLocalCat( readState );
+		DoClientSidePredictionAfterReplicationForLocalCat( readState, oldRotation, oldLocation, oldVelocity );
 
 		//if this is a create packet, don't interpolate
 		if( ( readState & ECRS_PlayerId ) == 0 )
 		{
-			InterpolateClientSidePrediction( oldRotation, oldLocation, oldVelocity, false );
+			InterpolateClientSidePrediction( oldRotation, oldLocation, oldVelocity );
 		}
 	}
 	else
 	{
-		DoClientSidePredictionAfterReplicationForRemoteCat( readState );
-
-		//will this smooth us out too? it'll interpolate us just 10% of the way there...
-		if( ( readState & ECRS_PlayerId ) == 0 )
+		if( ( readState & ECRS_Pose ) != 0 )
 		{
-			InterpolateClientSidePrediction( oldRotation, oldLocation, oldVelocity, true );
+			mSnapshotBuffer.AddSnapshot( NetworkManagerClient::sInstance->GetServerClock().GetStatePacketServerTime(), replicatedLocation, replicatedVelocity, replicatedRotation );
 		}
 
+		//this frame's update has been and gone, and the new pose isn't due on screen for a while yet
+		UpdateFromSnapshots();
 	}
 
 	
@@ -160,34 +171,106 @@ void RoboCatClient::Read( InputMemoryBitStream& inInputStream )
 
 
 
-void RoboCatClient::DoClientSidePredictionAfterReplicationForLocalCat( uint32_t inReadState )
+void RoboCatClient::DoClientSidePredictionAfterReplicationForLocalCat( uint32_t inReadState, float inOldRotation, const Vector3& inOldLocation, const Vector3& inOldVelocity )
 {
 	if( ( inReadState & ECRS_Pose ) != 0 )
 	{
 		//simulate pose only if we received new pose- might have just gotten thrustDir
 		//in which case we don't need to replay moves because we haven't warped backwards
 
-		//all processed moves have been removed, so all that are left are unprocessed moves
-		//so we must apply them...
-		const MoveList& moveList = InputManager::sInstance->GetMoveList();
+		//the pose is where the server had us after the last move it processed. if that's where we predicted we'd be after that move,
+		//everything since is still right, so put back where we'd got to and skip the replay- and its collision checks
+		float lastMoveProcessedTimestamp = NetworkManagerClient::sInstance->GetLastMoveProcessedByServerTimestamp();
+		PredictedState* predictedState = lastMoveProcessedTimestamp >= 0.f ? FindPredictedState( Move::TimeToTick( lastMoveProcessedTimestamp ) ) : nullptr;
+		if( predictedState && IsPredictedStateCurrent( *predictedState ) )
+		{
+			SetRotation( inOldRotation );
+			SetLocation( inOldLocation );
+			SetVelocity( inOldVelocity );
+		}
+		else
+		{
+			ReplayUnprocessedMoves();
+		}
+	}
+
+	
+
+}
+
+void RoboCatClient::ReplayUnprocessedMoves()
+{
+	//all processed moves have been removed, so all that are left are unprocessed moves
+	//so we must apply them...
+	const MoveList& moveList = InputManager::sInstance->GetMoveList();
+
+	//moves collide with everyone else where they were when the frame started, same as on the server. we're outside the world update here,
+	//and objects have come and gone since it started, so that's where they are now
+	World::sInstance->GetTransformStore().CaptureFrameStart();
 
-		for( const Move& move : moveList )
+	for( int i = 0, c = moveList.GetMoveCount(); i < c; ++i )
+	{
+		const Move& move = moveList.GetMove( i );
+		float deltaTime = move.GetDeltaTime();
+		ProcessInput( deltaTime, move.GetInputState() );
+
+		SimulateMovement( deltaTime );
+
+		//the replay's the better guess now
+		PredictedState* predictedState = FindPredictedState( move.GetTick() );
+		if( predictedState )
 		{
-			float deltaTime = move.GetDeltaTime();
-			ProcessInput( deltaTime, move.GetInputState() );
+			predictedState->mRotation = GetRotation();
+			predictedState->mLocation = GetLocation();
+			predictedState->mVelocity = GetVelocity();
+		}
+	}
 
-			SimulateMovement( deltaTime );
+	HandleTouchedObjects();
+}
+
+void RoboCatClient::RecordPredictedState( uint32_t inTick )
+{
+	PredictedState& predictedState = mPredictedStates[ mNextPredictedStateIndex ];
+	predictedState.mTick = inTick;
+	predictedState.mRotation = GetRotation();
+	predictedState.mLocation = GetLocation();
+	predictedState.mVelocity = GetVelocity();
+
+	mNextPredictedStateIndex = ( mNextPredictedStateIndex + 1 ) & ( MoveList::kCapacity - 1 );
+	mPredictedStateCount = std::min( mPredictedStateCount + 1, MoveList::kCapacity );
+}
+
+RoboCatClient::PredictedState* RoboCatClient::FindPredictedState( uint32_t inTick )
+{
+	//ticks go up, so look back from the newest till we're past it. the server's rarely more than a few moves behind
+	for( uint32_t i = 1; i <= mPredictedStateCount; ++i )
+	{
+		PredictedState& predictedState = mPredictedStates[ ( mNextPredictedStateIndex - i ) & ( MoveList::kCapacity - 1 ) ];
+		if( predictedState.mTick == inTick )
+		{
+			return &predictedState;
+		}
+		else if( predictedState.mTick < inTick )
+		{
+			break;
 		}
 	}
 
-	
+	return nullptr;
+}
 
+bool RoboCatClient::IsPredictedStateCurrent( const PredictedState& inPredictedState ) const
+{
+	return fabsf( inPredictedState.mRotation - GetRotation() ) <= kPredictionRotationTolerance &&
+		( inPredictedState.mLocation - GetLocation() ).LengthSq2D() <= kPredictionLocationTolerance * kPredictionLocationTolerance &&
+		( inPredictedState.mVelocity - GetVelocity() ).LengthSq2D() <= kPredictionVelocityTolerance * kPredictionVelocityTolerance;
 }
 
 
-void RoboCatClient::InterpolateClientSidePrediction( float inOldRotation, const Vector3& inOldLocation, const Vector3& inOldVelocity, bool inIsForRemoteCat )
+void RoboCatClient::InterpolateClientSidePrediction( float inOldRotation, const Vector3& inOldLocation, const Vector3& inOldVelocity )
 {
-	if( inOldRotation != GetRotation() && !inIsForRemoteCat )
+	if( inOldRotation != GetRotation() )
 	{
 		LOG( "ERROR! Move replay ended with incorrect rotation!", 0 );
 	}
@@ -208,7 +291,7 @@ void RoboCatClient::InterpolateClientSidePrediction( float inOldRotation, const
 		float durationOutOfSync = time - mTimeLocationBecameOutOfSync;
 		if( durationOutOfSync < roundTripTime )
 		{
-			SetLocation( Lerp( inOldLocation, GetLocation(), inIsForRemoteCat ? ( durationOutOfSync / roundTripTime ) : 0.1f ) );
+			SetLocation( Lerp( inOldLocation, GetLocation(), 0.1f ) );
 		}
 	}
 	else
@@ -233,7 +316,7 @@ void RoboCatClient::InterpolateClientSidePrediction( float inOldRotation, const
 		float durationOutOfSync = time - mTimeVelocityBecameOutOfSync;
 		if( durationOutOfSync < roundTripTime )
 		{
-			SetVelocity( Lerp( inOldVelocity, GetVelocity(), inIsForRemoteCat ? ( durationOutOfSync / roundTripTime ) : 0.1f ) );
+			SetVelocity( Lerp( inOldVelocity, GetVelocity(), 0.1f ) );
 		}
 		//otherwise, fine...
 		
@@ -247,33 +330,13 @@ void RoboCatClient::InterpolateClientSidePrediction( float inOldRotation, const
 }
 
 
-//so what do we want to do here? need to do some kind of interpolation...
-
-void RoboCatClient::DoClientSidePredictionAfterReplicationForRemoteCat( uint32_t inReadState )
+void RoboCatClient::UpdateFromSnapshots()
 {
-	if( ( inReadState & ECRS_Pose ) != 0 )
+	SnapshotBuffer::Snapshot snapshot;
+	if( mSnapshotBuffer.Sample( NetworkManagerClient::sInstance->GetServerClock().GetServerTime() - NetworkManager::kInterpolationDelay, snapshot ) )
 	{
-
-		//simulate movement for an additional RTT
-		float rtt = NetworkManagerClient::sInstance->GetRoundTripTime();
-		//LOG( "Other cat came in, simulating for an extra %f", rtt );
-
-		//let's break into framerate sized chunks though so that we don't run through walls and do crazy things...
-		float deltaTime = 1.f / 30.f;
-
-		while( true )
-		{
-			if( rtt < deltaTime )
-			{
-				SimulateMovement( rtt );
-				break;
-			}
-			else
-			{
-				SimulateMovement( deltaTime );
-				rtt -= deltaTime;
-			}
-		}
+		SetLocation( snapshot.mLocation );
+		SetVelocity( snapshot.mVelocity );
+		SetRotation( snapshot.mRotation );
 	}
-
 }
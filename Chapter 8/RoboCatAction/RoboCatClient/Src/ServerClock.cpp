@@ -0,0 +1,126 @@
+#include <RoboCatClientPCH.h>
+
+namespace
+{
+	//once the first few are in, this is plenty to keep up with drift
+	const float kTimeBetweenRequests = 0.25f;
+
+	const float kRoundTripTimeSmoothing = 0.1f;
+
+	//clocks drift by parts per million, so it takes a while for it to show through the noise
+	const float kMinDriftInterval = 10.f;
+	const float kDriftSmoothing = 0.25f;
+	//a millisecond a second- far more than any real clock, so anything past it is noise
+	const float kMaxDrift = 0.001f;
+}
+
+ServerClock::ServerClock() :
+	mSampleCount( 0 ),
+	mNextSampleIndex( 0 ),
+	mOffset( 0.f ),
+	mOffsetLocalTime( 0.f ),
+	mDrift( 0.f ),
+	mDriftReferenceOffset( 0.f ),
+	mDriftReferenceLocalTime( 0.f ),
+	mRoundTripTime( 0.f ),
+	mStatePacketServerTime( 0.f ),
+	mTimeOfLastRequest( 0.f )
+{}
+
+void ServerClock::WriteRequest( OutputMemoryBitStream& inOutputStream )
+{
+	float time = Timing::sInstance.GetTimef();
+
+	//every packet till there's a handful to pick from
+	bool isRequestDue = mSampleCount < kSampleCount || time > mTimeOfLastRequest + kTimeBetweenRequests;
+	inOutputStream.Write( isRequestDue );
+	if( isRequestDue )
+	{
+		inOutputStream.Write( time );
+
+		//so the server can put our move times on its own clock
+		bool isSynchronized = IsSynchronized();
+		inOutputStream.Write( isSynchronized );
+		if( isSynchronized )
+		{
+			inOutputStream.Write( ToServerTime( time ) - time );
+		}
+
+		mTimeOfLastRequest = time;
+	}
+}
+
+void ServerClock::ReadStatePacketTimes( InputMemoryBitStream& inInputStream )
+{
+	float time = Timing::sInstance.GetTimef();
+
+	inInputStream.Read( mStatePacketServerTime );
+
+	bool hasResponse;
+	inInputStream.Read( hasResponse );
+	if( hasResponse )
+	{
+		float requestSentTime, requestReceivedTime;
+		inInputStream.Read( requestSentTime );
+		inInputStream.Read( requestReceivedTime );
+
+		//the server's send time doubles as the fourth timestamp
+		Sample sample;
+		sample.mLocalTime = time;
+		sample.mRoundTripTime = std::max( ( time - requestSentTime ) - ( mStatePacketServerTime - requestReceivedTime ), 0.f );
+		sample.mOffset = ( ( requestReceivedTime - requestSentTime ) + ( mStatePacketServerTime - time ) ) * 0.5f;
+		AddSample( sample );
+	}
+	else if( !IsSynchronized() )
+	{
+		mOffset = mStatePacketServerTime - time;
+		mOffsetLocalTime = time;
+	}
+}
+
+void ServerClock::AddSample( const Sample& inSample )
+{
+	mSamples[ mNextSampleIndex ] = inSample;
+	mNextSampleIndex = ( mNextSampleIndex + 1 ) % kSampleCount;
+	if( mSampleCount < kSampleCount )
+	{
+		++mSampleCount;
+	}
+
+	mRoundTripTime = mSampleCount == 1 ? inSample.mRoundTripTime : mRoundTripTime + ( inSample.mRoundTripTime - mRoundTripTime ) * kRoundTripTimeSmoothing;
+
+	const Sample* quickestSample = &mSamples[ 0 ];
+	for( uint32_t i = 1; i < mSampleCount; ++i )
+	{
+		if( mSamples[ i ].mRoundTripTime < quickestSample->mRoundTripTime )
+		{
+			quickestSample = &mSamples[ i ];
+		}
+	}
+
+	UpdateDrift( *quickestSample );
+
+	mOffset = quickestSample->mOffset;
+	mOffsetLocalTime = quickestSample->mLocalTime;
+}
+
+void ServerClock::UpdateDrift( const Sample& inSample )
+{
+	if( mSampleCount == 1 )
+	{
+		mDriftReferenceOffset = inSample.mOffset;
+		mDriftReferenceLocalTime = inSample.mLocalTime;
+		return;
+	}
+
+	float elapsedTime = inSample.mLocalTime - mDriftReferenceLocalTime;
+	if( elapsedTime >= kMinDriftInterval )
+	{
+		float measuredDrift = ( inSample.mOffset - mDriftReferenceOffset ) / elapsedTime;
+		measuredDrift = std::min( std::max( measuredDrift, -kMaxDrift ), kMaxDrift );
+		mDrift += ( measuredDrift - mDrift ) * kDriftSmoothing;
+
+		mDriftReferenceOffset = inSample.mOffset;
+		mDriftReferenceLocalTime = inSample.mLocalTime;
+	}
+}
@@ -0,0 +1,89 @@
+#include <RoboCatClientPCH.h>
+
+namespace
+{
+	//the short way round, so a cat turning through 0 doesn't spin the long way
+	float LerpRotation( float inA, float inB, float t )
+	{
+		float delta = fmodf( inB - inA, 2.f * RoboMath::PI );
+		if( delta > RoboMath::PI )
+		{
+			delta -= 2.f * RoboMath::PI;
+		}
+		else if( delta < -RoboMath::PI )
+		{
+			delta += 2.f * RoboMath::PI;
+		}
+		return inA + delta * t;
+	}
+}
+
+//a little over the server's pose refresh interval, so a pose that's dropped doesn't stop things in their tracks
+const float SnapshotBuffer::kMaxExtrapolationTime = 1.25f;
+
+void SnapshotBuffer::AddSnapshot( float inTime, const Vector3& inLocation, const Vector3& inVelocity, float inRotation )
+{
+	Snapshot* snapshot;
+	if( mSnapshotCount > 0 && inTime < GetSnapshot( mSnapshotCount - 1 ).mTime )
+	{
+		return;
+	}
+	else if( mSnapshotCount > 0 && inTime == GetSnapshot( mSnapshotCount - 1 ).mTime )
+	{
+		//sent together- the later one wins
+		snapshot = &mSnapshots[ ( mFirstSnapshotIndex + mSnapshotCount - 1 ) & ( kCapacity - 1 ) ];
+	}
+	else
+	{
+		if( mSnapshotCount == kCapacity )
+		{
+			mFirstSnapshotIndex = ( mFirstSnapshotIndex + 1 ) & ( kCapacity - 1 );
+			--mSnapshotCount;
+		}
+		snapshot = &mSnapshots[ ( mFirstSnapshotIndex + mSnapshotCount ) & ( kCapacity - 1 ) ];
+		++mSnapshotCount;
+	}
+
+	snapshot->mTime = inTime;
+	snapshot->mLocation = inLocation;
+	snapshot->mVelocity = inVelocity;
+	snapshot->mRotation = inRotation;
+}
+
+bool SnapshotBuffer::Sample( float inTime, Snapshot& outSnapshot ) const
+{
+	if( mSnapshotCount == 0 )
+	{
+		return false;
+	}
+
+	//the newest one at or before the time- we're usually sampling near the newest end
+	uint32_t index = mSnapshotCount - 1;
+	while( index > 0 && GetSnapshot( index ).mTime > inTime )
+	{
+		--index;
+	}
+
+	const Snapshot& from = GetSnapshot( index );
+	if( inTime <= from.mTime )
+	{
+		outSnapshot = from;
+		return true;
+	}
+
+	if( index == mSnapshotCount - 1 )
+	{
+		outSnapshot = from;
+		outSnapshot.mLocation += from.mVelocity * std::min( inTime - from.mTime, kMaxExtrapolationTime );
+		return true;
+	}
+
+	const Snapshot& to = GetSnapshot( index + 1 );
+	float t = ( inTime - from.mTime ) / ( to.mTime - from.mTime );
+
+	outSnapshot.mTime = inTime;
+	outSnapshot.mLocation = Lerp( from.mLocation, to.mLocation, t );
+	outSnapshot.mVelocity = Lerp( from.mVelocity, to.mVelocity, t );
+	outSnapshot.mRotation = LerpRotation( from.mRotation, to.mRotation, t );
+	return true;
+}
@@ -1,11 +1,54 @@
 #include <RoboCatClientPCH.h>
 
+namespace
+{
+	//how much longer than a round trip we'll wait for the server to fire a shot we predicted
+	const float kPredictionTimeoutSlack = 0.25f;
+}
+
 YarnClient::YarnClient()
 {
 	mSpriteComponent.reset( new SpriteComponent( this ) );
 	mSpriteComponent->SetTexture( TextureManager::sInstance->GetTexture( "yarn" ) );
 }
 
+void YarnClient::HandleDying()
+{
+	TimerWheel::sInstance->Cancel( mPredictionTimeoutTimer );
+}
+
+void YarnClient::InitAsPredicted( RoboCat* inShooter, uint32_t inShotTick )
+{
+	InitFromShooter( inShooter );
+	SetShotTick( inShotTick );
+
+	NetworkManagerClient::sInstance->AddPredictedYarn( this );
+
+	GameObjectHandle handle = GetHandle();
+	//the server shoots when its jitter buffer lets the move go, so a move's round trip includes the hold- the clock's doesn't.
+	//the clock still covers the first shots, before we've heard back about any moves
+	NetworkManagerClient* networkManager = NetworkManagerClient::sInstance;
+	float roundTripTime = std::max( networkManager->GetRoundTripTime(), networkManager->GetServerClock().GetRoundTripTime() );
+	float timeout = roundTripTime + kPredictionTimeoutSlack;
+	mPredictionTimeoutTimer = TimerWheel::sInstance->Schedule( timeout, [ handle ]()
+	{
+		if( GameObject* yarn = handle.Get() )
+		{
+			yarn->SetDoesWantToDie( true );
+		}
+	} );
+}
+
+void YarnClient::TakeOverFromPredictedYarn( YarnClient* inPredictedYarn )
+{
+	//the server's word goes for everything but where it is- the prediction's been on screen all along, so carry on from there
+	SetLocation( inPredictedYarn->GetLocation() );
+
+	//and the prediction's done its job. off the screen now, so the two aren't drawn on top of each other this frame
+	inPredictedYarn->SetDoesWantToDie( true );
+	RenderManager::sInstance->RemoveComponent( inPredictedYarn->mSpriteComponent.get() );
+}
+
 
 void YarnClient::Read( InputMemoryBitStream& inInputStream )
 {
@@ -24,8 +67,9 @@ void YarnClient::Read( InputMemoryBitStream& inInputStream )
 		inInputStream.Read( velocity.mY );
 		SetVelocity( velocity );
 
-		//dead reckon ahead by rtt, since this was spawned a while ago!
-		SetLocation( location + velocity * NetworkManagerClient::sInstance->GetRoundTripTime() );
+		//dead reckon ahead by however long the packet took, since this was spawned a while ago!
+		const ServerClock& serverClock = NetworkManagerClient::sInstance->GetServerClock();
+		SetLocation( location + velocity * ( serverClock.GetServerTime() - serverClock.GetStatePacketServerTime() ) );
 
 
 		float rotation;
@@ -46,16 +90,25 @@ void YarnClient::Read( InputMemoryBitStream& inInputStream )
 	if( stateBit )
 	{	
 		inInputStream.Read( mPlayerId, 8 );
+		inInputStream.Read( mShotTick );
+
+		//one of ours? then it's already flying
+		if( mPlayerId == NetworkManagerClient::sInstance->GetPlayerId() )
+		{
+			if( YarnClient* predictedYarn = NetworkManagerClient::sInstance->TakePredictedYarn( mShotTick ) )
+			{
+				TakeOverFromPredictedYarn( predictedYarn );
+			}
+		}
 	}
 
 }
 
 //you look like you hit a cat on the client, so disappear ( whether server registered or not
-bool YarnClient::HandleCollisionWithCat( RoboCat* inCat )
+void YarnClient::HandleCollisionWithCat( RoboCat* inCat )
 {
 	if( GetPlayerId() != inCat->GetPlayerId() )
 	{
 		RenderManager::sInstance->RemoveComponent( mSpriteComponent.get() );
 	}
-	return false;
 }
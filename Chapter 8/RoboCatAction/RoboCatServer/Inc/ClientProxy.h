@@ -6,6 +6,9 @@ public:
 
 	const	SocketAddress&	GetSocketAddress()	const	{ return mSocketAddress; }
 			int				GetPlayerId()		const	{ return mPlayerId; }
+			//where the network manager keeps us- stable for as long as we're connected
+			void			SetClientSlot( uint32_t inClientSlot )	{ mClientSlot = inClientSlot; }
+			uint32_t		GetClientSlot()		const	{ return mClientSlot; }
 	const	string&		GetName()			const	{ return mName; }
 
 			void			SetInputState( const InputState& inInputState )		{ mInputState = inInputState; }
@@ -16,36 +19,68 @@ public:
 
 			DeliveryNotificationManager&	GetDeliveryNotificationManager()	{ return mDeliveryNotificationManager; }
 			ReplicationManagerServer&		GetReplicationManagerServer()		{ return mReplicationManagerServer; }
+			EntropyCodingContext&			GetEntropyCodingContext()			{ return mEntropyCodingContext; }
 
 			const	MoveList&				GetUnprocessedMoveList() const		{ return mUnprocessedMoveList; }
 					MoveList&				GetUnprocessedMoveList()			{ return mUnprocessedMoveList; }
+			//moves wait in here till they're due, then go on the unprocessed list
+					InputJitterBuffer&		GetInputJitterBuffer()				{ return mInputJitterBuffer; }
 
 			void	SetIsLastMoveTimestampDirty( bool inIsDirty )				{ mIsLastMoveTimestampDirty = inIsDirty; }
 			bool	IsLastMoveTimestampDirty()						const		{ return mIsLastMoveTimestampDirty; }
 
+			//the client's latest clock request, on its clock and ours, waiting to be answered in the next state packet
+			void	SetClockRequest( float inSentTime, float inReceivedTime )	{ mClockRequestSentTime = inSentTime; mClockRequestReceivedTime = inReceivedTime; mHasClockRequest = true; }
+			void	ClearClockRequest()											{ mHasClockRequest = false; }
+			bool	HasClockRequest()								const		{ return mHasClockRequest; }
+			float	GetClockRequestSentTime()						const		{ return mClockRequestSentTime; }
+			float	GetClockRequestReceivedTime()					const		{ return mClockRequestReceivedTime; }
+
+			//how far our clock's ahead of the client's, as the client worked it out- puts their move times on our clock
+			void	SetClientClockOffset( float inOffset )						{ mClientClockOffset = inOffset; mHasClientClockOffset = true; }
+			bool	HasClientClockOffset()							const		{ return mHasClientClockOffset; }
+			float	GetClientClockOffset()							const		{ return mClientClockOffset; }
+
+			//schedules a new cat for later
 			void	HandleCatDied();
-			void	RespawnCatIfNecessary();
+
+			//timers waiting on this client- all cancelled when it disconnects
+			void			SetDisconnectTimer( TimerHandle inTimer )		{ mDisconnectTimer = inTimer; }
+			void			SetAckTimeoutTimer( TimerHandle inTimer )		{ mAckTimeoutTimer = inTimer; }
+			TimerHandle		GetAckTimeoutTimer()				const		{ return mAckTimeoutTimer; }
+			void			CancelTimers();
 
 private:
 
 	DeliveryNotificationManager	mDeliveryNotificationManager;
 	ReplicationManagerServer	mReplicationManagerServer;
+	EntropyCodingContext		mEntropyCodingContext;
 
 	SocketAddress	mSocketAddress;
 	string			mName;
 	int				mPlayerId;
+	uint32_t		mClientSlot;
 
 	//going away!
 	InputState		mInputState;
 
 	float			mLastPacketFromClientTime;
-	float			mTimeToRespawn;
 
+	TimerHandle		mDisconnectTimer;
+	TimerHandle		mAckTimeoutTimer;
+	TimerHandle		mRespawnTimer;
+
+	InputJitterBuffer	mInputJitterBuffer;
 	MoveList		mUnprocessedMoveList;
 	bool			mIsLastMoveTimestampDirty;
 
+	float			mClockRequestSentTime;
+	float			mClockRequestReceivedTime;
+	bool			mHasClockRequest;
+
+	float			mClientClockOffset;
+	bool			mHasClientClockOffset;
 
 
-};
 
-typedef shared_ptr< ClientProxy >	ClientProxyPtr;
\ No newline at end of file
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+* holds a client's moves back a little so they come out at the steady rate they were made at, however bunched up the packets arrive.
+* a move's transit is when it got here less when the client made it- the clocks don't agree, but only how much that wobbles matters.
+* a move goes out at its make time plus the average transit and a few deviations of headroom, so only the odd really late one
+* finds it should have gone already. the deviation's what sets the depth, so a steady connection hardly waits at all
+*/
+class InputJitterBuffer
+{
+public:
+
+	InputJitterBuffer();
+	~InputJitterBuffer();
+
+	//reads an input packet's moves in. returns whether any were new
+	bool	ReadAndAddNewMoves( InputMemoryBitStream& inInputStream, float inArrivalTime );
+	//moves that are due go on the end of outMoves, oldest first. returns whether there were any
+	bool	ReleaseDueMoves( float inTime, MoveList& outMoves );
+
+	//how long after the average move gets here it goes out
+	float	GetHeadroom()					const	{ return mHeadroom; }
+	//how long moves actually waited in here, averaged
+	float	GetAverageQueueingDelay()		const	{ return mAverageQueueingDelay; }
+
+private:
+
+	void	UpdateTransit( float inTransit );
+	float	PopArrivalTime( uint32_t inTick );
+
+	MoveList	mMoves;
+
+	//when each packet's worth of new moves came in, by the newest tick in it
+	struct Arrival
+	{
+		uint32_t	mLastTick;
+		float		mTime;
+	};
+
+	static const uint32_t	kMaxArrivalCount = 32;
+
+	Arrival		mArrivals[ kMaxArrivalCount ];
+	uint32_t	mFirstArrivalIndex;
+	uint32_t	mArrivalCount;
+
+	float		mAverageTransit;
+	float		mTransitDeviation;
+	float		mHeadroom;
+	bool		mHasTransit;
+
+	float		mAverageQueueingDelay;
+	uint32_t	mReleasedMoveCount;
+};
@@ -0,0 +1,45 @@
+/*
+* one game running inside the server process- its own world, scoreboard, timers, pose history and network manager.
+* everything else reaches those through their per thread sInstances, so entering a match points the thread's at its own and
+* leaving nulls them. every match's frame is a job on the shared pool, so they run side by side, and each one's world update
+* spreads its objects over the same pool
+*/
+class Match : public JobContext
+{
+public:
+
+	Match( uint32_t inIndex, UDPSocketPtr inSharedSocket );
+	~Match();
+
+	virtual void	Enter() override;
+	virtual void	Leave() override;
+
+	//these all enter and leave for themselves, and only touch this match- any thread can run them, one at a time per match
+	void	Start( const string& inSnapshotPath );
+	void	DoFrame();
+	void	Shutdown();
+
+	uint32_t				GetIndex()			const	{ return mIndex; }
+	NetworkManagerServer*	GetNetworkManager()	const	{ return mNetworkManager; }
+
+private:
+
+	void	SetupWorld();
+
+	bool	LoadWorldSnapshot();
+	void	SaveWorldSnapshot();
+
+	uint32_t						mIndex;
+
+	unique_ptr< World >				mWorld;
+	unique_ptr< ScoreBoardManager >	mScoreBoardManager;
+	unique_ptr< TimerWheel >		mTimerWheel;
+	unique_ptr< PoseHistory >		mPoseHistory;
+	NetworkManagerServer*			mNetworkManager;
+
+	//empty if we weren't asked to persist the world
+	string							mSnapshotPath;
+	float							mTimeOfLastSnapshot;
+};
+
+typedef unique_ptr< Match >	MatchPtr;
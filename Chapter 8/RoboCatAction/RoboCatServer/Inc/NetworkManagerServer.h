@@ -1,51 +1,123 @@
 class NetworkManagerServer : public NetworkManager
 {
 public:
-	static NetworkManagerServer*	sInstance;
+	//the running match's, per thread
+	static ROBOCAT_THREAD_LOCAL NetworkManagerServer*	sInstance;
 
-	static bool				StaticInit( uint16_t inPort );
+	//a connection id is the match's base with the client's slot in the low bits
+	static const uint32_t	kClientSlotBitCount = 8;
+	static const uint32_t	kMaxClientSlotCount = 1 << kClientSlotBitCount;
+
+	//every match has its own, all sharing the server's socket. points the calling thread at the new one, and the caller owns it
+	static void				StaticInit( UDPSocketPtr inSharedSocket, uint32_t inConnectionIdBase );
+
+	virtual					~NetworkManagerServer();
 		
 	virtual void			ProcessPacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress ) override;
 	virtual void			HandleConnectionReset( const SocketAddress& inFromAddress ) override;
 		
 			void			SendOutgoingPackets();
-			void			CheckForDisconnects();
+			//hands clients' moves on from their jitter buffers as they come due
+			void			ReleaseDueMoves();
 
 			void			RegisterGameObject( GameObjectPtr inGameObject );
 	inline	GameObjectPtr	RegisterAndReturn( GameObject* inGameObject );
 			void			UnregisterGameObject( GameObject* inGameObject );
 			void			SetStateDirty( int inNetworkId, uint32_t inDirtyState );
-
-			void			RespawnCats();
-
-			ClientProxyPtr	GetClientProxy( int inPlayerId ) const;
+			//just for the one client
+			void			SetStateDirtyForPlayer( int inPlayerId, int inNetworkId, uint32_t inDirtyState );
+
+			//null if they're not connected. good until they disconnect, so don't hang on to it past the frame
+			ClientProxy*	GetClientProxy( int inPlayerId ) const;
+			bool			HasClient( const SocketAddress& inAddress ) const	{ return mAddressToClientSlotMap.find( inAddress ) != mAddressToClientSlotMap.end(); }
+			uint32_t		GetClientCount()						const	{ return mClientCount; }
+
+			//range code replication data with models that adapt per client
+			void			SetIsEntropyCodingEnabled( bool inIsEnabled )	{ mIsEntropyCodingEnabled = inIsEnabled; }
+
+			//moving objects only send a pose when the one clients are extrapolating from has drifted this far, or it's this old.
+			//0 sends every change
+			void			SetMaxPoseError( float inMaxPoseError )			{ mMaxPoseError = inMaxPoseError; }
+			float			GetMaxPoseError()						const	{ return mMaxPoseError; }
+			void			SetPoseRefreshInterval( float inInterval )		{ mPoseRefreshInterval = inInterval; }
+			float			GetPoseRefreshInterval()				const	{ return mPoseRefreshInterval; }
+
+			//world snapshots save and restore where id allocation is up to, so restored objects keep their ids
+			int				GetNextNetworkId()						const	{ return mNewNetworkId; }
+			void			SetNextNetworkId( int inNetworkId )				{ mNewNetworkId = inNetworkId; }
+			int				GetNextPlayerId()						const	{ return mNewPlayerId; }
+			void			SetNextPlayerId( int inPlayerId )				{ mNewPlayerId = inPlayerId; }
+			//a client saying hello with this name gets the id back instead of a new one
+			void			AddRestoredPlayer( const string& inName, int inPlayerId )	{ mNameToRestoredPlayerIdMap[ inName ] = inPlayerId; }
 
 private:
 			NetworkManagerServer();
 
-			void	HandlePacketFromNewClient( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress );
-			void	ProcessPacket( ClientProxyPtr inClientProxy, InputMemoryBitStream& inInputStream );
+			void	HandleHelloPacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress );
+			void	HandleHelloFromNewClient( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress );
+			void	ProcessPacket( ClientProxy* inClientProxy, uint32_t inPacketType, InputMemoryBitStream& inInputStream );
+
+			//null unless the id's one of ours, in use, and it's the client at that slot who sent it
+			ClientProxy*	GetClientForConnectionId( uint32_t inConnectionId, const SocketAddress& inFromAddress ) const;
+			uint32_t		GetConnectionId( const ClientProxy* inClientProxy ) const	{ return mConnectionIdBase | inClientProxy->GetClientSlot(); }
 			
-			void	SendWelcomePacket( ClientProxyPtr inClientProxy );
+			void	SendWelcomePacket( ClientProxy* inClientProxy );
 			void	UpdateAllClients();
 			
 			void	AddWorldStateToPacket( OutputMemoryBitStream& inOutputStream );
 			void	AddScoreBoardStateToPacket( OutputMemoryBitStream& inOutputStream );
 
-			void	SendStatePacketToClient( ClientProxyPtr inClientProxy );
-			void	WriteLastMoveTimestampIfDirty( OutputMemoryBitStream& inOutputStream, ClientProxyPtr inClientProxy );
+			void	SendStatePacketToClient( ClientProxy* inClientProxy );
+			void	WriteLastMoveTimestampIfDirty( OutputMemoryBitStream& inOutputStream, ClientProxy* inClientProxy );
+			//our send time, and the answer to the client's clock request if there's one waiting
+			void	WriteClockTimes( OutputMemoryBitStream& inOutputStream, ClientProxy* inClientProxy );
 
-			void	HandleInputPacket( ClientProxyPtr inClientProxy, InputMemoryBitStream& inInputStream );
+			void	HandleInputPacket( ClientProxy* inClientProxy, InputMemoryBitStream& inInputStream );
+			void	ReadClockRequest( ClientProxy* inClientProxy, InputMemoryBitStream& inInputStream );
 
-			void	HandleClientDisconnected( ClientProxyPtr inClientProxy );
+			void	HandleClientDisconnected( ClientProxy* inClientProxy );
 
-			int		GetNewNetworkId();
+			//builds the proxy in a free slot. null if every slot's taken
+			ClientProxy*	AddClient( const SocketAddress& inSocketAddress, const string& inName, int inPlayerId );
+			//destroys it, so nothing can use the proxy after this
+			void			RemoveClient( ClientProxy* inClientProxy );
+
+			//only for slots with a player in them
+			ClientProxy*	GetClientInSlot( uint32_t inClientSlot ) const	{ return reinterpret_cast< ClientProxy* >( &mClientPages[ inClientSlot / kClientSlotsPerPage ]->mSlots[ inClientSlot % kClientSlotsPerPage ] ); }
 
-	typedef unordered_map< int, ClientProxyPtr >	IntToClientMap;
-	typedef unordered_map< SocketAddress, ClientProxyPtr >	AddressToClientMap;
+			template< typename TFunction >
+			void			ForEachClient( TFunction inFunction ) const;
 
-	AddressToClientMap		mAddressToClientMap;
-	IntToClientMap			mPlayerIdToClientMap;
+			//timers go off with the client's slot rather than the proxy. they're cancelled when the client leaves, so the slot's still theirs
+			void	ScheduleDisconnectCheck( ClientProxy* inClientProxy );
+			void	HandleDisconnectCheck( uint32_t inClientSlot );
+			void	ScheduleAckTimeout( ClientProxy* inClientProxy );
+			void	HandleAckTimeout( uint32_t inClientSlot );
+
+			int		GetNewNetworkId();
+			int		GetNewPlayerId( const string& inName );
+
+	//connected clients live in place, by slot. a client keeps its slot for as long as it's connected and slots get reused.
+	//pages are only allocated as slots get used and never move, so a proxy stays put while the replication data points into it,
+	//and the loops that visit every client walk the proxies in order rather than chasing a pointer each
+	static const uint32_t	kClientSlotsPerPage = 16;
+	struct ClientPage
+	{
+		std::aligned_storage< sizeof( ClientProxy ), std::alignment_of< ClientProxy >::value >::type	mSlots[ kClientSlotsPerPage ];
+	};
+	vector< unique_ptr< ClientPage > >	mClientPages;
+	//the player in each slot, 0 when it's empty- scanning a few dozen ints beats hashing, and says which slots hold a proxy
+	vector< int >				mClientPlayerIds;
+	vector< uint32_t >			mFreeClientSlots;
+	uint32_t					mClientCount;
+
+	//hellos are the only packets without a connection id, so they're all this is for
+	typedef unordered_map< SocketAddress, uint32_t >	AddressToClientSlotMap;
+	AddressToClientSlotMap		mAddressToClientSlotMap;
+
+	unordered_map< string, int >	mNameToRestoredPlayerIdMap;
+
+	uint32_t		mConnectionIdBase;
 
 	int				mNewPlayerId;
 	int				mNewNetworkId;
@@ -53,12 +125,29 @@ private:
 	float			mTimeOfLastSatePacket;
 	float			mTimeBetweenStatePackets;
 	float			mClientDisconnectTimeout;
+
+	bool			mIsEntropyCodingEnabled;
+
+	float			mMaxPoseError;
+	float			mPoseRefreshInterval;
 };
 
 
 inline GameObjectPtr NetworkManagerServer::RegisterAndReturn( GameObject* inGameObject )
 {
-	GameObjectPtr toRet( inGameObject );
+	GameObjectPtr toRet = MakeGameObjectPtr( inGameObject );
 	RegisterGameObject( toRet );
 	return toRet;
 }
+
+template< typename TFunction >
+inline void NetworkManagerServer::ForEachClient( TFunction inFunction ) const
+{
+	for( uint32_t slot = 0, slotCount = static_cast< uint32_t >( mClientPlayerIds.size() ); slot < slotCount; ++slot )
+	{
+		if( mClientPlayerIds[ slot ] != 0 )
+		{
+			inFunction( GetClientInSlot( slot ) );
+		}
+	}
+}
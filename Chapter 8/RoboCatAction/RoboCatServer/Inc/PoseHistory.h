@@ -0,0 +1,50 @@
+/*
+* where every cat was over the last second or so, so a hit can be checked against what the shooter actually saw.
+* each cat gets a column in a ring of samples taken a fixed interval apart, with every cat's x and y side by side in each sample,
+* so rewinding for a query reads one or two samples straight through- 64 cats by a second of history is about 33KB, which sits in L2.
+* cats past the column count just aren't rewound
+*/
+class PoseHistory
+{
+public:
+
+	static const uint32_t	kMaxCatCount = 64;
+	static const uint32_t	kSampleCount = 64;
+	static const uint32_t	kNoSlot = 0xffffffff;
+
+	//every match owns one, and this points at the one for the match the thread's running
+	static ROBOCAT_THREAD_LOCAL PoseHistory*	sInstance;
+
+	PoseHistory();
+
+	//kNoSlot if they're all taken
+	uint32_t	AddCat( RoboCat* inCat );
+	void		RemoveCat( uint32_t inSlot );
+
+	//call once a frame, after everything's moved
+	void		Record( float inTime );
+
+	//the first cat other than the shooter's that was overlapping the circle at that time, blending between the samples either side.
+	//times older than the history go as far back as it goes
+	RoboCat*	FindCatAt( float inTime, const Vector3& inLocation, float inRadius, int inIgnoredPlayerId ) const;
+
+private:
+
+	struct Sample
+	{
+		float	mTime;
+		float	mLocationXs[ kMaxCatCount ];
+		float	mLocationYs[ kMaxCatCount ];
+	};
+
+	//so an empty slot never hits anything
+	void		ClearSlot( uint32_t inSlot );
+
+	Sample				mSamples[ kSampleCount ];
+	//the newest sample is always this frame's- it only moves on once it's a sample interval past the one before
+	uint32_t			mNewestSampleIndex;
+	uint32_t			mSampleCount;
+
+	GameObjectHandle	mCats[ kMaxCatCount ];
+	float				mCollisionRadii[ kMaxCatCount ];
+};
@@ -19,7 +19,8 @@ private:
 	uint32_t WriteUpdateAction( OutputMemoryBitStream& inOutputStream, int inNetworkId, uint32_t inDirtyState );
 	uint32_t WriteDestroyAction( OutputMemoryBitStream& inOutputStream, int inNetworkId, uint32_t inDirtyState );
 
-	unordered_map< int, ReplicationCommand >	mNetworkIdToReplicationCommand;
+	//every client gets a command for every yarn, so the nodes come from the pools
+	unordered_map< int, ReplicationCommand, std::hash< int >, std::equal_to< int >, PoolAllocator< std::pair< const int, ReplicationCommand > > >	mNetworkIdToReplicationCommand;
 
 
 
@@ -44,7 +44,7 @@ private:
 
 	ReplicationManagerServer*	mReplicationManagerServer;
 	
-	vector< ReplicationTransmission >		mTransmissions;
+	vector< ReplicationTransmission, PoolAllocator< ReplicationTransmission > >	mTransmissions;
 
 };
 
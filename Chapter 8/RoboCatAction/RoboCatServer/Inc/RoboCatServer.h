@@ -10,23 +10,56 @@ public:
 	static GameObjectPtr	StaticCreate() { return NetworkManagerServer::sInstance->RegisterAndReturn( new RoboCatServer() ); }
 	virtual void HandleDying() override;
 
+	//replays the client's moves- the expensive part, so it runs on the job system
+	virtual void ParallelUpdate() override;
 	virtual void Update();
 
 	void SetCatControlType( ECatControlType inCatControlType ) { mCatControlType = inCatControlType; }
 
 	void TakeDamage( int inDamagingPlayerId );
 
+	//whether yarn checks this cat against the pose history- or just where it is now, if the history was full when it spawned
+	bool IsLagCompensated() const { return mPoseHistorySlot != PoseHistory::kNoSlot; }
+
 protected:
 	RoboCatServer();
 
 private:
 
+	//replays the client's moves exactly as it predicted them- colliding after every one
+	void ProcessMoves();
+	//fires the shots ParallelUpdate found in the moves- it can't make objects itself
 	void HandleShooting();
 
+	//clients carry a pose on at its velocity till they get another, so there's only a new one when that's drifted too far
+	bool IsSentPoseStale( float inTime ) const;
+	void RecordSentPose( float inTime );
+
 	ECatControlType	mCatControlType;
 
+	uint32_t	mPoseHistorySlot;
+
+
+	//filled in by ParallelUpdate for Update to pick up. the pose is the cat's right after the move that fired,
+	//which is where the client's prediction fired from- later moves in the same frame have carried the cat on since
+	struct Shot
+	{
+		uint32_t	mTick;
+		Vector3		mLocation;
+		Vector3		mVelocity;
+		float		mRotation;
+	};
+	static const uint32_t	kMaxShotsPerUpdate = 8;
+	Shot		mShots[ kMaxShotsPerUpdate ];
+	uint32_t	mShotCount;
+	Vector3		mLocationBeforeUpdate;
+	Vector3		mVelocityBeforeUpdate;
+	float		mRotationBeforeUpdate;
 
-	float		mTimeOfNextShot;
-	float		mTimeBetweenShots;
+	//the last pose everyone was sent
+	Vector3		mSentLocation;
+	Vector3		mSentVelocity;
+	float		mSentRotation;
+	float		mTimeOfSentPose;
 
 };
\ No newline at end of file
@@ -4,8 +4,12 @@
 #include <ReplicationManagerTransmissionData.h>
 #include <ReplicationManagerServer.h>
 
+#include <InputJitterBuffer.h>
 #include <ClientProxy.h>
 #include <NetworkManagerServer.h>
+#include <PoseHistory.h>
+#include <Match.h>
+#include <SoakBenchmark.h>
 #include <Server.h>
 
 #include <RoboCatServer.h>
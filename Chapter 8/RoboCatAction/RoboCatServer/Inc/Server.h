@@ -8,8 +8,9 @@ public:
 
 	virtual int Run();
 
-	void HandleNewClient( ClientProxyPtr inClientProxy );
-	void HandleLostClient( ClientProxyPtr inClientProxy );
+	//these come from inside a match's frame, so they only touch that match
+	void HandleNewClient( ClientProxy* inClientProxy );
+	void HandleLostClient( ClientProxy* inClientProxy );
 
 	RoboCatPtr	GetCatForPlayer( int inPlayerId );
 	void	SpawnCatForPlayer( int inPlayerId );
@@ -18,7 +19,28 @@ public:
 private:
 	Server();
 
-	bool	InitNetworkManager();
-	void	SetupWorld();
+	bool	InitNetworking();
 
-};
\ No newline at end of file
+	//every match shares the one socket- packets get handed to the match in their connection id, or for hellos, whichever match owns the address
+	void	ReadIncomingPackets();
+	Match*	GetMatchForPacket( InputMemoryBitStream& inPeekStream, const SocketAddress& inFromAddress );
+	Match*	GetMatchForHello( const SocketAddress& inFromAddress );
+	void	PruneRoutes();
+
+	uint32_t	GetClientCount() const;
+
+	UDPSocketPtr							mSocket;
+	vector< MatchPtr >						mMatches;
+
+	//only hellos and connection resets need these
+	typedef unordered_map< SocketAddress, Match* >	AddressToMatchMap;
+	AddressToMatchMap						mAddressToMatchMap;
+	float									mTimeOfLastRoutePrune;
+
+	//set from whichever match lost someone, so we can see if that was everyone once all the frames are done
+	std::atomic< bool >						mHasLostClient;
+
+	//only when asked for on the command line
+	unique_ptr< SoakBenchmark >				mSoakBenchmark;
+
+};
@@ -0,0 +1,37 @@
+/*
+* keeps a headless server busy with fake players over real sockets on localhost, then reports what each frame cost on the heap.
+* once everyone's in and things have settled, the engine's zero allocation mode goes on, so any frame that allocates fails the run.
+* the fake players do their work inside EAP_Untracked, so only the server's own allocations count
+*/
+class SoakBenchmark
+{
+public:
+
+	SoakBenchmark( uint16_t inServerPort, int inClientCount );
+	~SoakBenchmark();
+
+	//runs the fake players- call at the top of every server frame. stops the engine once the soak is over
+	void	Update();
+	//logs the per frame costs, and returns whether every measured frame came in at zero
+	bool	Finish();
+
+private:
+
+	struct SoakClient;
+
+	void	UpdateClient( SoakClient& ioClient, float inTime );
+	void	ReadIncomingPackets( SoakClient& ioClient );
+	void	SendHelloPacket( SoakClient& ioClient );
+	void	SendInputPacket( SoakClient& ioClient, float inTime );
+
+	void	StartMeasuring( float inTime );
+
+	SocketAddress						mServerAddress;
+	vector< unique_ptr< SoakClient > >	mClients;
+
+	float								mStartTime;
+	bool								mIsMeasuring;
+	float								mMeasureStartTime;
+	uint32_t							mMeasuredFrameCount;
+	AllocationCounter::Totals			mPhaseAllocationsAtMeasureStart[ EAP_Count ];
+};
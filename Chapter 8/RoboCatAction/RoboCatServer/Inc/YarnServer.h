@@ -4,14 +4,17 @@ public:
 	static GameObjectPtr	StaticCreate() { return NetworkManagerServer::sInstance->RegisterAndReturn( new YarnServer() ); }
 	void HandleDying() override;
 
-	virtual bool		HandleCollisionWithCat( RoboCat* inCat ) override;
+	//hits cats where the shooter saw them
+	virtual void		Update() override;
 
-	virtual void Update() override;
+	virtual void		HandleCollisionWithCat( RoboCat* inCat ) override;
 
 protected:
 	YarnServer();
 
 private:
-	float mTimeToDie;
+	TimerHandle mDeathTimer;
+
+	float		mSpawnTime;
 
 };
\ No newline at end of file
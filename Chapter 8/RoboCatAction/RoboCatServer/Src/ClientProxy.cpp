@@ -9,9 +9,14 @@ ClientProxy::ClientProxy( const SocketAddress& inSocketAddress, const string& in
 mSocketAddress( inSocketAddress ),
 mName( inName ),
 mPlayerId( inPlayerId ),
+mClientSlot( 0 ),
 mDeliveryNotificationManager( false, true ),
 mIsLastMoveTimestampDirty( false ),
-mTimeToRespawn( 0.f )
+mClockRequestSentTime( 0.f ),
+mClockRequestReceivedTime( 0.f ),
+mHasClockRequest( false ),
+mClientClockOffset( 0.f ),
+mHasClientClockOffset( false )
 {
 	UpdateLastPacketTime();
 }
@@ -24,14 +29,17 @@ void ClientProxy::UpdateLastPacketTime()
 
 void	ClientProxy::HandleCatDied()
 {
-	mTimeToRespawn = Timing::sInstance.GetFrameStartTime() + kRespawnDelay;
+	//by id rather than pointer- if we disconnect first, the timer's cancelled anyway
+	int playerId = mPlayerId;
+	mRespawnTimer = TimerWheel::sInstance->Schedule( kRespawnDelay, [ playerId ]()
+	{
+		static_cast< Server* > ( Engine::sInstance.get() )->SpawnCatForPlayer( playerId );
+	} );
 }
 
-void	ClientProxy::RespawnCatIfNecessary()
+void	ClientProxy::CancelTimers()
 {
-	if( mTimeToRespawn != 0.f && Timing::sInstance.GetFrameStartTime() > mTimeToRespawn )
-	{
-		static_cast< Server* > ( Engine::sInstance.get() )->SpawnCatForPlayer( mPlayerId );
-		mTimeToRespawn = 0.f;
-	}
+	TimerWheel::sInstance->Cancel( mDisconnectTimer );
+	TimerWheel::sInstance->Cancel( mAckTimeoutTimer );
+	TimerWheel::sInstance->Cancel( mRespawnTimer );
 }
@@ -0,0 +1,125 @@
+#include <RoboCatServerPCH.h>
+
+namespace
+{
+	//how much of the way each move pulls the transit average and deviation- a quarter second or so of moves to settle
+	const float kTransitSmoothing = 1.f / 16.f;
+	//a couple of deviations covers the packet a move waited for on the client plus most of the wobble on the way
+	const float kHeadroomDeviations = 2.f;
+	//past this the connection's too rough to smooth over without adding more lag than it's worth
+	const float kMaxHeadroom = 0.15f;
+	//the averages take a moment to catch up when the route changes- nothing waits longer than this meanwhile
+	const float kMaxQueueingDelay = 0.25f;
+
+	const float kQueueingDelaySmoothing = 0.01f;
+}
+
+InputJitterBuffer::InputJitterBuffer() :
+	mFirstArrivalIndex( 0 ),
+	mArrivalCount( 0 ),
+	mAverageTransit( 0.f ),
+	mTransitDeviation( 0.f ),
+	mHeadroom( 0.f ),
+	mHasTransit( false ),
+	mAverageQueueingDelay( 0.f ),
+	mReleasedMoveCount( 0 )
+{}
+
+InputJitterBuffer::~InputJitterBuffer()
+{
+	if( mReleasedMoveCount > 0 )
+	{
+		LOG( "Input jitter buffer held moves %.1fms on average, with %.1fms of headroom", mAverageQueueingDelay * 1000.f, mHeadroom * 1000.f );
+	}
+}
+
+bool InputJitterBuffer::ReadAndAddNewMoves( InputMemoryBitStream& inInputStream, float inArrivalTime )
+{
+	float previousLastMoveTimestamp = mMoves.GetLastMoveTimestamp();
+	if( !mMoves.ReadAndAddNewMoves( inInputStream ) )
+	{
+		return false;
+	}
+
+	int firstNewMoveIndex = mMoves.GetMoveCount();
+	while( firstNewMoveIndex > 0 && mMoves.GetMove( firstNewMoveIndex - 1 ).GetTimestamp() > previousLastMoveTimestamp )
+	{
+		--firstNewMoveIndex;
+	}
+
+	for( int i = firstNewMoveIndex, c = mMoves.GetMoveCount(); i < c; ++i )
+	{
+		UpdateTransit( inArrivalTime - mMoves.GetMove( i ).GetTimestamp() );
+	}
+
+	uint32_t lastTick = mMoves.GetLatestMove().GetTick();
+	if( mArrivalCount == kMaxArrivalCount )
+	{
+		//only happens if moves are piling up for a cat that isn't there- lumping them in with the last lot is close enough
+		mArrivals[ ( mFirstArrivalIndex + mArrivalCount - 1 ) & ( kMaxArrivalCount - 1 ) ].mLastTick = lastTick;
+	}
+	else
+	{
+		Arrival& arrival = mArrivals[ ( mFirstArrivalIndex + mArrivalCount ) & ( kMaxArrivalCount - 1 ) ];
+		arrival.mLastTick = lastTick;
+		arrival.mTime = inArrivalTime;
+		++mArrivalCount;
+	}
+
+	return true;
+}
+
+void InputJitterBuffer::UpdateTransit( float inTransit )
+{
+	if( !mHasTransit )
+	{
+		mAverageTransit = inTransit;
+		mHasTransit = true;
+	}
+	else
+	{
+		mTransitDeviation += ( fabsf( inTransit - mAverageTransit ) - mTransitDeviation ) * kTransitSmoothing;
+		mAverageTransit += ( inTransit - mAverageTransit ) * kTransitSmoothing;
+	}
+
+	mHeadroom = std::min( mTransitDeviation * kHeadroomDeviations, kMaxHeadroom );
+}
+
+bool InputJitterBuffer::ReleaseDueMoves( float inTime, MoveList& outMoves )
+{
+	bool isAnyMoveReleased = false;
+
+	while( mMoves.HasMoves() )
+	{
+		const Move& move = mMoves.GetMove( 0 );
+		float arrivalTime = PopArrivalTime( move.GetTick() );
+		float releaseTime = std::min( move.GetTimestamp() + mAverageTransit + mHeadroom, arrivalTime + kMaxQueueingDelay );
+		if( inTime < releaseTime )
+		{
+			break;
+		}
+
+		float queueingDelay = inTime - arrivalTime;
+		mAverageQueueingDelay = mReleasedMoveCount == 0 ? queueingDelay : mAverageQueueingDelay + ( queueingDelay - mAverageQueueingDelay ) * kQueueingDelaySmoothing;
+		++mReleasedMoveCount;
+
+		//the move list works out the delta time again from the move before, same as it did coming in
+		outMoves.AddMoveIfNew( move.GetInputState(), move.GetTick() );
+		mMoves.RemovedProcessedMoves( move.GetTimestamp() );
+		isAnyMoveReleased = true;
+	}
+
+	return isAnyMoveReleased;
+}
+
+float InputJitterBuffer::PopArrivalTime( uint32_t inTick )
+{
+	//lets go of the packets whose moves have all gone out, then it's the oldest left
+	while( mArrivalCount > 1 && mArrivals[ mFirstArrivalIndex ].mLastTick < inTick )
+	{
+		mFirstArrivalIndex = ( mFirstArrivalIndex + 1 ) & ( kMaxArrivalCount - 1 );
+		--mArrivalCount;
+	}
+
+	return mArrivalCount > 0 ? mArrivals[ mFirstArrivalIndex ].mTime : Timing::sInstance.GetFrameStartTime();
+}
@@ -0,0 +1,175 @@
+#include <RoboCatServerPCH.h>
+
+namespace
+{
+	//how much play a crash can lose
+	const float kTimeBetweenSnapshots = 5.f;
+
+	void CreateRandomMice( int inMouseCount )
+	{
+		Vector3 mouseMin( -5.f, -3.f, 0.f );
+		Vector3 mouseMax( 5.f, 3.f, 0.f );
+		GameObjectPtr go;
+
+		//make a mouse somewhere- where will these come from?
+		for( int i = 0; i < inMouseCount; ++i )
+		{
+			go = GameObjectRegistry::sInstance->CreateGameObject( 'MOUS' );
+			Vector3 mouseLocation = RoboMath::GetRandomVector( mouseMin, mouseMax );
+			go->SetLocation( mouseLocation );
+		}
+	}
+}
+
+Match::Match( uint32_t inIndex, UDPSocketPtr inSharedSocket ) :
+	mIndex( inIndex ),
+	mWorld( new World() ),
+	mScoreBoardManager( new ScoreBoardManager() ),
+	mTimerWheel( new TimerWheel() ),
+	mPoseHistory( new PoseHistory() ),
+	mNetworkManager( nullptr ),
+	mTimeOfLastSnapshot( 0.f )
+{
+	//the network manager registers itself with whatever's current, so make it from inside
+	JobContextScope contextScope( this );
+
+	NetworkManagerServer::StaticInit( inSharedSocket, inIndex << NetworkManagerServer::kClientSlotBitCount );
+	mNetworkManager = NetworkManagerServer::sInstance;
+
+	//NetworkManagerServer::sInstance->SetDropPacketChance( 0.8f );
+	//NetworkManagerServer::sInstance->SetSimulatedLatency( 0.25f );
+	//NetworkManagerServer::sInstance->SetSimulatedLatency( 0.5f );
+	//NetworkManagerServer::sInstance->SetSimulatedLatency( 0.1f );
+	//NetworkManagerServer::sInstance->SetMaxPoseError( 0.f );
+}
+
+Match::~Match()
+{
+	//the world goes first, while the network manager its objects were registered with is still around
+	mWorld.reset();
+	mScoreBoardManager.reset();
+	mTimerWheel.reset();
+	mPoseHistory.reset();
+	delete mNetworkManager;
+}
+
+void Match::Enter()
+{
+	World::sInstance = mWorld.get();
+	ScoreBoardManager::sInstance = mScoreBoardManager.get();
+	TimerWheel::sInstance = mTimerWheel.get();
+	PoseHistory::sInstance = mPoseHistory.get();
+	NetworkManagerServer::sInstance = mNetworkManager;
+}
+
+void Match::Leave()
+{
+	World::sInstance = nullptr;
+	ScoreBoardManager::sInstance = nullptr;
+	TimerWheel::sInstance = nullptr;
+	PoseHistory::sInstance = nullptr;
+	NetworkManagerServer::sInstance = nullptr;
+}
+
+void Match::Start( const string& inSnapshotPath )
+{
+	JobContextScope contextScope( this );
+
+	//restore from the snapshot if it's there, and keep it up to date as we go
+	mSnapshotPath = inSnapshotPath;
+	if( mSnapshotPath.empty() || !LoadWorldSnapshot() )
+	{
+		SetupWorld();
+	}
+}
+
+void Match::DoFrame()
+{
+	JobContextScope contextScope( this );
+
+	{
+		AllocationPhaseScope phaseScope( EAP_Receive );
+
+		mNetworkManager->ProcessIncomingPackets();
+		mNetworkManager->ReleaseDueMoves();
+	}
+
+	{
+		AllocationPhaseScope phaseScope( EAP_Simulate );
+
+		//disconnects, respawns, ack timeouts and yarn running out- whatever's due
+		TimerWheel::sInstance->Advance( Timing::sInstance.GetFrameStartTime() );
+
+		World::sInstance->Update();
+
+		//where everyone ended up, for checking hits against what the shooters saw
+		PoseHistory::sInstance->Record( Timing::sInstance.GetFrameStartTime() );
+	}
+
+	{
+		//the packets actually going out count as sending- NetworkManager::SendPacket takes care of that
+		AllocationPhaseScope phaseScope( EAP_Replicate );
+
+		mNetworkManager->SendOutgoingPackets();
+	}
+
+	if( !mSnapshotPath.empty() && Timing::sInstance.GetTimef() > mTimeOfLastSnapshot + kTimeBetweenSnapshots )
+	{
+		SaveWorldSnapshot();
+	}
+}
+
+void Match::Shutdown()
+{
+	if( !mSnapshotPath.empty() )
+	{
+		JobContextScope contextScope( this );
+		SaveWorldSnapshot();
+	}
+}
+
+void Match::SetupWorld()
+{
+	//spawn some random mice
+	CreateRandomMice( 10 );
+	
+	//spawn more random mice!
+	CreateRandomMice( 10 );
+}
+
+bool Match::LoadWorldSnapshot()
+{
+	WorldSnapshot snapshot;
+	if( !snapshot.Open( mSnapshotPath ) )
+	{
+		return false;
+	}
+
+	const WorldSnapshot::Header& header = snapshot.GetHeader();
+	const GameObjectSnapshotRecord* records = snapshot.GetObjectRecords();
+	for( uint32_t i = 0; i < header.mObjectCount; ++i )
+	{
+		//registering hands out the next network id, so line that up with the saved one first
+		mNetworkManager->SetNextNetworkId( records[ i ].mNetworkId );
+		GameObjectPtr go = GameObjectRegistry::sInstance->CreateGameObject( records[ i ].mClassId );
+		go->ReadSnapshot( records[ i ] );
+	}
+
+	mNetworkManager->SetNextNetworkId( header.mNewNetworkId );
+	mNetworkManager->SetNextPlayerId( header.mNewPlayerId );
+
+	snapshot.RestoreScoreBoard();
+	for( const ScoreBoardManager::Entry& entry : ScoreBoardManager::sInstance->GetEntries() )
+	{
+		mNetworkManager->AddRestoredPlayer( entry.GetPlayerName(), entry.GetPlayerId() );
+	}
+
+	LOG( "Match %d restored %d objects and %d players from %s", mIndex, header.mObjectCount, header.mScoreBoardEntryCount, mSnapshotPath.c_str() );
+	return true;
+}
+
+void Match::SaveWorldSnapshot()
+{
+	WorldSnapshot::Save( mSnapshotPath, mNetworkManager->GetNextNetworkId(), mNetworkManager->GetNextPlayerId() );
+	mTimeOfLastSnapshot = Timing::sInstance.GetTimef();
+}
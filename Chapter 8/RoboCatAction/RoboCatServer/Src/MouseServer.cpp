@@ -11,14 +11,12 @@ void MouseServer::HandleDying()
 }
 
 
-bool MouseServer::HandleCollisionWithCat( RoboCat* inCat )
+void MouseServer::HandleCollisionWithCat( RoboCat* inCat )
 {
 	//kill yourself!
 	SetDoesWantToDie( true );
 
 	ScoreBoardManager::sInstance->IncScore( inCat->GetPlayerId(), 1 );
-
-	return false;
 }
 
 
@@ -1,64 +1,96 @@
 #include <RoboCatServerPCH.h>
 
-NetworkManagerServer*	NetworkManagerServer::sInstance;
+ROBOCAT_THREAD_LOCAL NetworkManagerServer*	NetworkManagerServer::sInstance = nullptr;
 
 
 NetworkManagerServer::NetworkManagerServer() :
+	mClientCount( 0 ),
+	mConnectionIdBase( 0 ),
 	mNewPlayerId( 1 ),
 	mNewNetworkId( 1 ),
 	mTimeBetweenStatePackets( 0.033f ),
-	mClientDisconnectTimeout( 3.f )
+	mClientDisconnectTimeout( 3.f ),
+	mIsEntropyCodingEnabled( false ),
+	mMaxPoseError( 0.1f ),
+	mPoseRefreshInterval( 1.f )
 {
 }
 
-bool NetworkManagerServer::StaticInit( uint16_t inPort )
+NetworkManagerServer::~NetworkManagerServer()
+{
+	ForEachClient( []( ClientProxy* inClientProxy )
+	{
+		inClientProxy->~ClientProxy();
+	} );
+}
+
+void NetworkManagerServer::StaticInit( UDPSocketPtr inSharedSocket, uint32_t inConnectionIdBase )
 {
 	sInstance = new NetworkManagerServer();
-	return sInstance->Init( inPort );
+	sInstance->mConnectionIdBase = inConnectionIdBase;
+	sInstance->Init( inSharedSocket );
 }
 
 void NetworkManagerServer::HandleConnectionReset( const SocketAddress& inFromAddress )
 {
 	//just dc the client right away...
-	auto it = mAddressToClientMap.find( inFromAddress );
-	if( it != mAddressToClientMap.end() )
+	auto it = mAddressToClientSlotMap.find( inFromAddress );
+	if( it != mAddressToClientSlotMap.end() )
 	{
-		HandleClientDisconnected( it->second );
+		HandleClientDisconnected( GetClientInSlot( it->second ) );
 	}
 }
 
 void NetworkManagerServer::ProcessPacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress )
 {
-	//try to get the client proxy for this address
-	//pass this to the client proxy to process
-	auto it = mAddressToClientMap.find( inFromAddress );
-	if( it == mAddressToClientMap.end() )
+	uint32_t	packetType = 0;
+	inInputStream.Read( packetType, kPacketTypeBitCount );
+	if( packetType == kHelloPacket )
 	{
-		//didn't find one? it's a new cilent..is the a HELO? if so, create a client proxy...
-		HandlePacketFromNewClient( inInputStream, inFromAddress );
+		HandleHelloPacket( inInputStream, inFromAddress );
+		return;
+	}
+
+	//everything else says which slot it's from, so there's nothing to look up- just check it's really them
+	uint32_t	connectionId = 0;
+	inInputStream.Read( connectionId, kConnectionIdBitCount );
+	ClientProxy* clientProxy = GetClientForConnectionId( connectionId, inFromAddress );
+	if( clientProxy )
+	{
+		ProcessPacket( clientProxy, packetType, inInputStream );
 	}
 	else
 	{
-		ProcessPacket( ( *it ).second, inInputStream );
+		//a client we've dropped, or someone using an id that isn't theirs
+		LOG( "Bad incoming packet with connection id %d from %s", connectionId, inFromAddress.ToString().c_str() );
 	}
 }
 
+ClientProxy* NetworkManagerServer::GetClientForConnectionId( uint32_t inConnectionId, const SocketAddress& inFromAddress ) const
+{
+	uint32_t slot = inConnectionId & ( kMaxClientSlotCount - 1 );
+	if( ( inConnectionId & ~( kMaxClientSlotCount - 1 ) ) != mConnectionIdBase || slot >= mClientPlayerIds.size() || mClientPlayerIds[ slot ] == 0 )
+	{
+		return nullptr;
+	}
+
+	ClientProxy* clientProxy = GetClientInSlot( slot );
+	if( !( clientProxy->GetSocketAddress() == inFromAddress ) )
+	{
+		return nullptr;
+	}
+
+	return clientProxy;
+}
 
-void NetworkManagerServer::ProcessPacket( ClientProxyPtr inClientProxy, InputMemoryBitStream& inInputStream )
+void NetworkManagerServer::ProcessPacket( ClientProxy* inClientProxy, uint32_t inPacketType, InputMemoryBitStream& inInputStream )
 {
 	//remember we got a packet so we know not to disconnect for a bit
 	inClientProxy->UpdateLastPacketTime();
 
-	uint32_t	packetType;
-	inInputStream.Read( packetType );
-	switch( packetType )
+	switch( inPacketType )
 	{
-	case kHelloCC:
-		//need to resend welcome. to be extra safe we should check the name is the one we expect from this address,
-		//otherwise something weird is going on...
-		SendWelcomePacket( inClientProxy );
-		break;
-	case kInputCC:
+	case kInputPacket:
 		if( inClientProxy->GetDeliveryNotificationManager().ReadAndProcessState( inInputStream ) )
 		{
 			HandleInputPacket( inClientProxy, inInputStream );
@@ -70,116 +102,133 @@ void NetworkManagerServer::ProcessPacket( ClientProxyPtr inClientProxy, InputMem
 	}
 }
 
+void NetworkManagerServer::HandleHelloPacket( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress )
+{
+	auto it = mAddressToClientSlotMap.find( inFromAddress );
+	if( it == mAddressToClientSlotMap.end() )
+	{
+		HandleHelloFromNewClient( inInputStream, inFromAddress );
+	}
+	else
+	{
+		//need to resend welcome. to be extra safe we should check the name is the one we expect from this address,
+		//otherwise something weird is going on...
+		ClientProxy* clientProxy = GetClientInSlot( it->second );
+		clientProxy->UpdateLastPacketTime();
+		SendWelcomePacket( clientProxy );
+	}
+}
 
-void NetworkManagerServer::HandlePacketFromNewClient( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress )
+void NetworkManagerServer::HandleHelloFromNewClient( InputMemoryBitStream& inInputStream, const SocketAddress& inFromAddress )
 {
-	//read the beginning- is it a hello?
-	uint32_t	packetType;
-	inInputStream.Read( packetType );
-	if(  packetType == kHelloCC )
+	//read the name
+	string name;
+	inInputStream.Read( name );
+	ClientProxy* newClientProxy = AddClient( inFromAddress, name, GetNewPlayerId( name ) );
+	if( !newClientProxy )
 	{
-		//read the name
-		string name;
-		inInputStream.Read( name );
-		ClientProxyPtr newClientProxy = std::make_shared< ClientProxy >( inFromAddress, name, mNewPlayerId++ );
-		mAddressToClientMap[ inFromAddress ] = newClientProxy;
-		mPlayerIdToClientMap[ newClientProxy->GetPlayerId() ] = newClientProxy;
-		
-		//tell the server about this client, spawn a cat, etc...
-		//if we had a generic message system, this would be a good use for it...
-		//instead we'll just tell the server directly
-		static_cast< Server* > ( Engine::sInstance.get() )->HandleNewClient( newClientProxy );
+		LOG( "No connection ids left, turning away %s", inFromAddress.ToString().c_str() );
+		return;
+	}
+	ScheduleDisconnectCheck( newClientProxy );
+	
+	//tell the server about this client, spawn a cat, etc...
+	//if we had a generic message system, this would be a good use for it...
+	//instead we'll just tell the server directly
+	static_cast< Server* > ( Engine::sInstance.get() )->HandleNewClient( newClientProxy );
 
-		//and welcome the client...
-		SendWelcomePacket( newClientProxy );
+	//and welcome the client...
+	SendWelcomePacket( newClientProxy );
 
-		//and now init the replication manager with everything we know about!
-		for( const auto& pair: mNetworkIdToGameObjectMap )
+	//and now init the replication manager with everything we know about!
+	for( const auto& pair: mNetworkIdToGameObjectMap )
+	{
+		//anything that's gone but not unregistered yet isn't worth telling them about
+		if( GameObject* gameObject = pair.second.Get() )
 		{
-			newClientProxy->GetReplicationManagerServer().ReplicateCreate( pair.first, pair.second->GetAllStateMask() );
+			newClientProxy->GetReplicationManagerServer().ReplicateCreate( pair.first, gameObject->GetAllStateMask() );
 		}
 	}
-	else
-	{
-		//bad incoming packet from unknown client- we're under attack!!
-		LOG( "Bad incoming packet from unknown client at socket %s", inFromAddress.ToString().c_str() );
-	}
 }
 
-void NetworkManagerServer::SendWelcomePacket( ClientProxyPtr inClientProxy )
+void NetworkManagerServer::SendWelcomePacket( ClientProxy* inClientProxy )
 {
 	OutputMemoryBitStream welcomePacket; 
 
-	welcomePacket.Write( kWelcomeCC );
+	welcomePacket.Write( kWelcomePacket, kPacketTypeBitCount );
 	welcomePacket.Write( inClientProxy->GetPlayerId() );
+	welcomePacket.Write( GetConnectionId( inClientProxy ), kConnectionIdBitCount );
 
 	LOG( "Server Welcoming, new client '%s' as player %d", inClientProxy->GetName().c_str(), inClientProxy->GetPlayerId() );
 
 	SendPacket( welcomePacket, inClientProxy->GetSocketAddress() );
 }
 
-void NetworkManagerServer::RespawnCats()
-{
-	for( auto it = mAddressToClientMap.begin(), end = mAddressToClientMap.end(); it != end; ++it )
-	{
-		ClientProxyPtr clientProxy = it->second;
-	
-		clientProxy->RespawnCatIfNecessary();
-	}
-}
-
 void NetworkManagerServer::SendOutgoingPackets()
 {
 	float time = Timing::sInstance.GetTimef();
 
 	//let's send a client a state packet whenever their move has come in...
-	for( auto it = mAddressToClientMap.begin(), end = mAddressToClientMap.end(); it != end; ++it )
+	ForEachClient( [ this ]( ClientProxy* inClientProxy )
 	{
-		ClientProxyPtr clientProxy = it->second;
-		//process any timed out packets while we're going through the list
-		clientProxy->GetDeliveryNotificationManager().ProcessTimedOutPackets();
-
-		if( clientProxy->IsLastMoveTimestampDirty() )
+		if( inClientProxy->IsLastMoveTimestampDirty() )
 		{
-			SendStatePacketToClient( clientProxy );
+			SendStatePacketToClient( inClientProxy );
 		}
-	}
+	} );
 }
 
 void NetworkManagerServer::UpdateAllClients()
 {
-	for( auto it = mAddressToClientMap.begin(), end = mAddressToClientMap.end(); it != end; ++it )
+	ForEachClient( [ this ]( ClientProxy* inClientProxy )
 	{
 		//process any timed out packets while we're going throug hthe list
-		it->second->GetDeliveryNotificationManager().ProcessTimedOutPackets();
+		inClientProxy->GetDeliveryNotificationManager().ProcessTimedOutPackets();
 
-		SendStatePacketToClient( it->second );
-	}
+		SendStatePacketToClient( inClientProxy );
+	} );
 }
 
-void NetworkManagerServer::SendStatePacketToClient( ClientProxyPtr inClientProxy )
+void NetworkManagerServer::SendStatePacketToClient( ClientProxy* inClientProxy )
 {
 	//build state packet
 	OutputMemoryBitStream	statePacket;
 
 	//it's state!
-	statePacket.Write( kStateCC );
+	statePacket.Write( kStatePacket, kPacketTypeBitCount );
 
 	InFlightPacket* ifp = inClientProxy->GetDeliveryNotificationManager().WriteState( statePacket );
+	if( !TimerWheel::sInstance->IsScheduled( inClientProxy->GetAckTimeoutTimer() ) )
+	{
+		ScheduleAckTimeout( inClientProxy );
+	}
 
 	WriteLastMoveTimestampIfDirty( statePacket, inClientProxy );
+	WriteClockTimes( statePacket, inClientProxy );
 
 	AddScoreBoardStateToPacket( statePacket );
 
-	ReplicationManagerTransmissionData* rmtd = new ReplicationManagerTransmissionData( &inClientProxy->GetReplicationManagerServer() );
-	inClientProxy->GetReplicationManagerServer().Write( statePacket, rmtd );
-	ifp->SetTransmissionData( 'RPLM', TransmissionDataPtr( rmtd ) );
+	statePacket.Write( mIsEntropyCodingEnabled );
+	if( mIsEntropyCodingEnabled )
+	{
+		inClientProxy->GetEntropyCodingContext().BeginEncoding( statePacket, ifp );
+	}
+
+	//this lives until the packet's acked or given up on, so it comes from the pools rather than the frame arena
+	ReplicationManagerTransmissionDataPtr rmtd = std::allocate_shared< ReplicationManagerTransmissionData >( PoolAllocator< ReplicationManagerTransmissionData >(), &inClientProxy->GetReplicationManagerServer() );
+	inClientProxy->GetReplicationManagerServer().Write( statePacket, rmtd.get() );
+	ifp->SetTransmissionData( 'RPLM', rmtd );
+
+	if( mIsEntropyCodingEnabled )
+	{
+		inClientProxy->GetEntropyCodingContext().EndEncoding( statePacket );
+	}
 
 	SendPacket( statePacket, inClientProxy->GetSocketAddress() );
 	
 }
 
-void NetworkManagerServer::WriteLastMoveTimestampIfDirty( OutputMemoryBitStream& inOutputStream, ClientProxyPtr inClientProxy )
+void NetworkManagerServer::WriteLastMoveTimestampIfDirty( OutputMemoryBitStream& inOutputStream, ClientProxy* inClientProxy )
 {
 	//first, dirty?
 	bool isTimestampDirty = inClientProxy->IsLastMoveTimestampDirty();
@@ -191,6 +240,20 @@ void NetworkManagerServer::WriteLastMoveTimestampIfDirty( OutputMemoryBitStream&
 	}
 }
 
+void NetworkManagerServer::WriteClockTimes( OutputMemoryBitStream& inOutputStream, ClientProxy* inClientProxy )
+{
+	inOutputStream.Write( Timing::sInstance.GetTimef() );
+
+	bool hasClockRequest = inClientProxy->HasClockRequest();
+	inOutputStream.Write( hasClockRequest );
+	if( hasClockRequest )
+	{
+		inOutputStream.Write( inClientProxy->GetClockRequestSentTime() );
+		inOutputStream.Write( inClientProxy->GetClockRequestReceivedTime() );
+		inClientProxy->ClearClockRequest();
+	}
+}
+
 //should we ask the server for this? or run through the world ourselves?
 void NetworkManagerServer::AddWorldStateToPacket( OutputMemoryBitStream& inOutputStream )
 {
@@ -199,7 +262,7 @@ void NetworkManagerServer::AddWorldStateToPacket( OutputMemoryBitStream& inOutpu
 	//now start writing objects- do we need to remember how many there are? we can check first...
 	inOutputStream.Write( gameObjects.size() );
 
-	for( GameObjectPtr gameObject : gameObjects )
+	for( const GameObjectPtr& gameObject : gameObjects )
 	{
 		inOutputStream.Write( gameObject->GetNetworkId() );
 		inOutputStream.Write( gameObject->GetClassId() );
@@ -225,65 +288,170 @@ int NetworkManagerServer::GetNewNetworkId()
 
 }
 
-void NetworkManagerServer::HandleInputPacket( ClientProxyPtr inClientProxy, InputMemoryBitStream& inInputStream )
+int NetworkManagerServer::GetNewPlayerId( const string& inName )
 {
-	uint32_t moveCount = 0;
-	Move move;
-	inInputStream.Read( moveCount, 2 );
-	
-	for( ; moveCount > 0; --moveCount )
+	//coming back after the server restored a snapshot? pick up your old cat and score
+	auto it = mNameToRestoredPlayerIdMap.find( inName );
+	if( it != mNameToRestoredPlayerIdMap.end() )
 	{
-		if( move.Read( inInputStream ) )
+		int playerId = it->second;
+		mNameToRestoredPlayerIdMap.erase( it );
+		return playerId;
+	}
+
+	return mNewPlayerId++;
+}
+
+void NetworkManagerServer::HandleInputPacket( ClientProxy* inClientProxy, InputMemoryBitStream& inInputStream )
+{
+	ReadClockRequest( inClientProxy, inInputStream );
+
+	inClientProxy->GetInputJitterBuffer().ReadAndAddNewMoves( inInputStream, Timing::sInstance.GetTimef() );
+}
+
+void NetworkManagerServer::ReleaseDueMoves()
+{
+	float time = Timing::sInstance.GetTimef();
+
+	ForEachClient( [ time ]( ClientProxy* inClientProxy )
+	{
+		//the state packet that acks them goes out once they're released, so that's at the steady rate too
+		if( inClientProxy->GetInputJitterBuffer().ReleaseDueMoves( time, inClientProxy->GetUnprocessedMoveList() ) )
 		{
-			if( inClientProxy->GetUnprocessedMoveList().AddMoveIfNew( move ) )
-			{
-				inClientProxy->SetIsLastMoveTimestampDirty( true );
-			}
+			inClientProxy->SetIsLastMoveTimestampDirty( true );
+		}
+	} );
+}
+
+void NetworkManagerServer::ReadClockRequest( ClientProxy* inClientProxy, InputMemoryBitStream& inInputStream )
+{
+	bool hasClockRequest;
+	inInputStream.Read( hasClockRequest );
+	if( hasClockRequest )
+	{
+		float sentTime;
+		inInputStream.Read( sentTime );
+		inClientProxy->SetClockRequest( sentTime, Timing::sInstance.GetTimef() );
+
+		bool hasClockOffset;
+		inInputStream.Read( hasClockOffset );
+		if( hasClockOffset )
+		{
+			float clockOffset;
+			inInputStream.Read( clockOffset );
+			inClientProxy->SetClientClockOffset( clockOffset );
 		}
 	}
 }
 
-ClientProxyPtr NetworkManagerServer::GetClientProxy( int inPlayerId ) const
+ClientProxy* NetworkManagerServer::GetClientProxy( int inPlayerId ) const
 {
-	auto it = mPlayerIdToClientMap.find( inPlayerId );
-	if( it != mPlayerIdToClientMap.end() )
+	for( uint32_t slot = 0, slotCount = static_cast< uint32_t >( mClientPlayerIds.size() ); slot < slotCount; ++slot )
 	{
-		return it->second;
+		if( mClientPlayerIds[ slot ] == inPlayerId )
+		{
+			return GetClientInSlot( slot );
+		}
 	}
 
 	return nullptr;
 }
 
-void NetworkManagerServer::CheckForDisconnects()
+ClientProxy* NetworkManagerServer::AddClient( const SocketAddress& inSocketAddress, const string& inName, int inPlayerId )
 {
-	vector< ClientProxyPtr > clientsToDC;
-
-	float minAllowedLastPacketFromClientTime = Timing::sInstance.GetTimef() - mClientDisconnectTimeout;
-	for( const auto& pair: mAddressToClientMap )
+	uint32_t slot;
+	if( !mFreeClientSlots.empty() )
 	{
-		if( pair.second->GetLastPacketFromClientTime() < minAllowedLastPacketFromClientTime )
+		slot = mFreeClientSlots.back();
+		mFreeClientSlots.pop_back();
+	}
+	else if( mClientPlayerIds.size() == kMaxClientSlotCount )
+	{
+		//the slot has to fit in the connection id
+		return nullptr;
+	}
+	else
+	{
+		slot = static_cast< uint32_t >( mClientPlayerIds.size() );
+		if( slot % kClientSlotsPerPage == 0 )
 		{
-			//can't remove from map while in iterator, so just remember for later...
-			clientsToDC.push_back( pair.second );
+			mClientPages.emplace_back( new ClientPage() );
 		}
+		mClientPlayerIds.push_back( 0 );
 	}
 
-	for( ClientProxyPtr client: clientsToDC )
+	ClientProxy* clientProxy = new( &mClientPages[ slot / kClientSlotsPerPage ]->mSlots[ slot % kClientSlotsPerPage ] ) ClientProxy( inSocketAddress, inName, inPlayerId );
+	mClientPlayerIds[ slot ] = inPlayerId;
+	clientProxy->SetClientSlot( slot );
+	mAddressToClientSlotMap[ inSocketAddress ] = slot;
+	++mClientCount;
+
+	return clientProxy;
+}
+
+void NetworkManagerServer::RemoveClient( ClientProxy* inClientProxy )
+{
+	uint32_t slot = inClientProxy->GetClientSlot();
+	assert( GetClientInSlot( slot ) == inClientProxy );
+
+	mAddressToClientSlotMap.erase( inClientProxy->GetSocketAddress() );
+	mClientPlayerIds[ slot ] = 0;
+	inClientProxy->~ClientProxy();
+	mFreeClientSlots.push_back( slot );
+	--mClientCount;
+}
+
+void NetworkManagerServer::HandleClientDisconnected( ClientProxy* inClientProxy )
+{
+	inClientProxy->CancelTimers();
+	//the server gets to look at them before they're gone
+	static_cast< Server* > ( Engine::sInstance.get() )->HandleLostClient( inClientProxy );
+	RemoveClient( inClientProxy );
+}
+
+void NetworkManagerServer::ScheduleDisconnectCheck( ClientProxy* inClientProxy )
+{
+	//packets don't move the timer- when it goes off, it looks at when the last one came in and either drops the client or waits some more
+	uint32_t clientSlot = inClientProxy->GetClientSlot();
+	inClientProxy->SetDisconnectTimer( TimerWheel::sInstance->ScheduleAt( inClientProxy->GetLastPacketFromClientTime() + mClientDisconnectTimeout, [ clientSlot ]()
+	{
+		NetworkManagerServer::sInstance->HandleDisconnectCheck( clientSlot );
+	} ) );
+}
+
+void NetworkManagerServer::HandleDisconnectCheck( uint32_t inClientSlot )
+{
+	ClientProxy* clientProxy = GetClientInSlot( inClientSlot );
+
+	if( clientProxy->GetLastPacketFromClientTime() < Timing::sInstance.GetTimef() - mClientDisconnectTimeout )
 	{
-		HandleClientDisconnected( client );
+		HandleClientDisconnected( clientProxy );
+	}
+	else
+	{
+		ScheduleDisconnectCheck( clientProxy );
 	}
 }
 
-void NetworkManagerServer::HandleClientDisconnected( ClientProxyPtr inClientProxy )
+void NetworkManagerServer::ScheduleAckTimeout( ClientProxy* inClientProxy )
 {
-	mPlayerIdToClientMap.erase( inClientProxy->GetPlayerId() );
-	mAddressToClientMap.erase( inClientProxy->GetSocketAddress() );
-	static_cast< Server* > ( Engine::sInstance.get() )->HandleLostClient( inClientProxy );
+	uint32_t clientSlot = inClientProxy->GetClientSlot();
+	inClientProxy->SetAckTimeoutTimer( TimerWheel::sInstance->ScheduleAt( inClientProxy->GetDeliveryNotificationManager().GetNextTimeoutTime(), [ clientSlot ]()
+	{
+		NetworkManagerServer::sInstance->HandleAckTimeout( clientSlot );
+	} ) );
+}
+
+void NetworkManagerServer::HandleAckTimeout( uint32_t inClientSlot )
+{
+	ClientProxy* clientProxy = GetClientInSlot( inClientSlot );
 
-	//was that the last client? if so, bye!
-	if( mAddressToClientMap.empty() )
+	//acks may have emptied the queue since this was scheduled- then there's nothing to wait for until the next state packet
+	DeliveryNotificationManager& deliveryNotificationManager = clientProxy->GetDeliveryNotificationManager();
+	deliveryNotificationManager.ProcessTimedOutPackets();
+	if( !deliveryNotificationManager.GetInFlightPackets().empty() )
 	{
-		Engine::sInstance->SetShouldKeepRunning( false );
+		ScheduleAckTimeout( clientProxy );
 	}
 }
 
@@ -294,13 +462,14 @@ void NetworkManagerServer::RegisterGameObject( GameObjectPtr inGameObject )
 	inGameObject->SetNetworkId( newNetworkId );
 
 	//add mapping from network id to game object
-	mNetworkIdToGameObjectMap[ newNetworkId ] = inGameObject;
+	mNetworkIdToGameObjectMap[ newNetworkId ] = inGameObject->GetHandle();
 
 	//tell all client proxies this is new...
-	for( const auto& pair: mAddressToClientMap )
+	uint32_t allStateMask = inGameObject->GetAllStateMask();
+	ForEachClient( [ newNetworkId, allStateMask ]( ClientProxy* inClientProxy )
 	{
-		pair.second->GetReplicationManagerServer().ReplicateCreate( newNetworkId, inGameObject->GetAllStateMask() );
-	}
+		inClientProxy->GetReplicationManagerServer().ReplicateCreate( newNetworkId, allStateMask );
+	} );
 }
 
 
@@ -311,18 +480,27 @@ void NetworkManagerServer::UnregisterGameObject( GameObject* inGameObject )
 
 	//tell all client proxies to STOP replicating!
 	//tell all client proxies this is new...
-	for( const auto& pair: mAddressToClientMap )
+	ForEachClient( [ networkId ]( ClientProxy* inClientProxy )
 	{
-		pair.second->GetReplicationManagerServer().ReplicateDestroy( networkId );
-	}
+		inClientProxy->GetReplicationManagerServer().ReplicateDestroy( networkId );
+	} );
 }
 
 void NetworkManagerServer::SetStateDirty( int inNetworkId, uint32_t inDirtyState )
 {
 	//tell everybody this is dirty
-	for( const auto& pair: mAddressToClientMap )
+	ForEachClient( [ inNetworkId, inDirtyState ]( ClientProxy* inClientProxy )
+	{
+		inClientProxy->GetReplicationManagerServer().SetStateDirty( inNetworkId, inDirtyState );
+	} );
+}
+
+void NetworkManagerServer::SetStateDirtyForPlayer( int inPlayerId, int inNetworkId, uint32_t inDirtyState )
+{
+	ClientProxy* clientProxy = GetClientProxy( inPlayerId );
+	if( clientProxy )
 	{
-		pair.second->GetReplicationManagerServer().SetStateDirty( inNetworkId, inDirtyState );
+		clientProxy->GetReplicationManagerServer().SetStateDirty( inNetworkId, inDirtyState );
 	}
 }
 
@@ -0,0 +1,130 @@
+#include <RoboCatServerPCH.h>
+
+namespace
+{
+	//a second's worth, a sample per 1/64th- about a frame at 60
+	const float kHistoryDuration = 1.f;
+	const float kSampleInterval = kHistoryDuration / PoseHistory::kSampleCount;
+
+	//far enough off the map that nothing's ever close to it
+	const float kNowhere = 1.e6f;
+}
+
+ROBOCAT_THREAD_LOCAL PoseHistory*	PoseHistory::sInstance = nullptr;
+
+PoseHistory::PoseHistory() :
+	mNewestSampleIndex( kSampleCount - 1 ),
+	mSampleCount( 0 )
+{
+	for( uint32_t i = 0; i < kMaxCatCount; ++i )
+	{
+		ClearSlot( i );
+	}
+}
+
+uint32_t PoseHistory::AddCat( RoboCat* inCat )
+{
+	for( uint32_t i = 0; i < kMaxCatCount; ++i )
+	{
+		if( mCats[ i ].IsNull() )
+		{
+			//whoever had it last might still be in the older samples
+			ClearSlot( i );
+			mCats[ i ] = inCat->GetHandle();
+			mCollisionRadii[ i ] = inCat->GetCollisionRadius();
+			return i;
+		}
+	}
+
+	return kNoSlot;
+}
+
+void PoseHistory::RemoveCat( uint32_t inSlot )
+{
+	if( inSlot != kNoSlot )
+	{
+		ClearSlot( inSlot );
+	}
+}
+
+void PoseHistory::ClearSlot( uint32_t inSlot )
+{
+	mCats[ inSlot ] = GameObjectHandle();
+	mCollisionRadii[ inSlot ] = 0.f;
+	for( Sample& sample : mSamples )
+	{
+		sample.mLocationXs[ inSlot ] = kNowhere;
+		sample.mLocationYs[ inSlot ] = kNowhere;
+	}
+}
+
+void PoseHistory::Record( float inTime )
+{
+	//the server loop can run far faster than we sample, so most frames just bring the newest sample up to date
+	if( mSampleCount < 2 ||
+		mSamples[ mNewestSampleIndex ].mTime >= mSamples[ ( mNewestSampleIndex - 1 ) & ( kSampleCount - 1 ) ].mTime + kSampleInterval )
+	{
+		mNewestSampleIndex = ( mNewestSampleIndex + 1 ) & ( kSampleCount - 1 );
+		mSampleCount = std::min( mSampleCount + 1, kSampleCount );
+	}
+
+	Sample& sample = mSamples[ mNewestSampleIndex ];
+	sample.mTime = inTime;
+	for( uint32_t i = 0; i < kMaxCatCount; ++i )
+	{
+		GameObject* cat = mCats[ i ].Get();
+		Vector3 location = cat ? cat->GetLocation() : Vector3( kNowhere, kNowhere, 0.f );
+		sample.mLocationXs[ i ] = location.mX;
+		sample.mLocationYs[ i ] = location.mY;
+	}
+}
+
+RoboCat* PoseHistory::FindCatAt( float inTime, const Vector3& inLocation, float inRadius, int inIgnoredPlayerId ) const
+{
+	if( mSampleCount == 0 )
+	{
+		return nullptr;
+	}
+
+	//walk back to the newest sample that's no newer than the time- the one after it is the other end of the blend
+	uint32_t olderIndex = mNewestSampleIndex;
+	uint32_t newerIndex = mNewestSampleIndex;
+	for( uint32_t i = 1; i < mSampleCount && mSamples[ olderIndex ].mTime > inTime; ++i )
+	{
+		newerIndex = olderIndex;
+		olderIndex = ( mNewestSampleIndex - i ) & ( kSampleCount - 1 );
+	}
+
+	const Sample& older = mSamples[ olderIndex ];
+	const Sample& newer = mSamples[ newerIndex ];
+	float span = newer.mTime - older.mTime;
+	float fraction = span > 0.f ? std::min( std::max( ( inTime - older.mTime ) / span, 0.f ), 1.f ) : 0.f;
+
+	float locationXs[ kMaxCatCount ];
+	float locationYs[ kMaxCatCount ];
+	for( uint32_t i = 0; i < kMaxCatCount; ++i )
+	{
+		locationXs[ i ] = older.mLocationXs[ i ] + ( newer.mLocationXs[ i ] - older.mLocationXs[ i ] ) * fraction;
+		locationYs[ i ] = older.mLocationYs[ i ] + ( newer.mLocationYs[ i ] - older.mLocationYs[ i ] ) * fraction;
+	}
+
+	float distancesSq[ kMaxCatCount ];
+	RoboMath::DistanceSq2DBatch( inLocation, locationXs, locationYs, kMaxCatCount, distancesSq );
+
+	for( uint32_t i = 0; i < kMaxCatCount; ++i )
+	{
+		float collisionDist = inRadius + mCollisionRadii[ i ];
+		if( distancesSq[ i ] >= collisionDist * collisionDist )
+		{
+			continue;
+		}
+
+		RoboCat* cat = static_cast< RoboCat* >( mCats[ i ].Get() );
+		if( cat && !cat->DoesWantToDie() && static_cast< int >( cat->GetPlayerId() ) != inIgnoredPlayerId )
+		{
+			return cat;
+		}
+	}
+
+	return nullptr;
+}
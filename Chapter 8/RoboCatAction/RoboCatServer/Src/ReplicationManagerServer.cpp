@@ -28,6 +28,9 @@ void ReplicationManagerServer::HandleCreateAckd( int inNetworkId )
 
 void ReplicationManagerServer::Write( OutputMemoryBitStream& inOutputStream, ReplicationManagerTransmissionData* ioTransmissinData )
 {
+	//a range coded stream doesn't know where it ends, so flag each entry instead of reading until we run out
+	bool isEntropyCoded = inOutputStream.GetEntropyCodingContext() != nullptr;
+
 	//run through each replication command and do something...
 	for( auto& pair: mNetworkIdToReplicationCommand )
 	{
@@ -36,6 +39,12 @@ void ReplicationManagerServer::Write( OutputMemoryBitStream& inOutputStream, Rep
 		{
 			int networkId = pair.first;
 
+			inOutputStream.BeginEntropyCodedObject( EntropyFieldRegistry::kReplicationHeaderClassId );
+			if( isEntropyCoded )
+			{
+				inOutputStream.Write( true );
+			}
+
 			//well, first write the network id...
 			inOutputStream.Write( networkId );
 
@@ -68,22 +77,29 @@ void ReplicationManagerServer::Write( OutputMemoryBitStream& inOutputStream, Rep
 
 		}
 	}
+
+	if( isEntropyCoded )
+	{
+		inOutputStream.BeginEntropyCodedObject( EntropyFieldRegistry::kReplicationHeaderClassId );
+		inOutputStream.Write( false );
+	}
 }
 
 
 uint32_t ReplicationManagerServer::WriteCreateAction( OutputMemoryBitStream& inOutputStream, int inNetworkId, uint32_t inDirtyState )
 {
 	//need object
-	GameObjectPtr gameObject = NetworkManagerServer::sInstance->GetGameObject( inNetworkId );
+	GameObject* gameObject = NetworkManagerServer::sInstance->GetGameObject( inNetworkId );
 	//need 4 cc
 	inOutputStream.Write( gameObject->GetClassId() );
+	inOutputStream.BeginEntropyCodedObject( gameObject->GetClassId() );
 	return gameObject->Write( inOutputStream, inDirtyState );
 }
 
 uint32_t ReplicationManagerServer::WriteUpdateAction( OutputMemoryBitStream& inOutputStream, int inNetworkId, uint32_t inDirtyState )
 {
 	//need object
-	GameObjectPtr gameObject = NetworkManagerServer::sInstance->GetGameObject( inNetworkId );
+	GameObject* gameObject = NetworkManagerServer::sInstance->GetGameObject( inNetworkId );
 
 	//if we can't find the gameObject on the other side, we won't be able to read the written data ( since we won't know which class wrote it )
 	//so we need to know how many bytes to skip.
@@ -91,6 +107,7 @@ uint32_t ReplicationManagerServer::WriteUpdateAction( OutputMemoryBitStream& inO
 
 	//this means we need byte sand each new object needs to be byte aligned
 
+	inOutputStream.BeginEntropyCodedObject( gameObject->GetClassId() );
 	uint32_t writtenState = gameObject->Write( inOutputStream, inDirtyState );
 
 	return writtenState;
@@ -59,7 +59,7 @@ void ReplicationManagerTransmissionData::HandleDeliverySuccess( DeliveryNotifica
 void ReplicationManagerTransmissionData::HandleCreateDeliveryFailure( int inNetworkId ) const
 {
 	//does the object still exist? it might be dead, in which case we don't resend a create
-	GameObjectPtr gameObject = NetworkManagerServer::sInstance->GetGameObject( inNetworkId );
+	GameObject* gameObject = NetworkManagerServer::sInstance->GetGameObject( inNetworkId );
 	if( gameObject )
 	{
 		mReplicationManagerServer->ReplicateCreate( inNetworkId, gameObject->GetAllStateMask() );
@@ -1,77 +1,157 @@
 #include <RoboCatServerPCH.h>
 
+namespace
+{
+	//nothing extrapolates rotation, so it goes when it's turned a degree or so
+	const float kMaxRotationError = 0.02f;
+}
+
 RoboCatServer::RoboCatServer() :
 	mCatControlType( ESCT_Human ),
-	mTimeOfNextShot( 0.f ),
-	mTimeBetweenShots( 0.2f )
+	mPoseHistorySlot( PoseHistory::sInstance->AddCat( this ) ),
+	mShotCount( 0 ),
+	mRotationBeforeUpdate( 0.f ),
+	mSentRotation( 0.f ),
+	mTimeOfSentPose( 0.f )
 {}
 
 void RoboCatServer::HandleDying()
 {
+	PoseHistory::sInstance->RemoveCat( mPoseHistorySlot );
+
 	NetworkManagerServer::sInstance->UnregisterGameObject( this );
 }
 
-void RoboCatServer::Update()
+void RoboCatServer::ParallelUpdate()
 {
-	RoboCat::Update();
-	
-	Vector3 oldLocation = GetLocation();
-	Vector3 oldVelocity = GetVelocity();
-	float oldRotation = GetRotation();
+	//remember where we started, so Update can tell whether anything changed
+	mLocationBeforeUpdate = GetLocation();
+	mVelocityBeforeUpdate = GetVelocity();
+	mRotationBeforeUpdate = GetRotation();
+	mShotCount = 0;
 
 	//are you controlled by a player?
 	//if so, is there a move we haven't processed yet?
 	if( mCatControlType == ESCT_Human )
 	{
-		ClientProxyPtr client = NetworkManagerServer::sInstance->GetClientProxy( GetPlayerId() );
-		if( client )
-		{
-			MoveList& moveList = client->GetUnprocessedMoveList();
-			for( const Move& unprocessedMove : moveList )
-			{
-				const InputState& currentState = unprocessedMove.GetInputState();
-
-				float deltaTime = unprocessedMove.GetDeltaTime();
-
-				ProcessInput( deltaTime, currentState );
-				SimulateMovement( deltaTime );
-
-				//LOG( "Server Move Time: %3.4f deltaTime: %3.4f left rot at %3.4f", unprocessedMove.GetTimestamp(), deltaTime, GetRotation() );
-
-			}
-
-			moveList.Clear();
-		}
+		ProcessMoves();
 	}
 	else
 	{
 		//do some AI stuff
 		SimulateMovement( Timing::sInstance.GetDeltaTime() );
 	}
+}
+
+void RoboCatServer::Update()
+{
+	RoboCat::Update();
+
+	//everyone's finished moving, so the mice we landed on can be eaten- in world order, so the same cat always gets there first
+	HandleTouchedObjects();
 
 	HandleShooting();
 
-	if( !RoboMath::Is2DVectorEqual( oldLocation, GetLocation() ) ||
-		!RoboMath::Is2DVectorEqual( oldVelocity, GetVelocity() ) ||
-		oldRotation != GetRotation() )
+	float time = Timing::sInstance.GetFrameStartTime();
+	if( IsSentPoseStale( time ) )
 	{
 		NetworkManagerServer::sInstance->SetStateDirty( GetNetworkId(), ECRS_Pose );
+		RecordSentPose( time );
+	}
+	else if( !RoboMath::Is2DVectorEqual( mLocationBeforeUpdate, GetLocation() ) ||
+		!RoboMath::Is2DVectorEqual( mVelocityBeforeUpdate, GetVelocity() ) ||
+		mRotationBeforeUpdate != GetRotation() )
+	{
+		//our own player still gets every change- they check their prediction against it, not an extrapolation
+		NetworkManagerServer::sInstance->SetStateDirtyForPlayer( GetPlayerId(), GetNetworkId(), ECRS_Pose );
 	}
 
 }
 
-void RoboCatServer::HandleShooting()
+bool RoboCatServer::IsSentPoseStale( float inTime ) const
 {
-	float time = Timing::sInstance.GetFrameStartTime();
-	if( mIsShooting && Timing::sInstance.GetFrameStartTime() > mTimeOfNextShot )
+	if( RoboMath::Is2DVectorEqual( mSentLocation, GetLocation() ) &&
+		RoboMath::Is2DVectorEqual( mSentVelocity, GetVelocity() ) &&
+		mSentRotation == GetRotation() )
 	{
-		//not exact, but okay
-		mTimeOfNextShot = time + mTimeBetweenShots;
+		return false;
+	}
+
+	//the extrapolation only ever drifts within the error, so now and then send the real thing anyway
+	float timeSinceSentPose = inTime - mTimeOfSentPose;
+	if( timeSinceSentPose > NetworkManagerServer::sInstance->GetPoseRefreshInterval() )
+	{
+		return true;
+	}
 
-		//fire!
+	float maxPoseError = NetworkManagerServer::sInstance->GetMaxPoseError();
+	if( maxPoseError <= 0.f )
+	{
+		return true;
+	}
+
+	Vector3 extrapolatedLocation = mSentLocation + mSentVelocity * timeSinceSentPose;
+	return ( extrapolatedLocation - GetLocation() ).LengthSq2D() > maxPoseError * maxPoseError ||
+		fabsf( mSentRotation - GetRotation() ) > kMaxRotationError;
+}
+
+void RoboCatServer::RecordSentPose( float inTime )
+{
+	mSentLocation = GetLocation();
+	mSentVelocity = GetVelocity();
+	mSentRotation = GetRotation();
+	mTimeOfSentPose = inTime;
+}
+
+void RoboCatServer::ProcessMoves()
+{
+	ClientProxy* client = NetworkManagerServer::sInstance->GetClientProxy( GetPlayerId() );
+	if( !client )
+	{
+		return;
+	}
+
+	//every move collides as it goes, same as the client's prediction and replay- against where the other cats were as the frame started,
+	//so it doesn't matter what the threads running them are up to
+	MoveList& moveList = client->GetUnprocessedMoveList();
+	for( int i = 0, c = moveList.GetMoveCount(); i < c; ++i )
+	{
+		const Move& unprocessedMove = moveList.GetMove( i );
+		const InputState& currentState = unprocessedMove.GetInputState();
+
+		float deltaTime = unprocessedMove.GetDeltaTime();
+
+		ProcessInput( deltaTime, currentState );
+		SimulateMovement( deltaTime );
+
+		//a frame's worth of moves only has room for a shot or two, so running out means we're way behind anyway
+		if( TryShoot( unprocessedMove.GetTick() ) && mShotCount < kMaxShotsPerUpdate )
+		{
+			Shot& shot = mShots[ mShotCount++ ];
+			shot.mTick = unprocessedMove.GetTick();
+			shot.mLocation = GetLocation();
+			shot.mVelocity = GetVelocity();
+			shot.mRotation = GetRotation();
+		}
+
+		//LOG( "Server Move Time: %3.4f deltaTime: %3.4f left rot at %3.4f", unprocessedMove.GetTimestamp(), deltaTime, GetRotation() );
+
+	}
+
+	moveList.Clear();
+}
+
+void RoboCatServer::HandleShooting()
+{
+	for( uint32_t i = 0; i < mShotCount; ++i )
+	{
+		//fire! the shooter's client fired this one already, and the tick tells it which one it was
 		YarnPtr yarn = std::static_pointer_cast< Yarn >( GameObjectRegistry::sInstance->CreateGameObject( 'YARN' ) );
-		yarn->InitFromShooter( this );
+		const Shot& shot = mShots[ i ];
+		yarn->InitFromShooter( this, shot.mLocation, shot.mVelocity, shot.mRotation );
+		yarn->SetShotTick( shot.mTick );
 	}
+	mShotCount = 0;
 }
 
 void RoboCatServer::TakeDamage( int inDamagingPlayerId )
@@ -86,7 +166,7 @@ void RoboCatServer::TakeDamage( int inDamagingPlayerId )
 		SetDoesWantToDie( true );
 
 		//tell the client proxy to make you a new cat
-		ClientProxyPtr clientProxy = NetworkManagerServer::sInstance->GetClientProxy( GetPlayerId() );
+		ClientProxy* clientProxy = NetworkManagerServer::sInstance->GetClientProxy( GetPlayerId() );
 		if( clientProxy )
 		{
 			clientProxy->HandleCatDied();
@@ -5,6 +5,16 @@
 
 //uncomment this when you begin working on the server
 
+namespace
+{
+	const uint32_t kMaxClientsPerMatch = 64;
+
+	const int kMaxMatchCount = 1 << ( NetworkManager::kConnectionIdBitCount - NetworkManagerServer::kClientSlotBitCount );
+
+	//how often to forget the addresses of clients that have left
+	const float kTimeBetweenRoutePrunes = 1.f;
+}
+
 bool Server::StaticInit()
 {
 	sInstance.reset( new Server() );
@@ -12,91 +22,287 @@ bool Server::StaticInit()
 	return true;
 }
 
-Server::Server()
+Server::Server() :
+	mTimeOfLastRoutePrune( 0.f ),
+	mHasLostClient( false )
 {
 
 	GameObjectRegistry::sInstance->RegisterCreationFunction( 'RCAT', RoboCatServer::StaticCreate );
 	GameObjectRegistry::sInstance->RegisterCreationFunction( 'MOUS', MouseServer::StaticCreate );
 	GameObjectRegistry::sInstance->RegisterCreationFunction( 'YARN', YarnServer::StaticCreate );
 
-	InitNetworkManager();
-	
-	//NetworkManagerServer::sInstance->SetDropPacketChance( 0.8f );
-	//NetworkManagerServer::sInstance->SetSimulatedLatency( 0.25f );
-	//NetworkManagerServer::sInstance->SetSimulatedLatency( 0.5f );
-	//NetworkManagerServer::sInstance->SetSimulatedLatency( 0.1f );
+	InitNetworking();
 
 }
 
 
 int Server::Run()
 {
-	SetupWorld();
+	//optional second argument is a snapshot file- with more than one match, each gets its own with the match index on the end
+	string snapshotPath = StringUtils::GetCommandLineArg( 2 );
+	for( const MatchPtr& match : mMatches )
+	{
+		if( snapshotPath.empty() || mMatches.size() == 1 )
+		{
+			match->Start( snapshotPath );
+		}
+		else
+		{
+			match->Start( StringUtils::Sprintf( "%s.%d", snapshotPath.c_str(), match->GetIndex() ) );
+		}
+	}
+
+	int result = Engine::Run();
 
-	return Engine::Run();
+	for( const MatchPtr& match : mMatches )
+	{
+		match->Shutdown();
+	}
+
+	if( mSoakBenchmark )
+	{
+		return mSoakBenchmark->Finish() ? 0 : 1;
+	}
+
+	return result;
 }
 
-bool Server::InitNetworkManager()
+bool Server::InitNetworking()
 {
 	string portString = StringUtils::GetCommandLineArg( 1 );
 	uint16_t port = stoi( portString );
 
-	return NetworkManagerServer::StaticInit( port );
-}
+	//optional third argument is how many matches to host
+	string matchCountString = StringUtils::GetCommandLineArg( 3 );
+	int matchCount = matchCountString.empty() ? 1 : std::max( stoi( matchCountString ), 1 );
+	//the match index has to fit in the top of a connection id
+	matchCount = std::min( matchCount, kMaxMatchCount );
 
+	mSocket = SocketUtil::CreateUDPSocket( INET );
+	if( mSocket == nullptr )
+	{
+		return false;
+	}
 
-namespace
+	mSocket->Bind( SocketAddress( INADDR_ANY, port ) );
+	if( mSocket->SetNonBlockingMode( true ) != NO_ERROR )
+	{
+		return false;
+	}
+
+	LOG( "Hosting %d matches at port %d", matchCount, port );
+
+	//optional fifth argument "entropy" range codes the state packets- pass an empty fourth to get it without the soak
+	bool isEntropyCodingEnabled = StringUtils::GetCommandLineArg( 5 ) == "entropy";
+
+	for( int i = 0; i < matchCount; ++i )
+	{
+		mMatches.emplace_back( new Match( i, mSocket ) );
+		mMatches.back()->GetNetworkManager()->SetIsEntropyCodingEnabled( isEntropyCodingEnabled );
+	}
+
+	//optional fourth argument soaks the server with that many fake players instead of waiting for real ones
+	string soakClientCountString = StringUtils::GetCommandLineArg( 4 );
+	if( !soakClientCountString.empty() )
+	{
+		mSoakBenchmark.reset( new SoakBenchmark( port, stoi( soakClientCountString ) ) );
+	}
+
+	return true;
+}
+
+void Server::DoFrame()
 {
-	
-	void CreateRandomMice( int inMouseCount )
+	if( mSoakBenchmark )
 	{
-		Vector3 mouseMin( -5.f, -3.f, 0.f );
-		Vector3 mouseMax( 5.f, 3.f, 0.f );
-		GameObjectPtr go;
+		mSoakBenchmark->Update();
+	}
 
-		//make a mouse somewhere- where will these come from?
-		for( int i = 0; i < inMouseCount; ++i )
+	{
+		AllocationPhaseScope phaseScope( EAP_Receive );
+
+		ReadIncomingPackets();
+	}
+
+	//a match a job- each one's world update then shares out its objects on the same pool
+	JobSystem::sInstance->ParallelFor( static_cast< uint32_t >( mMatches.size() ), 1, [ this ]( uint32_t inBegin, uint32_t inEnd )
+	{
+		for( uint32_t i = inBegin; i < inEnd; ++i )
 		{
-			go = GameObjectRegistry::sInstance->CreateGameObject( 'MOUS' );
-			Vector3 mouseLocation = RoboMath::GetRandomVector( mouseMin, mouseMax );
-			go->SetLocation( mouseLocation );
+			mMatches[ i ]->DoFrame();
 		}
-	}
+	} );
 
+	//was that the last client in any match? if so, bye!
+	if( mHasLostClient.exchange( false ) && GetClientCount() == 0 )
+	{
+		SetShouldKeepRunning( false );
+	}
 
+	if( Timing::sInstance.GetTimef() > mTimeOfLastRoutePrune + kTimeBetweenRoutePrunes )
+	{
+		PruneRoutes();
+	}
 }
 
+void Server::ReadIncomingPackets()
+{
+	char packetMem[ 1500 ];
+	int packetSize = sizeof( packetMem );
+	SocketAddress fromAddress;
+
+	//each match gets the per frame packet budget it would have had with a socket of its own
+	int maxPacketCount = NetworkManager::kMaxPacketsPerFrameCount * static_cast< int >( mMatches.size() );
+	int receivedPacketCount = 0;
 
-void Server::SetupWorld()
+	while( receivedPacketCount < maxPacketCount )
+	{
+		int readByteCount = mSocket->ReceiveFrom( packetMem, packetSize, fromAddress );
+		if( readByteCount == 0 )
+		{
+			//nothing to read
+			break;
+		}
+		else if( readByteCount == -WSAECONNRESET )
+		{
+			//port closed on other end, so whichever match has this person should DC them immediately
+			auto it = mAddressToMatchMap.find( fromAddress );
+			if( it != mAddressToMatchMap.end() )
+			{
+				Match* match = it->second;
+				{
+					JobContextScope contextScope( match );
+					match->GetNetworkManager()->HandleConnectionReset( fromAddress );
+				}
+				mAddressToMatchMap.erase( it );
+			}
+		}
+		else if( readByteCount > 0 )
+		{
+			++receivedPacketCount;
+
+			InputMemoryBitStream inputStream( packetMem, readByteCount * 8 );
+
+			//peek at the header with a second stream, so the match still gets to read it from the top
+			InputMemoryBitStream peekStream( packetMem, readByteCount * 8 );
+			Match* match = GetMatchForPacket( peekStream, fromAddress );
+			if( match )
+			{
+				match->GetNetworkManager()->QueuePacket( inputStream, fromAddress );
+			}
+		}
+	}
+}
+
+Match* Server::GetMatchForPacket( InputMemoryBitStream& inPeekStream, const SocketAddress& inFromAddress )
 {
-	//spawn some random mice
-	CreateRandomMice( 10 );
-	
-	//spawn more random mice!
-	CreateRandomMice( 10 );
+	uint32_t packetType = 0;
+	inPeekStream.Read( packetType, NetworkManager::kPacketTypeBitCount );
+	if( packetType == NetworkManager::kHelloPacket )
+	{
+		return GetMatchForHello( inFromAddress );
+	}
+
+	//the match is the top of the connection id. whether the client's really in it, and really who they say, is the match's to check
+	uint32_t connectionId = 0;
+	inPeekStream.Read( connectionId, NetworkManager::kConnectionIdBitCount );
+	uint32_t matchIndex = connectionId >> NetworkManagerServer::kClientSlotBitCount;
+	if( matchIndex >= mMatches.size() )
+	{
+		//bad incoming packet from unknown client- we're under attack!!
+		LOG( "Bad incoming packet from unknown client at socket %s", inFromAddress.ToString().c_str() );
+		return nullptr;
+	}
+
+	return mMatches[ matchIndex ].get();
 }
 
-void Server::DoFrame()
+Match* Server::GetMatchForHello( const SocketAddress& inFromAddress )
 {
-	NetworkManagerServer::sInstance->ProcessIncomingPackets();
+	auto it = mAddressToMatchMap.find( inFromAddress );
+	if( it != mAddressToMatchMap.end() )
+	{
+		return it->second;
+	}
 
-	NetworkManagerServer::sInstance->CheckForDisconnects();
+	//a match can know a client we've pruned- its hello was still sitting in a simulated latency queue, say
+	for( const MatchPtr& match : mMatches )
+	{
+		if( match->GetNetworkManager()->HasClient( inFromAddress ) )
+		{
+			mAddressToMatchMap[ inFromAddress ] = match.get();
+			return match.get();
+		}
+	}
 
-	NetworkManagerServer::sInstance->RespawnCats();
+	//new client, so put them in the emptiest match. count routes rather than clients, so hellos that haven't been processed yet count too
+	vector< uint32_t > routeCounts( mMatches.size(), 0 );
+	for( const auto& pair : mAddressToMatchMap )
+	{
+		++routeCounts[ pair.second->GetIndex() ];
+	}
 
-	Engine::DoFrame();
+	Match* emptiestMatch = nullptr;
+	for( const MatchPtr& match : mMatches )
+	{
+		uint32_t routeCount = routeCounts[ match->GetIndex() ];
+		if( routeCount < kMaxClientsPerMatch && ( !emptiestMatch || routeCount < routeCounts[ emptiestMatch->GetIndex() ] ) )
+		{
+			emptiestMatch = match.get();
+		}
+	}
+
+	if( !emptiestMatch )
+	{
+		LOG( "Every match is full, turning away %s", inFromAddress.ToString().c_str() );
+		return nullptr;
+	}
+
+	mAddressToMatchMap[ inFromAddress ] = emptiestMatch;
+	return emptiestMatch;
+}
+
+void Server::PruneRoutes()
+{
+	for( auto it = mAddressToMatchMap.begin(); it != mAddressToMatchMap.end(); )
+	{
+		if( it->second->GetNetworkManager()->HasClient( it->first ) )
+		{
+			++it;
+		}
+		else
+		{
+			it = mAddressToMatchMap.erase( it );
+		}
+	}
 
-	NetworkManagerServer::sInstance->SendOutgoingPackets();
+	mTimeOfLastRoutePrune = Timing::sInstance.GetTimef();
+}
 
+uint32_t Server::GetClientCount() const
+{
+	uint32_t clientCount = 0;
+	for( const MatchPtr& match : mMatches )
+	{
+		clientCount += match->GetNetworkManager()->GetClientCount();
+	}
+	return clientCount;
 }
 
-void Server::HandleNewClient( ClientProxyPtr inClientProxy )
+void Server::HandleNewClient( ClientProxy* inClientProxy )
 {
 	
 	int playerId = inClientProxy->GetPlayerId();
 	
-	ScoreBoardManager::sInstance->AddEntry( playerId, inClientProxy->GetName() );
-	SpawnCatForPlayer( playerId );
+	//players restored from a snapshot already have an entry and a cat waiting for them
+	if( !ScoreBoardManager::sInstance->GetEntry( playerId ) )
+	{
+		ScoreBoardManager::sInstance->AddEntry( playerId, inClientProxy->GetName() );
+	}
+	if( !GetCatForPlayer( playerId ) )
+	{
+		SpawnCatForPlayer( playerId );
+	}
 }
 
 void Server::SpawnCatForPlayer( int inPlayerId )
@@ -109,7 +315,7 @@ void Server::SpawnCatForPlayer( int inPlayerId )
 
 }
 
-void Server::HandleLostClient( ClientProxyPtr inClientProxy )
+void Server::HandleLostClient( ClientProxy* inClientProxy )
 {
 	//kill client's cat
 	//remove client from scoreboard
@@ -121,6 +327,8 @@ void Server::HandleLostClient( ClientProxyPtr inClientProxy )
 	{
 		cat->SetDoesWantToDie( true );
 	}
+
+	mHasLostClient = true;
 }
 
 RoboCatPtr Server::GetCatForPlayer( int inPlayerId )
@@ -132,7 +340,7 @@ RoboCatPtr Server::GetCatForPlayer( int inPlayerId )
 	const auto& gameObjects = World::sInstance->GetGameObjects();
 	for( int i = 0, c = gameObjects.size(); i < c; ++i )
 	{
-		GameObjectPtr go = gameObjects[ i ];
+		const GameObjectPtr& go = gameObjects[ i ];
 		RoboCat* cat = go->GetAsCat();
 		if( cat && cat->GetPlayerId() == inPlayerId )
 		{
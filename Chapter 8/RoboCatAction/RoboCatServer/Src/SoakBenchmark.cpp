@@ -0,0 +1,241 @@
+#include <RoboCatServerPCH.h>
+
+namespace
+{
+	//long enough for everyone to get welcomed and for the server's containers to grow to size
+	const float kWarmupTime = 5.f;
+	const float kMeasureTime = 30.f;
+
+	const float kTimeBetweenHellos = 1.f;
+	const float kTimeBetweenInputPackets = 0.033f;
+	//how long a fake player keeps doing one thing before picking something else
+	const float kTimeBetweenInputChanges = 1.f;
+	const float kShootingChance = 0.25f;
+}
+
+struct SoakBenchmark::SoakClient
+{
+	SoakClient( const string& inName ) :
+		mName( inName ),
+		mDeliveryNotificationManager( true, false ),
+		mPlayerId( 0 ),
+		mConnectionId( 0 ),
+		mTimeOfLastHello( -kTimeBetweenHellos ),
+		mTimeOfLastInputPacket( 0.f ),
+		mTimeOfLastInputChange( -kTimeBetweenInputChanges )
+	{}
+
+	string							mName;
+	UDPSocketPtr					mSocket;
+	DeliveryNotificationManager		mDeliveryNotificationManager;
+
+	//0 until the server welcomes us
+	int								mPlayerId;
+	uint32_t						mConnectionId;
+	float							mTimeOfLastHello;
+	float							mTimeOfLastInputPacket;
+	float							mTimeOfLastInputChange;
+	InputState						mInputState;
+	MoveList						mMoveList;
+};
+
+SoakBenchmark::SoakBenchmark( uint16_t inServerPort, int inClientCount ) :
+	mServerAddress( INADDR_LOOPBACK, inServerPort ),
+	mStartTime( -1.f ),
+	mIsMeasuring( false ),
+	mMeasureStartTime( 0.f ),
+	mMeasuredFrameCount( 0 )
+{
+	for( int i = 0; i < inClientCount; ++i )
+	{
+		unique_ptr< SoakClient > client( new SoakClient( StringUtils::Sprintf( "SoakCat%d", i ) ) );
+
+		client->mSocket = SocketUtil::CreateUDPSocket( INET );
+		if( client->mSocket == nullptr )
+		{
+			continue;
+		}
+		client->mSocket->Bind( SocketAddress( INADDR_ANY, 0 ) );
+		client->mSocket->SetNonBlockingMode( true );
+
+		mClients.push_back( std::move( client ) );
+	}
+
+	LOG( "Soaking the server with %d fake players", static_cast< int >( mClients.size() ) );
+}
+
+SoakBenchmark::~SoakBenchmark()
+{
+}
+
+void SoakBenchmark::Update()
+{
+	AllocationPhaseScope phaseScope( EAP_Untracked );
+
+	float time = Timing::sInstance.GetTimef();
+	if( mStartTime < 0.f )
+	{
+		mStartTime = time;
+	}
+
+	for( const unique_ptr< SoakClient >& client : mClients )
+	{
+		UpdateClient( *client, time );
+	}
+
+	if( mIsMeasuring )
+	{
+		++mMeasuredFrameCount;
+		if( time > mMeasureStartTime + kMeasureTime )
+		{
+			Engine::sInstance->SetShouldKeepRunning( false );
+		}
+	}
+	else if( time > mStartTime + kWarmupTime )
+	{
+		bool isEveryoneWelcomed = true;
+		for( const unique_ptr< SoakClient >& client : mClients )
+		{
+			isEveryoneWelcomed = isEveryoneWelcomed && client->mPlayerId != 0;
+		}
+
+		if( isEveryoneWelcomed )
+		{
+			StartMeasuring( time );
+		}
+	}
+}
+
+void SoakBenchmark::StartMeasuring( float inTime )
+{
+	mIsMeasuring = true;
+	mMeasureStartTime = inTime;
+	for( int i = 0; i < EAP_Count; ++i )
+	{
+		mPhaseAllocationsAtMeasureStart[ i ] = AllocationCounter::GetTotals( static_cast< EAllocationPhase >( i ) );
+	}
+
+	Engine::sInstance->SetIsZeroAllocationEnforced( true );
+
+	LOG( "Soak warmed up, measuring for %.0f seconds", kMeasureTime );
+}
+
+bool SoakBenchmark::Finish()
+{
+	Engine::sInstance->SetIsZeroAllocationEnforced( false );
+
+#if ROBOCAT_COUNT_ALLOCATIONS
+	if( !mIsMeasuring || mMeasuredFrameCount == 0 )
+	{
+		LOG( "Soak never got going- not every fake player was welcomed", 0 );
+		return false;
+	}
+
+	//the server loop never sleeps, so per frame averages round away to nothing- totals say more
+	LOG( "Soak ran %d frames in %.0f seconds. Heap use by phase:", mMeasuredFrameCount, kMeasureTime );
+	for( int i = 0; i < EAP_Untracked; ++i )
+	{
+		EAllocationPhase phase = static_cast< EAllocationPhase >( i );
+		AllocationCounter::Totals totals = AllocationCounter::GetTotals( phase );
+		const AllocationCounter::Totals& baseline = mPhaseAllocationsAtMeasureStart[ i ];
+
+		LOG( "  %-10s %8d allocations %10d bytes %8d frees", AllocationCounter::GetPhaseName( phase ),
+			static_cast< int >( totals.mAllocationCount - baseline.mAllocationCount ),
+			static_cast< int >( totals.mByteCount - baseline.mByteCount ),
+			static_cast< int >( totals.mFreeCount - baseline.mFreeCount ) );
+	}
+
+	uint32_t failureCount = Engine::sInstance->GetZeroAllocationFailureCount();
+	LOG( "Soak %s: %d of %d frames allocated", failureCount == 0 ? "passed" : "FAILED", failureCount, mMeasuredFrameCount );
+	return failureCount == 0;
+#else
+	LOG( "Soak can't check anything with ROBOCAT_COUNT_ALLOCATIONS off", 0 );
+	return false;
+#endif
+}
+
+void SoakBenchmark::UpdateClient( SoakClient& ioClient, float inTime )
+{
+	ReadIncomingPackets( ioClient );
+
+	if( ioClient.mPlayerId == 0 )
+	{
+		if( inTime > ioClient.mTimeOfLastHello + kTimeBetweenHellos )
+		{
+			SendHelloPacket( ioClient );
+			ioClient.mTimeOfLastHello = inTime;
+		}
+		//so the first move doesn't claim to cover the whole time we were waiting
+		ioClient.mTimeOfLastInputPacket = inTime;
+		return;
+	}
+
+	//wander about, and now and then fire away
+	if( inTime > ioClient.mTimeOfLastInputChange + kTimeBetweenInputChanges )
+	{
+		float horizontalDelta = static_cast< float >( rand() % 3 - 1 );
+		float verticalDelta = static_cast< float >( rand() % 3 - 1 );
+		ioClient.mInputState = InputState( horizontalDelta, verticalDelta, RoboMath::GetRandomFloat() < kShootingChance );
+		ioClient.mTimeOfLastInputChange = inTime;
+	}
+
+	if( inTime > ioClient.mTimeOfLastInputPacket + kTimeBetweenInputPackets )
+	{
+		SendInputPacket( ioClient, inTime );
+	}
+}
+
+void SoakBenchmark::ReadIncomingPackets( SoakClient& ioClient )
+{
+	char packetMem[ 1500 ];
+	SocketAddress fromAddress;
+
+	int readByteCount;
+	while( ( readByteCount = ioClient.mSocket->ReceiveFrom( packetMem, sizeof( packetMem ), fromAddress ) ) > 0 )
+	{
+		InputMemoryBitStream inputStream( packetMem, readByteCount * 8 );
+		uint32_t packetType = 0;
+		inputStream.Read( packetType, NetworkManager::kPacketTypeBitCount );
+
+		if( packetType == NetworkManager::kWelcomePacket )
+		{
+			inputStream.Read( ioClient.mPlayerId );
+			inputStream.Read( ioClient.mConnectionId, NetworkManager::kConnectionIdBitCount );
+		}
+		else if( packetType == NetworkManager::kStatePacket )
+		{
+			//all that matters is acking it- the server's behavior depends on what gets through, not what's in it
+			ioClient.mDeliveryNotificationManager.ReadAndProcessState( inputStream );
+		}
+	}
+}
+
+void SoakBenchmark::SendHelloPacket( SoakClient& ioClient )
+{
+	OutputMemoryBitStream helloPacket;
+
+	helloPacket.Write( NetworkManager::kHelloPacket, NetworkManager::kPacketTypeBitCount );
+	helloPacket.Write( ioClient.mName );
+
+	ioClient.mSocket->SendTo( helloPacket.GetBufferPtr(), helloPacket.GetByteLength(), mServerAddress );
+}
+
+void SoakBenchmark::SendInputPacket( SoakClient& ioClient, float inTime )
+{
+	OutputMemoryBitStream inputPacket;
+
+	inputPacket.Write( NetworkManager::kInputPacket, NetworkManager::kPacketTypeBitCount );
+	inputPacket.Write( ioClient.mConnectionId, NetworkManager::kConnectionIdBitCount );
+
+	ioClient.mDeliveryNotificationManager.WriteState( inputPacket );
+	//never asks the time
+	inputPacket.Write( false );
+
+	//one move per packet, covering the time since the last one
+	const Move& move = ioClient.mMoveList.AddMove( ioClient.mInputState, inTime );
+	ioClient.mMoveList.Write( inputPacket, move.GetTick() );
+	ioClient.mMoveList.Clear();
+
+	ioClient.mSocket->SendTo( inputPacket.GetBufferPtr(), inputPacket.GetByteLength(), mServerAddress );
+	ioClient.mTimeOfLastInputPacket = inTime;
+}
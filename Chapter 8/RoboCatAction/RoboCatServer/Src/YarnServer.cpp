@@ -1,32 +1,71 @@
 #include <RoboCatServerPCH.h>
 
+namespace
+{
+	//how much further back than an honest client's view we'll look, for jitter and the round trip estimate lagging behind
+	const float kMaxViewTimeSlack = 0.1f;
+}
 
-YarnServer::YarnServer()
+YarnServer::YarnServer() :
+	mSpawnTime( Timing::sInstance.GetFrameStartTime() )
 {
 	//yarn lives a second...
-	mTimeToDie = Timing::sInstance.GetFrameStartTime() + 1.f;
+	GameObjectHandle handle = GetHandle();
+	mDeathTimer = TimerWheel::sInstance->Schedule( 1.f, [ handle ]()
+	{
+		if( GameObject* yarn = handle.Get() )
+		{
+			yarn->SetDoesWantToDie( true );
+		}
+	} );
 }
 
 void YarnServer::HandleDying()
 {
+	//hit something first, so it won't be needing this
+	TimerWheel::sInstance->Cancel( mDeathTimer );
+
 	NetworkManagerServer::sInstance->UnregisterGameObject( this );
 }
 
-
 void YarnServer::Update()
 {
 	Yarn::Update();
 
-	if( Timing::sInstance.GetFrameStartTime() > mTimeToDie )
+	//the shooter's screen has the cats an interpolation delay behind their server clock, and their yarn's been flying as long as ours.
+	//so the cats they saw this yarn reach are from that long after they fired, less the delay
+	float time = Timing::sInstance.GetFrameStartTime();
+	float viewTime = time;
+	ClientProxy* shooter = NetworkManagerServer::sInstance->GetClientProxy( GetPlayerId() );
+	if( shooter && shooter->HasClientClockOffset() )
 	{
-		SetDoesWantToDie( true );
+		float shotTime = Move::TickToTime( GetShotTick() ) + shooter->GetClientClockOffset();
+		viewTime = std::min( shotTime + ( time - mSpawnTime ) - NetworkManager::kInterpolationDelay, time );
+
+		//the shot tick and clock offset both come from the client, so don't let them claim a view further back than their lag explains-
+		//otherwise an old tick would let them hit cats where they were long ago
+		float earliestViewTime = time - ( shooter->GetDeliveryNotificationManager().GetRoundTripTime() + NetworkManager::kInterpolationDelay + kMaxViewTimeSlack );
+		viewTime = std::max( viewTime, earliestViewTime );
+	}
+	else if( shooter )
+	{
+		//no clock to go on yet, so guess the trip's as long each way
+		viewTime -= shooter->GetDeliveryNotificationManager().GetRoundTripTime() + NetworkManager::kInterpolationDelay;
 	}
 
+	RoboCat* cat = PoseHistory::sInstance->FindCatAt( viewTime, GetLocation(), GetCollisionRadius(), GetPlayerId() );
+	if( cat )
+	{
+		SetDoesWantToDie( true );
+
+		static_cast< RoboCatServer* >( cat )->TakeDamage( GetPlayerId() );
+	}
 }
 
-bool YarnServer::HandleCollisionWithCat( RoboCat* inCat )
+void YarnServer::HandleCollisionWithCat( RoboCat* inCat )
 {
-	if( inCat->GetPlayerId() != GetPlayerId() )
+	//cats in the pose history get hit in Update instead, where the shooter saw them
+	if( inCat->GetPlayerId() != GetPlayerId() && !static_cast< RoboCatServer* >( inCat )->IsLagCompensated() )
 	{
 		//kill yourself!
 		SetDoesWantToDie( true );
@@ -34,8 +73,6 @@ bool YarnServer::HandleCollisionWithCat( RoboCat* inCat )
 		static_cast< RoboCatServer* >( inCat )->TakeDamage( GetPlayerId() );
 
 	}
-
-	return false;
 }
 
 